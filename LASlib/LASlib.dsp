@@ -105,6 +105,10 @@ SOURCE=..\LASzip\src\arithmeticmodel.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\bytestream_shm.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\fopen_compressed.cpp
 # End Source File
 # Begin Source File
@@ -113,6 +117,10 @@ SOURCE=..\LASzip\src\integercompressor.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\laschunkcopier.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\lasfilter.cpp
 # End Source File
 # Begin Source File
@@ -213,6 +221,10 @@ SOURCE=..\LASzip\src\lasreadpoint.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\lastranscoder.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\lastransform.cpp
 # End Source File
 # Begin Source File
@@ -221,6 +233,10 @@ SOURCE=.\src\lasutility.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\lasverifier.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\laswaveform13reader.cpp
 # End Source File
 # Begin Source File
@@ -273,6 +289,10 @@ SOURCE=.\src\laswriter_wrl.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\laswriterasync.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\laswritercompatible.cpp
 # End Source File
 # Begin Source File
@@ -325,6 +345,10 @@ SOURCE=..\LASzip\src\bytestreamout_array.hpp
 # End Source File
 # Begin Source File
 
+SOURCE=..\LASzip\src\bytestreamout_checksum.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=..\LASzip\src\bytestreamout_file.hpp
 # End Source File
 # Begin Source File
@@ -345,6 +369,14 @@ SOURCE=..\LASzip\src\lasattributer.hpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\inc\bytestream_shm.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\inc\laschunkcopier.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\inc\lasdefinitions.hpp
 # End Source File
 # Begin Source File
@@ -465,6 +497,10 @@ SOURCE=..\LASzip\src\lasreadpoint.hpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\inc\lastranscoder.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\inc\lastransform.hpp
 # End Source File
 # Begin Source File
@@ -473,6 +509,10 @@ SOURCE=.\inc\lasutility.hpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\inc\lasverifier.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\inc\lasvlr.hpp
 # End Source File
 # Begin Source File
@@ -541,6 +581,10 @@ SOURCE=.\inc\laswriter_wrl.hpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\inc\laswriterasync.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\inc\laswritercompatible.hpp
 # End Source File
 # Begin Source File
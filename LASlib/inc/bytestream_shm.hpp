@@ -0,0 +1,125 @@
+/*
+===============================================================================
+
+  FILE:  bytestream_shm.hpp
+
+  CONTENTS:
+
+    Streams the bytes of a LAS or LAZ file from one process to another process
+    on the same host through a ring buffer in named shared memory. This avoids
+    the small buffers and the system calls of a pipe. The writing process
+    creates the ring, the reading process attaches to it by name. Neither
+    stream is seekable, so they behave like standard out and standard in.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- either side notices when the other process died
+    19 October 2026 -- created to pipe points between processes without pipes
+
+===============================================================================
+*/
+#ifndef BYTE_STREAM_SHM_HPP
+#define BYTE_STREAM_SHM_HPP
+
+#include "lasdefinitions.hpp"
+
+#include "bytestreamin.hpp"
+#include "bytestreamout.hpp"
+
+#define LAS_TOOLS_SHM_BUFFER_SIZE 33554432
+
+class LASshmRing;
+
+class LASLIB_DLL ByteStreamOutSHM : public ByteStreamOut
+{
+public:
+  ByteStreamOutSHM();
+/* create the shared memory ring with this name              */
+  BOOL open(const CHAR* name, U32 buffer_size=LAS_TOOLS_SHM_BUFFER_SIZE);
+/* write a single byte                                       */
+  BOOL putByte(U8 byte);
+/* write an array of bytes                                   */
+  BOOL putBytes(const U8* bytes, U32 num_bytes);
+/* write 16 bit low-endian field                             */
+  BOOL put16bitsLE(const U8* bytes);
+/* write 32 bit low-endian field                             */
+  BOOL put32bitsLE(const U8* bytes);
+/* write 64 bit low-endian field                             */
+  BOOL put64bitsLE(const U8* bytes);
+/* write 16 bit big-endian field                             */
+  BOOL put16bitsBE(const U8* bytes);
+/* write 32 bit big-endian field                             */
+  BOOL put32bitsBE(const U8* bytes);
+/* write 64 bit big-endian field                             */
+  BOOL put64bitsBE(const U8* bytes);
+/* the shared memory ring is not seekable                    */
+  BOOL isSeekable() const { return FALSE; };
+/* get current position of stream                            */
+  I64 tell() const;
+/* seek to this position in the stream                       */
+  BOOL seek(const I64 position) { return FALSE; };
+/* seek to the end of the file                               */
+  BOOL seekEnd() { return FALSE; };
+/* waits for the reader to consume everything and removes the ring */
+  ~ByteStreamOutSHM();
+private:
+  LASshmRing* ring;
+  U64 count;
+  U64 free_until;
+};
+
+class LASLIB_DLL ByteStreamInSHM : public ByteStreamIn
+{
+public:
+  ByteStreamInSHM();
+/* attach to the shared memory ring with this name           */
+  BOOL open(const CHAR* name, U32 timeout_seconds=60);
+/* read a single byte                                        */
+  U32 getByte();
+/* read an array of bytes                                    */
+  void getBytes(U8* bytes, const I64 num_bytes);
+/* read 16 bit low-endian field                              */
+  void get16bitsLE(U8* bytes);
+/* read 32 bit low-endian field                              */
+  void get32bitsLE(U8* bytes);
+/* read 64 bit low-endian field                              */
+  void get64bitsLE(U8* bytes);
+/* read 16 bit big-endian field                              */
+  void get16bitsBE(U8* bytes);
+/* read 32 bit big-endian field                              */
+  void get32bitsBE(U8* bytes);
+/* read 64 bit big-endian field                              */
+  void get64bitsBE(U8* bytes);
+/* the shared memory ring is not seekable                    */
+  BOOL isSeekable() const { return FALSE; };
+/* get current position of stream                            */
+  I64 tell() const;
+/* only seeks forward by skipping bytes                      */
+  BOOL seek(const I64 position);
+/* seek to the end of the file                               */
+  BOOL seekEnd(const I64 distance=0) { return FALSE; };
+/* tells the writer that no more bytes will be read          */
+  ~ByteStreamInSHM();
+private:
+  LASshmRing* ring;
+  U64 count;
+  U64 available_until;
+  U8 swapped[8];
+};
+
+#endif
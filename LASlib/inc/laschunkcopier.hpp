@@ -0,0 +1,65 @@
+/*
+===============================================================================
+
+  FILE:  laschunkcopier.hpp
+
+  CONTENTS:
+
+    Merges LAZ files by copying their compressed chunks byte by byte into one
+    LAZ file without decoding and encoding the points again. This is possible
+    when all files have the point type, the LASzip items, the scale factors,
+    and the offsets of the merged header. Only the header and the chunk table
+    of the output are new.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- created to merge LAZ tiles into deliveries at I/O speed
+
+===============================================================================
+*/
+#ifndef LAS_CHUNK_COPIER_HPP
+#define LAS_CHUNK_COPIER_HPP
+
+#include "lasreader.hpp"
+#include "laswriter.hpp"
+
+class LASreaderLAS;
+
+class LASLIB_DLL LASchunkcopier
+{
+public:
+  // copies the chunks of all LAZ files of 'lasreadopener' into the file of
+  // 'laswriteopener' that gets 'header' (e.g. of the merged reader). returns
+  // FALSE before writing any points when the files are not compatible with
+  // 'header' or with each other. fixed-sized chunks are kept if they stay
+  // full, otherwise point types 6 and higher switch to variable chunks.
+  BOOL copy(LASreadOpener* lasreadopener, LASheader* header, const LASwriteOpener* laswriteopener);
+
+  inline U32 get_number_files() const { return number_files; };
+  inline I64 get_npoints() const { return npoints; };
+
+  LASchunkcopier();
+  ~LASchunkcopier();
+
+private:
+  LASreaderLAS* open_reader(LASreadOpener* lasreadopener, U32 number) const;
+  U32 number_files;
+  I64 npoints;
+};
+
+#endif
@@ -25,6 +25,15 @@
 
     CHANGE HISTORY:
 
+        19 October 2026 -- added '-decode_threads' to decompress the chunks of LAZ files in parallel
+        19 October 2026 -- added '-seek_cache' to replay decoded LAZ points when seeking back
+        19 October 2026 -- added '-istream_shm' to read a LAS/LAZ stream through shared memory
+        19 October 2026 -- added '-stored_raw' to store uncompressed points for '-stored'
+        19 October 2026 -- added '-buffered_cache' to reuse neighbor points across tiles
+        19 October 2026 -- added '-buffered_threads' to load the buffer from the neighbors in parallel
+        19 October 2026 -- added '-merged_prefetch' to read ahead of the next '-merged' files
+        19 October 2026 -- added '-merged_catalog' and '-merged_threads' for faster '-merged' opening
+        19 October 2026 -- added '-iraster_decimate' for block-aggregated BIL/DTM overviews
         18 April 2023 -- adding support of COPC spatial index standard
         10 March 2022 -- added '-iptx_transform' option
         31 October 2019 -- adding kdtree of bounding boxes for large number of LAS/LAZ files
@@ -141,6 +150,18 @@ class LASLIB_DLL LASreader {
   inline F64 get_r_max_y() const {
     return r_max_y;
   };
+  inline F64 get_orig_min_x() const {
+    return (inside ? orig_min_x : header.min_x);
+  };
+  inline F64 get_orig_min_y() const {
+    return (inside ? orig_min_y : header.min_y);
+  };
+  inline F64 get_orig_max_x() const {
+    return (inside ? orig_max_x : header.max_x);
+  };
+  inline F64 get_orig_max_y() const {
+    return (inside ? orig_max_y : header.max_y);
+  };
   virtual BOOL inside_copc_depth(const U8 mode, const I32 depth, const F32 resolution);
   inline I32 get_copc_depth() const {
     return copc_depth;
@@ -307,6 +328,18 @@ class LASLIB_DLL LASreadOpener {
   BOOL is_merged() const {
     return merged;
   };
+  void set_merged_catalog(const CHAR* merged_catalog);
+  inline const CHAR* get_merged_catalog() const {
+    return merged_catalog;
+  };
+  void set_merged_threads(const U32 merged_threads);
+  inline U32 get_merged_threads() const {
+    return merged_threads;
+  };
+  void set_merged_prefetch(const U32 merged_prefetch);
+  inline U32 get_merged_prefetch() const {
+    return merged_prefetch;
+  };
   void set_subdir(const BOOL subdir);
   inline BOOL is_subdir() const {
     return subdir;
@@ -315,8 +348,28 @@ class LASLIB_DLL LASreadOpener {
   BOOL is_stored() const {
     return stored;
   };
+  void set_stored_raw(const U32 stored_raw);
+  inline U32 get_stored_raw() const {
+    return stored_raw;
+  };
   void set_buffer_size(const F32 buffer_size);
   F32 get_buffer_size() const;
+  void set_buffered_threads(const U32 buffered_threads);
+  inline U32 get_buffered_threads() const {
+    return buffered_threads;
+  };
+  void set_decode_threads(const U32 decode_threads);
+  inline U32 get_decode_threads() const {
+    return decode_threads;
+  };
+  void set_seek_cache(const U32 seek_cache);
+  inline U32 get_seek_cache() const {
+    return seek_cache;
+  };
+  void set_buffered_cache(const U32 buffered_cache);
+  inline U32 get_buffered_cache() const {
+    return buffered_cache;
+  };
   BOOL add_neighbor_file_name(const CHAR* neighbor_file_name, BOOL unique = FALSE);
   BOOL add_neighbor_file_name(const CHAR* file_name, I64 npoints, F64 min_x, F64 min_y, F64 max_x, F64 max_y, BOOL unique = FALSE);
   BOOL add_neighbor_list_of_files(const CHAR* list_of_files, BOOL unique = FALSE);
@@ -364,6 +417,10 @@ class LASLIB_DLL LASreadOpener {
   BOOL set_point_type(U8 point_type);
   void set_parse_string(const CHAR* parse_string);
   void set_skip_lines(const U32 number_of_lines);
+  void set_raster_decimate(const U32 decimate);
+  inline U32 get_raster_decimate() const {
+    return raster_decimate;
+  };
   void set_populate_header(BOOL populate_header);
   void set_keep_lastiling(BOOL keep_lastiling);
   void set_keep_copc(BOOL keep_copc);
@@ -436,6 +493,10 @@ class LASLIB_DLL LASreadOpener {
   BOOL get_use_stdin() {
     return use_stdin;
   };
+  void set_shm_name(const CHAR* shm_name);
+  inline const CHAR* get_shm_name() const {
+    return shm_name;
+  };
   BOOL is_validation() {
     return this->is_validate;
   };
@@ -455,8 +516,12 @@ class LASLIB_DLL LASreadOpener {
   U32 io_ibuffer_size;
   const CHAR* file_name;
   BOOL merged;
+  CHAR* merged_catalog;
+  U32 merged_threads;
+  U32 merged_prefetch;
   BOOL subdir;
   BOOL stored;
+  U32 stored_raw;
   U32 file_name_current;
   CHAR** file_names;
   U32 file_name_number;
@@ -469,6 +534,10 @@ class LASLIB_DLL LASreadOpener {
   F64* file_names_max_y;
   LASkdtreeRectangles* kdtree_rectangles;
   F32 buffer_size;
+  U32 buffered_threads;
+  U32 decode_threads;
+  U32 seek_cache;
+  U32 buffered_cache;
   std::string temp_file_base;
   CHAR** neighbor_file_names;
   U32 neighbor_file_name_number;
@@ -507,11 +576,13 @@ class LASLIB_DLL LASreadOpener {
   U8 point_type;
   CHAR* parse_string;
   U32 skip_lines;
+  U32 raster_decimate;
   BOOL populate_header;
   BOOL keep_lastiling;
   BOOL keep_copc;
   BOOL pipe_on;
   BOOL use_stdin;
+  CHAR* shm_name;
   BOOL unique;
   BOOL is_validate;
   std::string formula_expr;
@@ -24,6 +24,8 @@
 
   CHANGE HISTORY:
 
+    19 October 2026 -- no full raster scan in open(), z range from the *.stx file
+    19 October 2026 -- windowed row reads for '-inside' queries and '-iraster_decimate'
     31 August 2019 -- add RasterLAZ during code sprint after FOSS4G 2019 in Bucharest 
     10 May 2019 -- checking for overflows in X, Y, Z 32 bit integers of fixed-point LAS
      7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
@@ -45,10 +47,16 @@ public:
 
   void set_scale_factor(const F64* scale_factor);
   void set_offset(const F64* offset);
+  void set_decimate(const I32 decimate);
   virtual BOOL open(const CHAR* file_name);
 
   I32 get_format() const { return LAS_TOOLS_FORMAT_BIL; };
 
+  BOOL inside_none();
+  BOOL inside_tile(const F32 ll_x, const F32 ll_y, const F32 size);
+  BOOL inside_circle(const F64 center_x, const F64 center_y, const F64 radius);
+  BOOL inside_rectangle(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y);
+
   BOOL seek(const I64 p_index);
 
   ByteStreamIn* get_stream() const;
@@ -76,10 +84,27 @@ private:
   I64 overflow_I32_z;
   F64 orig_x_offset, orig_y_offset, orig_z_offset;
   F64 orig_x_scale_factor, orig_y_scale_factor, orig_z_scale_factor;
+  // window of raster cells that is read (the full raster unless there is an AOI query)
+  I32 win_col_min, win_col_max, win_row_min, win_row_max;
+  // point count (upper bound) and z range of the full raster as known after open()
+  I64 raster_npoints;
+  F64 raster_min_z, raster_max_z;
+  // points are aggregated from blocks of decimate x decimate cells
+  I32 decimate;
+  I32 pixel_bytes;
+  I32 buffer_row;
+  I64 file_offset;
+  U8* pixels;
+  F32* elevations;
 
   void clean();
+  void set_window(F64 min_x, F64 min_y, F64 max_x, F64 max_y);
+  void count_window();
+  BOOL read_rows(const I32 first_row);
+  BOOL read_cell(F64* x, F64* y, F32* elevation);
   BOOL read_hdr_file(const CHAR* file_name);
   BOOL read_blw_file(const CHAR* file_name);
+  BOOL read_stx_file(const CHAR* file_name);
   void populate_scale_and_offset();
   void populate_bounding_box();
 };
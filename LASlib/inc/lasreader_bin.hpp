@@ -26,6 +26,7 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- read fixed-size records in blocks instead of field by field
     4 September 2011 -- created on Labor Day Sunday far from beloved mountains
   
 ===============================================================================
@@ -62,6 +63,13 @@ private:
   FILE* file;
   ByteStreamIn* stream;
   I32 version;
+  U32 record_size;
+  U8* block;
+  U32 block_records;
+  U32 block_size;
+  U32 block_count;
+  U32 block_index;
+  BOOL read_block();
 };
 
 class LASLIB_DLL LASreaderBINrescale : public virtual LASreaderBIN
@@ -24,6 +24,8 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- decodes the chunks of LAZ files with several threads
+    19 October 2026 -- header values from the trailer EVLR of streamed output
     9 November 2022 -- support of COPC VLR and EVLR
     13 June 2022 -- support unicode filenames
     10 July 2018 -- user must set seek-ability of istream (hard to determine) 
@@ -62,6 +64,10 @@ class LASLIB_DLL LASreaderLAS : public LASreader
 public:
   void set_delete_stream(BOOL delete_stream=TRUE) { this->delete_stream = delete_stream; };
   void set_keep_copc(BOOL keep_copc) { this->keep_copc = keep_copc; };
+  void set_decode_threads(U32 decode_threads) { this->decode_threads = decode_threads; };
+  void set_seek_cache(U32 seek_cache) { this->seek_cache = seek_cache; };
+  // off when the stream is not the entire file (e.g. only its header bytes)
+  void set_probe_stream_trailer(BOOL probe_stream_trailer) { this->probe_stream_trailer = probe_stream_trailer; };
 
   BOOL open(const char* file_name, I32 io_buffer_size=LAS_TOOLS_IO_IBUFFER_SIZE, BOOL peek_only=FALSE, U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL);
   BOOL open(FILE* file, BOOL peek_only=FALSE, U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL);
@@ -82,6 +88,7 @@ protected:
   virtual BOOL read_point_default();
 
 private:
+  BOOL read_stream_trailer();
   FILE* file;
   CHAR* file_name;
   ByteStreamIn* stream;
@@ -89,6 +96,9 @@ private:
   LASreadPoint* reader;
   BOOL checked_end;
   BOOL keep_copc;
+  U32 decode_threads;
+  U32 seek_cache;
+  BOOL probe_stream_trailer;
 };
 
 class LASLIB_DLL LASreaderLASrescale : public virtual LASreaderLAS
@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- bulk reading of little endian binary vertices in large blocks
     9 May 2020 -- added silly 'obj_info' used by Cloud Compare
     4 September 2018 -- created after returning to Samara with locks changed
   
@@ -92,6 +93,14 @@ private:
   BOOL parse(const CHAR* parse_string);
   F64 read_binary_value(CHAR type);
   BOOL read_binary_point();
+  // bulk reading of little endian binary vertices
+  U32 binary_record_size;
+  U32 binary_offsets[64];
+  U8* binary_buffer;
+  U32 binary_buffer_records;
+  U32 binary_buffer_count;
+  U32 binary_buffer_index;
+  BOOL read_binary_block();
   void populate_scale_and_offset();
   void populate_bounding_box();
   void clean();
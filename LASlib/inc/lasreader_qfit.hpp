@@ -26,6 +26,7 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- read and endian-swap records in blocks instead of one by one
      9 August 2016 -- fixed bug for QFIT version 40 or 56 (without pulse width)
     22 December 2011 -- created after my banker keeps me hostage for 2.5 hours
   
@@ -67,6 +68,11 @@ private:
   BOOL endian_swap;
   I32 offset;
   I32 buffer[14] = {0};
+  I32* block;
+  U32 block_records;
+  U32 block_size;
+  U32 block_count;
+  U32 block_index;
   BOOL populated_header;
   I32 scan_azimuth_start;
   I32 pitch_start;
@@ -74,6 +80,7 @@ private:
   I32 pulse_width_start;
   F64 orig_x_offset, orig_y_offset, orig_z_offset;
   F64 orig_x_scale_factor, orig_y_scale_factor, orig_z_scale_factor;
+  BOOL read_block();
 };
 
 class LASLIB_DLL LASreaderQFITrescale : public virtual LASreaderQFIT
@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- bulk record reads, '.shx' offset table, and skipping of records outside '-inside'
     16 December 2011 -- after Silke got Australia mad and didn't call anymore
   
 ===============================================================================
@@ -45,6 +46,11 @@ public:
 
   I32 get_format() const { return LAS_TOOLS_FORMAT_SHP; };
 
+  BOOL inside_none();
+  BOOL inside_tile(const F32 ll_x, const F32 ll_y, const F32 size);
+  BOOL inside_circle(const F64 center_x, const F64 center_y, const F64 radius);
+  BOOL inside_rectangle(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y);
+
   BOOL seek(const I64 p_index);
 
   ByteStreamIn* get_stream() const;
@@ -69,6 +75,18 @@ private:
   F64 orig_x_offset, orig_y_offset, orig_z_offset;
   F64 orig_x_scale_factor, orig_y_scale_factor, orig_z_scale_factor;
   bool piped;
+  U32* shx_records;
+  I32 number_of_records;
+  I32 record_idx;
+  I64 record_position;
+  U8* record_buffer;
+  I32 record_buffer_allocated;
+  BOOL record_filter;
+  F64 record_min_x, record_min_y, record_max_x, record_max_y;
+  BOOL read_shx(const char* file_name);
+  BOOL read_record();
+  void decode_xy(const U8* xy, I32 count, I32* dest, I32 stride);
+  void decode_z(const U8* z, I32 count, I32* dest, I32 stride);
   void populate_scale_and_offset();
   void populate_bounding_box();
   void clean();
@@ -30,6 +30,8 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- optional LRU cache of neighbor areas shared by consecutive tiles
+    19 October 2026 -- read neighbors in parallel and recycle buffer memory across tiles
      2 May 2023 -- adding support of COPC spatial index standard
     17 July 2012 -- created after converting the LASzip paper from LaTeX to Word
   
@@ -57,6 +59,8 @@ public:
   BOOL set_file_name(const CHAR* file_name);
   BOOL add_neighbor_file_name(const CHAR* file_name);
   void set_buffer_size(const F32 buffer_size);
+  void set_neighbor_threads(const U32 neighbor_threads);
+  void set_neighbor_cache(const U32 megabytes);
 
   BOOL remove_buffer();
 
@@ -88,7 +92,10 @@ private:
   void clean();
 
   void clean_buffer();
+  BOOL load_neighbors();
+  U8* add_buffer();
   BOOL copy_point_to_buffer();
+  BOOL copy_points_to_buffer(const U8* points, U32 number);
   BOOL copy_point_from_buffer();
   U32 get_number_buffered_points() const;
 
@@ -104,6 +111,8 @@ private:
   LASreadOpener lasreadopener_neighbors;
   LASreader* lasreader;
   F32 buffer_size;
+  U32 neighbor_threads;
+  BOOL neighbor_cache;
   BOOL point_type_change;
   BOOL point_size_change;
   BOOL rescale;
@@ -24,6 +24,8 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- optional background prefetching of the next files to be read
+    19 October 2026 -- scan LAS/LAZ headers with several threads and cache them in a catalog
      2 May 2023 -- adding support of COPC spatial index standard
      4 November 2019 -- add ID to files for subsets of merged '-faf' files
      5 September 2018 -- support for reading points from the PLY format
@@ -46,6 +48,16 @@
 #include "lasreader_qfit.hpp"
 #include "lasreader_txt.hpp"
 #include <unordered_set>
+#include <vector>
+
+struct LASmergedCatalogEntry
+{
+  I64 file_size;
+  I64 file_time;
+  std::vector<U8> bytes;
+};
+
+class LASmergedPrefetcher;
 
 class LASLIB_DLL LASreaderMerged : public LASreader
 {
@@ -68,6 +80,9 @@ public:
   void set_populate_header(BOOL populate_header);
   void set_keep_lastiling(BOOL keep_lastiling);
   void set_copc_stream_order(U8 order);
+  void set_catalog_file_name(const CHAR* catalog_file_name);
+  void set_header_scan_threads(U32 header_scan_threads);
+  void set_prefetch_depth(U32 prefetch_depth);
   BOOL open();
   BOOL reopen();
 
@@ -94,6 +109,10 @@ protected:
 
 private:
   BOOL open_next_file();
+  BOOL scan_headers();
+  BOOL peek_header_block(U32 i);
+  BOOL file_is_inside(U32 i) const;
+  void prefetch_ahead();
   void clean();
 
   LASreader* lasreader;
@@ -131,6 +150,12 @@ private:
   CHAR** file_names;
   U32* file_names_ID;
   F64* bounding_boxes;
+  CHAR* catalog_file_name;
+  U32 header_scan_threads;
+  std::vector<LASmergedCatalogEntry> header_blocks;
+  U32 prefetch_depth;
+  U32 prefetch_next;
+  LASmergedPrefetcher* prefetcher;
   std::unordered_set<size_t> filtered_file_number;
 };
 
@@ -25,6 +25,7 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- write the piped points in a separate thread
      2 May 2023 -- adding support of COPC spatial index standard
     21 August 2012 -- created after swimming in the Main river 3 days in a row
   
@@ -27,6 +27,7 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- '-stored_raw' keeps uncompressed points in memory up to a budget
      9 December 2017 -- created at Octopus Resort on Waya Island in Fiji
   
 ===============================================================================
@@ -70,10 +71,25 @@ protected:
   BOOL read_point_default();
 
 private:
+  BOOL open_writer();
+  BOOL store_point();
+  BOOL compress_arena();
+  void clean_arena();
+
   LASreader* lasreader;
   LASwriter* laswriter;
   ByteStreamInArray* streaminarray;
   ByteStreamOutArray* streamoutarray;
+
+  // uncompressed storage of the points in blocks
+  BOOL arena;
+  I32 format;
+  I64 arena_budget;
+  U8** arena_blocks;
+  U32 arena_block_number;
+  U32 arena_block_allocated;
+  I64 arena_count;
+  I64 arena_index;
 };
 
 #endif
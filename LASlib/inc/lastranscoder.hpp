@@ -0,0 +1,66 @@
+/*
+===============================================================================
+
+  FILE:  lastranscoder.hpp
+
+  CONTENTS:
+
+    Converts a LAZ file chunk by chunk into the layered compression of the
+    "native LAS 1.4 extension" of LASzip that allows selective decompression.
+    Point types 0 to 5 become point types 6 to 10. The points are converted
+    exactly like 'las2las -set_point_type' does, i.e. each point is decoded,
+    assigned to a point of the new type, and encoded again. What is new is
+    that this is done per chunk so that several threads can work on different
+    chunks at the same time and the chunk boundaries of the input are kept.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- remove the incomplete output when transcoding fails
+    19 October 2026 -- created to migrate LAZ archives to selective decompression
+
+===============================================================================
+*/
+#ifndef LAS_TRANSCODER_HPP
+#define LAS_TRANSCODER_HPP
+
+#include "lasreader.hpp"
+#include "laswriter.hpp"
+
+class LASLIB_DLL LAStranscoder
+{
+public:
+  // transcodes the points of a LAZ file that 'lasreader' has opened but not yet
+  // read from into the file of 'laswriteopener'. the header of 'lasreader' is
+  // changed to describe the new points while writing them and afterwards
+  // describes the input again. returns FALSE and removes the incomplete
+  // output file when a chunk cannot be transcoded.
+  BOOL transcode(LASreader* lasreader, const LASwriteOpener* laswriteopener, U32 threads=1);
+
+  inline U32 get_number_chunks() const { return number_chunks; };
+  inline I64 get_npoints() const { return npoints; };
+
+  LAStranscoder();
+  ~LAStranscoder();
+
+private:
+  BOOL upgrade_header(LASheader* header) const;
+  U32 number_chunks;
+  I64 npoints;
+};
+
+#endif
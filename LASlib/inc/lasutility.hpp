@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- LASinventory can add a block of point records and merge partial inventories
     27 August 2017 -- added '-histo scanner_channel 1'
      1 June 2017 -- improved "fluff" detection
      3 May 2015 -- updated LASinventory to handle LAS 1.4 content 
@@ -52,6 +53,8 @@ public:
   F64 min_gps_time;
   BOOL init(const LASheader* header);
   BOOL add(const LASpoint* point);
+  BOOL add(const U8* points, U32 number, U32 point_size, U8 point_data_format);
+  BOOL merge(const LASinventory* inventory);
   BOOL update_header(LASheader* header) const;
   LASinventory();
 private:
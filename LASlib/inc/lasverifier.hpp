@@ -0,0 +1,67 @@
+/*
+===============================================================================
+
+  FILE:  lasverifier.hpp
+
+  CONTENTS:
+
+    Verifies the chunks of a LAZ file without reading it point by point. The
+    compressed bytes of each chunk are compared with the CRC-32 checksums that
+    were stored with them ('-chunk_checksums') and/or are decompressed. Several
+    threads can verify different chunks at the same time.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- created to validate transfers of large LAZ archives
+
+===============================================================================
+*/
+#ifndef LAS_VERIFIER_HPP
+#define LAS_VERIFIER_HPP
+
+#include "lasreader.hpp"
+
+class LASLIB_DLL LASverifier
+{
+public:
+  // verifies the chunks of a LAZ file that 'lasreader' has opened but not yet
+  // read from. with 'use_checksums' their compressed bytes must match the CRC-32
+  // stored in the file and with 'decode' they must decode. chunks of files
+  // without checksums are always decoded.
+  BOOL verify(LASreader* lasreader, BOOL use_checksums, BOOL decode, U32 threads=1);
+
+  inline BOOL has_checksums() const { return (checksums != 0); };
+  inline BOOL was_decoded() const { return decoded; };
+  inline U32 get_number_chunks() const { return number_chunks; };
+  inline U32 get_number_failed() const { return number_failed; };
+  inline U32 get_first_failed() const { return first_failed; };
+
+  LASverifier();
+  ~LASverifier();
+
+private:
+  BOOL read_checksums(ByteStreamIn* stream);
+  U32 number_checksums;
+  U32* checksums;
+  U32 number_chunks;
+  U32 number_failed;
+  U32 first_failed;
+  BOOL decoded;
+};
+
+#endif
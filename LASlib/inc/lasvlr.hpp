@@ -25,6 +25,8 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- EVLR with the CRC-32 checksums of the LAZ chunks
+    19 October 2026 -- trailer EVLR with the final header values of streamed output
     28 November 2019 -- created after Tobago paddle week in flight POS -> PTY
   
 ===============================================================================
@@ -74,5 +76,45 @@ public:
 
 // do we need las original for LAS 1.5?
 
+// the trailer EVLR that a LAS/LAZ file written to a non-seekable stream ends
+// with. it carries the header values that could not be updated anymore. its
+// last 8 bytes are the chunk table start of the LAZ points so that it stays
+// where LASzip looks when the header has -1 for it. it is found via seekEnd.
+
+#define LAS_TOOLS_STREAM_TRAILER_RECORD_ID 40
+#define LAS_TOOLS_STREAM_TRAILER_PAYLOAD 216
+
+// the EVLR with the CRC-32 of the compressed bytes of every LAZ chunk. its
+// payload is the number of chunks (U32), one checksum per chunk (U32), and the
+// position where this EVLR starts (I64). it is the last EVLR of the file but
+// comes before a trailer and is found via seekEnd(). LAS 1.4 files count it.
+
+#define LAS_TOOLS_CHUNK_CHECKSUMS_RECORD_ID 41
+
+class LASvlr_stream_trailer
+{
+public:
+  I64 number_of_point_records;
+  I64 number_of_points_by_return[15];
+  F64 max_x;
+  F64 min_x;
+  F64 max_y;
+  F64 min_y;
+  F64 max_z;
+  F64 min_z;
+  F64 max_gps_time;
+  F64 min_gps_time;
+  I64 start_of_first_extended_variable_length_record;
+  U32 number_of_extended_variable_length_records;
+  U32 reserved;
+  I64 chunk_table_start_position;
+
+  LASvlr_stream_trailer()
+  {
+    memset((void*)this, 0, sizeof(LASvlr_stream_trailer));
+    chunk_table_start_position = -1;
+  };
+};
+
 
 #endif // LAS_VLR_HPP
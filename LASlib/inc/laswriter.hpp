@@ -25,6 +25,12 @@
 
   CHANGE HISTORY:
 
+    19 October 2026 -- option '-chunk_checksums' to store the CRC-32 of every LAZ chunk
+    19 October 2026 -- option '-stream_trailer' to end piped LAS/LAZ with the final header values
+    19 October 2026 -- option '-laz_level fast|max' to select the modeling level for point types 6-10
+    19 October 2026 -- options '-chunk_by_cell', '-chunk_by_gps_time', and '-chunk_by_bytes'
+    19 October 2026 -- option '-ostream_shm' to pipe LAS/LAZ through shared memory
+    19 October 2026 -- option '-async_write' to compress and write in a separate thread
     17 October 2025 -- add requested_version to select item version in laz compression
     14 June 2023 -- add tell() to the writers to be able to write copc files
     7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
@@ -86,7 +92,18 @@ public:
   BOOL set_format(const CHAR* format);
   void set_force(BOOL force);
   void set_requested_version(U32 requested_version);
+  inline U32 get_requested_version() const { return requested_version; };
   void set_chunk_size(U32 chunk_size);
+  void set_chunking(U32 chunking, F64 chunking_value);
+  inline U32 get_chunking() const { return chunking; };
+  void set_async(BOOL async);
+  void set_shm_name(const CHAR* shm_name);
+  inline const CHAR* get_shm_name() const { return shm_name; };
+  inline BOOL get_async() const { return async; };
+  void set_stream_trailer(BOOL stream_trailer);
+  inline BOOL get_stream_trailer() const { return stream_trailer; };
+  void set_chunk_checksums(BOOL chunk_checksums);
+  inline BOOL get_chunk_checksums() const { return chunk_checksums; };
   void make_numbered_file_name(const CHAR* file_name, I32 digits);
   void make_file_name(const CHAR* file_name, I32 file_number=-1);
   const CHAR* get_directory() const;
@@ -116,6 +133,8 @@ private:
   void add_directory(const CHAR* directory=0);
   void add_appendix(const CHAR* appendix=0);
   void cut_characters();
+  LASwriter* open_writer(const LASheader* header);
+  BOOL use_chunking(const LASheader* header) const;
   I32 io_obuffer_size;
   CHAR* directory;
   CHAR* file_name;
@@ -134,6 +153,12 @@ private:
   BOOL use_stdout;
   BOOL use_nil;
   U32 requested_version;
+  BOOL async;
+  CHAR* shm_name;
+  BOOL stream_trailer;
+  BOOL chunk_checksums;
+  U32 chunking;
+  F64 chunking_value;
 };
 
 #endif
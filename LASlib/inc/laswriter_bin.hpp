@@ -24,6 +24,7 @@
 
   CHANGE HISTORY:
 
+    19 October 2026 -- collect records in a block that is written with a single call
     13 October 2014 -- changed default IO buffer size with setvbuf() to 262144
     5 November 2011 -- changed default IO buffer size with setvbuf() to 65536
     5 September 2011 -- created after sampling grapes in the sommerhausen hills
@@ -66,6 +67,9 @@ private:
   F64 origin_x;
   F64 origin_y;
   F64 origin_z;
+  U8* block;
+  U32 block_fill;
+  BOOL write_block();
 };
 
 #endif
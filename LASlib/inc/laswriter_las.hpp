@@ -23,6 +23,13 @@
     implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
   CHANGE HISTORY:
+    19 October 2026 -- copies compressed LAZ chunks of compatible files without decoding them
+    19 October 2026 -- optional EVLR with the CRC-32 checksums of the LAZ chunks
+    19 October 2026 -- appends complete LAZ chunks that were compressed elsewhere
+    19 October 2026 -- final header values of non-seekable output go into a trailer EVLR
+    19 October 2026 -- chunking of LAZ by spatial cell, GPS time window, or compressed size
+    19 October 2026 -- inventory of uncompressed points is computed block by block from the buffer
+    19 October 2026 -- uncompressed points are packed into a large buffer and written in one go
     04 August 2023 -- set default of VLR header "reserved" to 0 instead of 0xAABB
     29 March 2017 -- read and write support "native LAS 1.4 extension" for LASzip
     23 October 2016 -- support writing Extended Variable Length Records (ELVRs)
@@ -53,7 +60,15 @@
 #endif
 
 class ByteStreamOut;
+class LASreader;
 class LASwritePoint;
+class LASzip;
+class LASquadtree;
+
+#define LAS_WRITER_CHUNKING_NONE       0
+#define LAS_WRITER_CHUNKING_CELL       1
+#define LAS_WRITER_CHUNKING_GPS_TIME   2
+#define LAS_WRITER_CHUNKING_BYTES      3
 
 class LASLIB_DLL LASwriterLAS : public LASwriter
 {
@@ -68,7 +83,40 @@ public:
   BOOL open(std::ostream& ostream, const LASheader* header, U32 compressor=LASZIP_COMPRESSOR_NONE, I32 requested_version=0, I32 chunk_size=50000);
   BOOL open(ByteStreamOut* stream, const LASheader* header, U32 compressor=LASZIP_COMPRESSOR_NONE, I32 requested_version=0, I32 chunk_size=50000);
 
+  // starts a new chunk whenever the cell or the time window of the points
+  // changes or the chunk has grown to the compressed bytes of 'value'. needs
+  // to be opened with variable chunking (chunk_size 0). 'max_points' caps the
+  // points per chunk except when chunking by bytes. the cells span the bounding
+  // box of 'header' and points outside of it go into the nearest border cell.
+  BOOL set_chunking(U32 chunking, F64 value, U32 max_points, const LASheader* header);
+
+  // when the stream is not seekable the header cannot be updated at the end.
+  // instead the final header values, the EVLRs start, and the LAZ chunk table
+  // start are appended in a trailer EVLR that LASreaderLAS finds via seekEnd().
+  // does nothing for seekable streams or for LAS versions below 1.4, which
+  // have no EVLRs.
+  BOOL set_stream_trailer(const LASheader* header);
+
+  // computes the CRC-32 of every LAZ chunk and stores them in an EVLR at the
+  // end. must be called after open() and before writing the first point.
+  BOOL set_chunk_checksums();
+
+  // complete LAZ chunks can be compressed elsewhere (e.g. by other threads) with
+  // a LASwritePoint that setup_chunk_writer() gives the same items and are then
+  // appended with write_chunk() in the order of their points.
+  BOOL setup_chunk_writer(LASwritePoint* chunk_writer) const;
+  BOOL write_chunk(const U8* bytes, const U32 num_bytes, const U32 number);
+
+  // the chunks of a LAZ file with the same LASzip items, scale factors, and
+  // offsets are copied byte by byte from a 'lasreader' that has not read any
+  // points yet. with fixed-sized chunks all but the last chunk must be full.
+  // the inventory takes the copied points from the header of 'lasreader' so
+  // that update_header(header, TRUE) gives the counters and bounds of all.
+  BOOL can_copy_chunks(const LASreader* lasreader) const;
+  BOOL copy_chunks(LASreader* lasreader);
+
   BOOL write_point(const LASpoint* point);
+  void update_inventory(const LASpoint* point);
   BOOL chunk();
 
   BOOL update_header(const LASheader* header, BOOL use_inventory=FALSE, BOOL update_extra_bytes=FALSE);
@@ -83,6 +131,7 @@ private:
   ByteStreamOut* stream;
   BOOL delete_stream;
   LASwritePoint* writer;
+  LASzip* laszip;
   I64 header_start_position;
   BOOL writing_las_1_4;
   BOOL writing_new_point_type;
@@ -90,6 +139,37 @@ private:
   I64 start_of_first_extended_variable_length_record;
   U32 number_of_extended_variable_length_records;
   const LASevlr* evlrs;
+  // for the header values of non-seekable streams
+  LASvlr_stream_trailer* trailer;
+  void update_trailer(const LASheader* header, BOOL use_inventory);
+  BOOL write_trailer();
+  // for the checksums of the LAZ chunks
+  BOOL write_chunk_checksums(const U32 number, const U32* checksums);
+  // for buffered write of uncompressed points
+  BOOL flush_raw();
+  U8* raw_buffer;
+  U32 raw_buffer_size;
+  U32 raw_buffer_used;
+  U32 raw_point_size;
+  U32 raw_num_items;
+  U32* raw_item_sizes;
+  BOOL raw_point14;
+  // for inventory of the buffered points
+  void inventory_raw();
+  const LASpoint* raw_last_point;
+  U8 raw_point_data_format;
+  BOOL raw_gps_time;
+  U32 raw_inventory_start;
+  U32 raw_inventory_end;
+  // for chunking strategies
+  BOOL next_chunk();
+  U32 chunking;
+  F64 chunking_value;
+  U32 chunking_max_points;
+  LASquadtree* chunking_quadtree;
+  I64 chunking_key;
+  U32 chunk_points;
+  I64 chunk_start;
 };
 
 #endif
@@ -0,0 +1,71 @@
+/*
+===============================================================================
+
+  FILE:  laswriterasync.hpp
+  
+  CONTENTS:
+  
+    Wraps another LASwriter and hands the points in batches to a dedicated
+    thread that does the actual writing (compression and I/O) so that this
+    work overlaps with the processing of the next points.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  
+  CHANGE HISTORY:
+  
+    19 October 2026 -- failures of the wrapped writer are returned and reported on close
+    19 October 2026 -- inventory is computed by the writer thread and merged at the end
+    19 October 2026 -- created to overlap LAZ compression with processing
+  
+===============================================================================
+*/
+#ifndef LAS_WRITER_ASYNC_HPP
+#define LAS_WRITER_ASYNC_HPP
+
+#include "laswriter.hpp"
+
+class LASwriterAsyncQueue;
+
+class LASLIB_DLL LASwriterAsync : public LASwriter
+{
+public:
+  BOOL open(LASwriter* writer, const LASheader* header, U32 batch_points=4096, U32 batch_number=8);
+  LASwriter* get_writer() const { return writer; };
+
+  BOOL write_point(const LASpoint* point);
+  void update_inventory(const LASpoint* point);
+  BOOL chunk();
+
+  BOOL update_header(const LASheader* header, BOOL use_inventory=FALSE, BOOL update_extra_bytes=FALSE);
+  I64 close(BOOL update_npoints=TRUE);
+  I64 tell();
+
+  LASwriterAsync();
+  ~LASwriterAsync();
+
+private:
+  BOOL flush(BOOL chunk_after);
+  BOOL drain();
+  void merge_inventory();
+
+  LASwriter* writer;
+  LASwriterAsyncQueue* queue;
+  U32 point_size;
+  U8 point_data_format;
+  const LASpoint* last_point;
+};
+
+#endif
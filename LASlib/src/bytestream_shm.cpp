@@ -0,0 +1,618 @@
+/*
+===============================================================================
+
+  FILE:  bytestream_shm.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+#include "bytestream_shm.hpp"
+
+#include "lasmessage.hpp"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define LAS_SHM_MAGIC 0x4D48534C // "LSHM"
+#define LAS_SHM_VERSION 2
+#define LAS_SHM_DATA_OFFSET 256
+
+// the control block at the start of the shared memory. the written and the
+// consumed counters only ever grow and are each updated by one process only.
+// they sit in separate cache lines so the two processes do not contend. the
+// process ids let each side notice when the other one died without closing.
+
+struct LASshmControl
+{
+  std::atomic<U32> magic;
+  U32 version;
+  U64 capacity;
+  std::atomic<U32> reader_attached;
+  std::atomic<U32> reader_closed;
+  std::atomic<U32> writer_done;
+  std::atomic<U32> writer_pid;
+  std::atomic<U32> reader_pid;
+  U8 unused0[28];
+  std::atomic<U64> written;
+  U8 unused1[56];
+  std::atomic<U64> consumed;
+  U8 unused2[56];
+};
+
+class LASshmRing
+{
+public:
+  LASshmControl* control;
+  U8* data;
+  U64 capacity;
+  size_t size;
+  CHAR name[256];
+#ifdef _WIN32
+  HANDLE handle;
+#else
+  void* address;
+#endif
+  BOOL create(const CHAR* name, U32 buffer_size);
+  BOOL attach(const CHAR* name);
+  void detach(BOOL remove);
+  LASshmRing();
+};
+
+static BOOL las_shm_make_name(CHAR* shm_name, const CHAR* name)
+{
+  if ((name == 0) || (name[0] == '\0') || (strlen(name) > 200) || strchr(name, '/') || strchr(name, '\\'))
+  {
+    laserror("shared memory name '%s' is not valid", (name ? name : ""));
+    return FALSE;
+  }
+#ifdef _WIN32
+  snprintf(shm_name, 256, "Local\\lastools_%s", name);
+#else
+  snprintf(shm_name, 256, "/lastools_%s", name);
+#endif
+  return TRUE;
+}
+
+static U32 las_shm_process_id()
+{
+#ifdef _WIN32
+  return (U32)GetCurrentProcessId();
+#else
+  return (U32)getpid();
+#endif
+}
+
+// a process that cannot be signalled or opened because of its owner is alive.
+// a pid of 0 stands for a process that has not attached yet.
+
+static BOOL las_shm_process_alive(U32 pid)
+{
+  if (pid == 0) return TRUE;
+#ifdef _WIN32
+  HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, (DWORD)pid);
+  if (process == NULL) return (GetLastError() == ERROR_ACCESS_DENIED);
+  DWORD result = WaitForSingleObject(process, 0);
+  CloseHandle(process);
+  return (result == WAIT_TIMEOUT);
+#else
+  return !((kill((pid_t)pid, 0) == -1) && (errno == ESRCH));
+#endif
+}
+
+// polling between the processes. yields first and sleeps when the other side
+// is slow for a longer time. while sleeping it checks about once a second that
+// the other process is still running and returns FALSE when it is not.
+
+static BOOL las_shm_pause(U32& spins, const std::atomic<U32>& other_pid)
+{
+  if (spins < 256)
+  {
+    spins++;
+    std::this_thread::yield();
+    return TRUE;
+  }
+  std::this_thread::sleep_for(std::chrono::microseconds(100));
+  spins++;
+  if (((spins - 256) % 10000) == 0)
+  {
+    return las_shm_process_alive(other_pid.load(std::memory_order_acquire));
+  }
+  return TRUE;
+}
+
+LASshmRing::LASshmRing()
+{
+  control = 0;
+  data = 0;
+  capacity = 0;
+  size = 0;
+  name[0] = '\0';
+#ifdef _WIN32
+  handle = 0;
+#else
+  address = MAP_FAILED;
+#endif
+}
+
+BOOL LASshmRing::create(const CHAR* name, U32 buffer_size)
+{
+  if (!las_shm_make_name(this->name, name)) return FALSE;
+  if (buffer_size < 65536) buffer_size = 65536;
+  size = LAS_SHM_DATA_OFFSET + (size_t)buffer_size;
+#ifdef _WIN32
+  handle = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, (DWORD)(((U64)size) >> 32), (DWORD)(size & 0xFFFFFFFF), this->name);
+  if (handle == NULL)
+  {
+    laserror("cannot create shared memory '%s'", this->name);
+    return FALSE;
+  }
+  if (GetLastError() == ERROR_ALREADY_EXISTS)
+  {
+    CloseHandle(handle);
+    handle = 0;
+    laserror("shared memory '%s' is already in use", this->name);
+    return FALSE;
+  }
+  U8* address = (U8*)MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+  if (address == NULL)
+  {
+    CloseHandle(handle);
+    handle = 0;
+    laserror("cannot map shared memory '%s'", this->name);
+    return FALSE;
+  }
+#else
+  // a ring left behind by a crashed process is replaced
+  shm_unlink(this->name);
+  int fd = shm_open(this->name, O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd == -1)
+  {
+    laserror("cannot create shared memory '%s'", this->name);
+    return FALSE;
+  }
+  if (ftruncate(fd, (off_t)size) != 0)
+  {
+    close(fd);
+    shm_unlink(this->name);
+    laserror("cannot allocate %u bytes of shared memory '%s'", (U32)size, this->name);
+    return FALSE;
+  }
+  address = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (address == MAP_FAILED)
+  {
+    shm_unlink(this->name);
+    laserror("cannot map shared memory '%s'", this->name);
+    return FALSE;
+  }
+#endif
+  control = new ((void*)address) LASshmControl;
+  data = ((U8*)address) + LAS_SHM_DATA_OFFSET;
+  capacity = buffer_size;
+  control->version = LAS_SHM_VERSION;
+  control->capacity = capacity;
+  control->reader_attached.store(0);
+  control->reader_closed.store(0);
+  control->writer_done.store(0);
+  control->writer_pid.store(las_shm_process_id());
+  control->reader_pid.store(0);
+  control->written.store(0);
+  control->consumed.store(0);
+  control->magic.store(LAS_SHM_MAGIC, std::memory_order_release);
+  return TRUE;
+}
+
+BOOL LASshmRing::attach(const CHAR* name)
+{
+  if (!las_shm_make_name(this->name, name)) return FALSE;
+#ifdef _WIN32
+  handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, this->name);
+  if (handle == NULL)
+  {
+    handle = 0;
+    return FALSE;
+  }
+  U8* address = (U8*)MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+  if (address == NULL)
+  {
+    CloseHandle(handle);
+    handle = 0;
+    return FALSE;
+  }
+#else
+  int fd = shm_open(this->name, O_RDWR, 0600);
+  if (fd == -1)
+  {
+    return FALSE;
+  }
+  struct stat st;
+  if ((fstat(fd, &st) != 0) || (st.st_size < LAS_SHM_DATA_OFFSET))
+  {
+    // the writer has not yet sized the ring
+    close(fd);
+    return FALSE;
+  }
+  size = (size_t)st.st_size;
+  address = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (address == MAP_FAILED)
+  {
+    return FALSE;
+  }
+#endif
+  control = (LASshmControl*)address;
+  if (control->magic.load(std::memory_order_acquire) != LAS_SHM_MAGIC)
+  {
+    // the writer has not yet initialized the ring
+    detach(FALSE);
+    return FALSE;
+  }
+  if (control->version != LAS_SHM_VERSION)
+  {
+    detach(FALSE);
+    laserror("shared memory '%s' has version %u instead of %u", this->name, control->version, LAS_SHM_VERSION);
+    return FALSE;
+  }
+  data = ((U8*)address) + LAS_SHM_DATA_OFFSET;
+  capacity = control->capacity;
+  control->reader_pid.store(las_shm_process_id(), std::memory_order_release);
+  control->reader_attached.store(1, std::memory_order_release);
+  return TRUE;
+}
+
+void LASshmRing::detach(BOOL remove)
+{
+#ifdef _WIN32
+  if (control) UnmapViewOfFile((void*)control);
+  if (handle) CloseHandle(handle);
+  handle = 0;
+#else
+  if (address != MAP_FAILED) munmap(address, size);
+  address = MAP_FAILED;
+  if (remove) shm_unlink(name);
+#endif
+  control = 0;
+  data = 0;
+}
+
+ByteStreamOutSHM::ByteStreamOutSHM()
+{
+  ring = 0;
+  count = 0;
+  free_until = 0;
+}
+
+BOOL ByteStreamOutSHM::open(const CHAR* name, U32 buffer_size)
+{
+  if (!Endian::IS_LITTLE_ENDIAN)
+  {
+    laserror("shared memory streams are only supported on little-endian hosts");
+    return FALSE;
+  }
+  ring = new LASshmRing();
+  if (!ring->create(name, buffer_size))
+  {
+    delete ring;
+    ring = 0;
+    return FALSE;
+  }
+  count = 0;
+  free_until = ring->capacity;
+  return TRUE;
+}
+
+BOOL ByteStreamOutSHM::putByte(U8 byte)
+{
+  return putBytes(&byte, 1);
+}
+
+BOOL ByteStreamOutSHM::putBytes(const U8* bytes, U32 num_bytes)
+{
+  if (ring == 0) return FALSE;
+  while (num_bytes)
+  {
+    if (count == free_until)
+    {
+      // the ring is full. wait for the reader to consume some bytes
+      U32 spins = 0;
+      while ((free_until = ring->control->consumed.load(std::memory_order_acquire) + ring->capacity) == count)
+      {
+        if (ring->control->reader_closed.load(std::memory_order_acquire)) return FALSE;
+        if (!las_shm_pause(spins, ring->control->reader_pid))
+        {
+          LASMessage(LAS_ERROR, "reader of shared memory '%s' exited without closing it", ring->name);
+          ring->control->reader_closed.store(1, std::memory_order_release);
+          return FALSE;
+        }
+      }
+    }
+    U64 start = count % ring->capacity;
+    U64 number = free_until - count;
+    if (number > ring->capacity - start) number = ring->capacity - start;
+    if (number > num_bytes) number = num_bytes;
+    memcpy(ring->data + start, bytes, (size_t)number);
+    bytes += number;
+    num_bytes -= (U32)number;
+    count += number;
+    ring->control->written.store(count, std::memory_order_release);
+  }
+  return TRUE;
+}
+
+BOOL ByteStreamOutSHM::put16bitsLE(const U8* bytes)
+{
+  return putBytes(bytes, 2);
+}
+
+BOOL ByteStreamOutSHM::put32bitsLE(const U8* bytes)
+{
+  return putBytes(bytes, 4);
+}
+
+BOOL ByteStreamOutSHM::put64bitsLE(const U8* bytes)
+{
+  return putBytes(bytes, 8);
+}
+
+BOOL ByteStreamOutSHM::put16bitsBE(const U8* bytes)
+{
+  U8 swapped[2];
+  swapped[0] = bytes[1];
+  swapped[1] = bytes[0];
+  return putBytes(swapped, 2);
+}
+
+BOOL ByteStreamOutSHM::put32bitsBE(const U8* bytes)
+{
+  U8 swapped[4];
+  swapped[0] = bytes[3];
+  swapped[1] = bytes[2];
+  swapped[2] = bytes[1];
+  swapped[3] = bytes[0];
+  return putBytes(swapped, 4);
+}
+
+BOOL ByteStreamOutSHM::put64bitsBE(const U8* bytes)
+{
+  U8 swapped[8];
+  swapped[0] = bytes[7];
+  swapped[1] = bytes[6];
+  swapped[2] = bytes[5];
+  swapped[3] = bytes[4];
+  swapped[4] = bytes[3];
+  swapped[5] = bytes[2];
+  swapped[6] = bytes[1];
+  swapped[7] = bytes[0];
+  return putBytes(swapped, 8);
+}
+
+I64 ByteStreamOutSHM::tell() const
+{
+  return (I64)count;
+}
+
+ByteStreamOutSHM::~ByteStreamOutSHM()
+{
+  if (ring)
+  {
+    ring->control->writer_done.store(1, std::memory_order_release);
+    // the ring only lives as long as one of the processes has it open. the
+    // writer waits for its reader (at most one minute for it to attach) to
+    // consume all bytes before removing it.
+    U32 spins = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (!ring->control->reader_closed.load(std::memory_order_acquire))
+    {
+      if (ring->control->reader_attached.load(std::memory_order_acquire))
+      {
+        if (ring->control->consumed.load(std::memory_order_acquire) == count) break;
+      }
+      else if (std::chrono::steady_clock::now() - start > std::chrono::seconds(60))
+      {
+        LASMessage(LAS_WARNING, "no reader attached to shared memory '%s'", ring->name);
+        break;
+      }
+      if (!las_shm_pause(spins, ring->control->reader_pid))
+      {
+        LASMessage(LAS_WARNING, "reader of shared memory '%s' exited without reading all bytes", ring->name);
+        ring->control->reader_closed.store(1, std::memory_order_release);
+        break;
+      }
+    }
+    ring->detach(TRUE);
+    delete ring;
+    ring = 0;
+  }
+}
+
+ByteStreamInSHM::ByteStreamInSHM()
+{
+  ring = 0;
+  count = 0;
+  available_until = 0;
+}
+
+BOOL ByteStreamInSHM::open(const CHAR* name, U32 timeout_seconds)
+{
+  if (!Endian::IS_LITTLE_ENDIAN)
+  {
+    laserror("shared memory streams are only supported on little-endian hosts");
+    return FALSE;
+  }
+  // the writing process may be started after the reading process
+  ring = new LASshmRing();
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  while (!ring->attach(name))
+  {
+    if (std::chrono::steady_clock::now() - start > std::chrono::seconds(timeout_seconds))
+    {
+      delete ring;
+      ring = 0;
+      laserror("no writer created shared memory '%s' within %u seconds", name, timeout_seconds);
+      return FALSE;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  count = 0;
+  available_until = 0;
+  return TRUE;
+}
+
+U32 ByteStreamInSHM::getByte()
+{
+  U8 byte;
+  getBytes(&byte, 1);
+  return (U32)byte;
+}
+
+void ByteStreamInSHM::getBytes(U8* bytes, const I64 num_bytes)
+{
+  if (ring == 0) throw EOF;
+  U64 remaining = (U64)num_bytes;
+  while (remaining)
+  {
+    if (count == available_until)
+    {
+      // the ring is empty. wait for the writer to produce some bytes
+      U32 spins = 0;
+      while ((available_until = ring->control->written.load(std::memory_order_acquire)) == count)
+      {
+        if (ring->control->writer_done.load(std::memory_order_acquire))
+        {
+          if ((available_until = ring->control->written.load(std::memory_order_acquire)) != count) break;
+          throw EOF;
+        }
+        if (!las_shm_pause(spins, ring->control->writer_pid))
+        {
+          LASMessage(LAS_ERROR, "writer of shared memory '%s' exited without closing it after %llu bytes", ring->name, count);
+          ring->control->writer_done.store(1, std::memory_order_release);
+#ifndef _WIN32
+          // the dead writer can no longer remove the ring
+          shm_unlink(ring->name);
+#endif
+          throw EOF;
+        }
+      }
+    }
+    U64 start = count % ring->capacity;
+    U64 number = available_until - count;
+    if (number > ring->capacity - start) number = ring->capacity - start;
+    if (number > remaining) number = remaining;
+    if (bytes)
+    {
+      memcpy(bytes, ring->data + start, (size_t)number);
+      bytes += number;
+    }
+    remaining -= number;
+    count += number;
+    ring->control->consumed.store(count, std::memory_order_release);
+  }
+}
+
+void ByteStreamInSHM::get16bitsLE(U8* bytes)
+{
+  getBytes(bytes, 2);
+}
+
+void ByteStreamInSHM::get32bitsLE(U8* bytes)
+{
+  getBytes(bytes, 4);
+}
+
+void ByteStreamInSHM::get64bitsLE(U8* bytes)
+{
+  getBytes(bytes, 8);
+}
+
+void ByteStreamInSHM::get16bitsBE(U8* bytes)
+{
+  getBytes(swapped, 2);
+  bytes[0] = swapped[1];
+  bytes[1] = swapped[0];
+}
+
+void ByteStreamInSHM::get32bitsBE(U8* bytes)
+{
+  getBytes(swapped, 4);
+  bytes[0] = swapped[3];
+  bytes[1] = swapped[2];
+  bytes[2] = swapped[1];
+  bytes[3] = swapped[0];
+}
+
+void ByteStreamInSHM::get64bitsBE(U8* bytes)
+{
+  getBytes(swapped, 8);
+  bytes[0] = swapped[7];
+  bytes[1] = swapped[6];
+  bytes[2] = swapped[5];
+  bytes[3] = swapped[4];
+  bytes[4] = swapped[3];
+  bytes[5] = swapped[2];
+  bytes[6] = swapped[1];
+  bytes[7] = swapped[0];
+}
+
+I64 ByteStreamInSHM::tell() const
+{
+  return (I64)count;
+}
+
+BOOL ByteStreamInSHM::seek(const I64 position)
+{
+  if ((U64)position < count) return FALSE;
+  if ((U64)position > count)
+  {
+    try { getBytes(0, position - (I64)count); } catch (...) { return FALSE; }
+  }
+  return TRUE;
+}
+
+ByteStreamInSHM::~ByteStreamInSHM()
+{
+  if (ring)
+  {
+    ring->control->reader_closed.store(1, std::memory_order_release);
+    ring->detach(FALSE);
+    delete ring;
+    ring = 0;
+  }
+}
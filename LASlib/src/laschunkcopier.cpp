@@ -0,0 +1,249 @@
+/*
+===============================================================================
+
+  FILE:  laschunkcopier.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+#include "laschunkcopier.hpp"
+
+#include "lasmessage.hpp"
+#include "lasreader_las.hpp"
+#include "laswriter_las.hpp"
+#include "laszip.hpp"
+
+#include <vector>
+
+LASreaderLAS* LASchunkcopier::open_reader(LASreadOpener* lasreadopener, U32 number) const
+{
+  const CHAR* file_name = lasreadopener->get_file_name(number);
+  if ((file_name == 0) || (lasreadopener->get_file_format(number) != LAS_TOOLS_FORMAT_LAZ))
+  {
+    return 0;
+  }
+  LASreaderLAS* lasreaderlas = new LASreaderLAS(lasreadopener);
+  if (!lasreaderlas->open(file_name, lasreadopener->get_io_ibuffer_size()))
+  {
+    delete lasreaderlas;
+    return 0;
+  }
+  // files that the merged reader skips are skipped here too
+  lasreadopener->file_formula(lasreaderlas);
+  return lasreaderlas;
+}
+
+BOOL LASchunkcopier::copy(LASreadOpener* lasreadopener, LASheader* header, const LASwriteOpener* laswriteopener)
+{
+  number_files = 0;
+  npoints = 0;
+
+  if ((lasreadopener == 0) || (header == 0) || (laswriteopener == 0))
+  {
+    laserror("copying chunks needs a reader, a header, and a writer");
+    return FALSE;
+  }
+
+  if ((laswriteopener->get_format() != LAS_TOOLS_FORMAT_LAZ) || (laswriteopener->get_file_name() == 0))
+  {
+    LASMessage(LAS_VERBOSE, "copying chunks needs a LAZ file as output");
+    return FALSE;
+  }
+
+  // first check that the chunks of all files fit into one file with this header.
+  // the files stay open for copying their chunks.
+
+  U32 compressor = 0;
+  U32 chunk_size = U32_MAX;
+  std::vector<LASitem> items;
+  std::vector<LASreaderLAS*> readers;
+  std::vector<U32> numbers;
+  BOOL fixed = TRUE;
+  I64 count = 0;
+  const CHAR* reason = 0;
+  U32 i, n = lasreadopener->get_file_name_number();
+  for (i = 0; (i < n) && (reason == 0); i++)
+  {
+    LASreaderLAS* lasreaderlas = open_reader(lasreadopener, i);
+    if (lasreaderlas == 0)
+    {
+      reason = "it is not a LAZ file";
+      break;
+    }
+    if (lasreadopener->is_file_formula_filtered() || (lasreaderlas->npoints == 0))
+    {
+      lasreaderlas->close();
+      delete lasreaderlas;
+      continue;
+    }
+    const LASheader* other = &(lasreaderlas->header);
+    const LASzip* laszip = other->laszip;
+    if ((laszip == 0) || (laszip->compressor == LASZIP_COMPRESSOR_NONE) || (laszip->compressor == LASZIP_COMPRESSOR_POINTWISE))
+    {
+      reason = "it is not chunked LAZ";
+    }
+    else if ((other->point_data_format != header->point_data_format) || (other->point_data_record_length != header->point_data_record_length))
+    {
+      reason = "of a different point type or size";
+    }
+    else if ((other->x_scale_factor != header->x_scale_factor) || (other->y_scale_factor != header->y_scale_factor) || (other->z_scale_factor != header->z_scale_factor))
+    {
+      reason = "of different scale factors";
+    }
+    else if ((other->x_offset != header->x_offset) || (other->y_offset != header->y_offset) || (other->z_offset != header->z_offset))
+    {
+      reason = "of different offsets";
+    }
+    else if (((other->global_encoding & 1) != (header->global_encoding & 1)) || (other->time_offset != header->time_offset))
+    {
+      reason = "of a different type of GPS time";
+    }
+    else if ((header->version_minor >= 5) && (other->version_minor < 5))
+    {
+      reason = "its header has no GPS time range";
+    }
+    else if (readers.size() == 0)
+    {
+      compressor = laszip->compressor;
+      chunk_size = ((laszip->chunk_size == 0) ? U32_MAX : laszip->chunk_size);
+      items.assign(laszip->items, laszip->items + laszip->num_items);
+    }
+    else
+    {
+      U32 j;
+      BOOL same = ((laszip->compressor == compressor) && (laszip->num_items == items.size()));
+      for (j = 0; same && (j < items.size()); j++)
+      {
+        same = ((laszip->items[j].type == items[j].type) && (laszip->items[j].size == items[j].size) && (laszip->items[j].version == items[j].version));
+      }
+      if (!same)
+      {
+        reason = "of different LASzip items";
+      }
+      // fixed-sized chunks can only follow full chunks
+      else if ((((laszip->chunk_size == 0) ? U32_MAX : laszip->chunk_size) != chunk_size) || (chunk_size == U32_MAX) || (count % chunk_size))
+      {
+        fixed = FALSE;
+      }
+    }
+    if (reason)
+    {
+      lasreaderlas->close();
+      delete lasreaderlas;
+      break;
+    }
+    count += lasreaderlas->npoints;
+    readers.push_back(lasreaderlas);
+    numbers.push_back(i);
+  }
+
+  if (chunk_size == U32_MAX)
+  {
+    fixed = FALSE;
+  }
+  BOOL compatible = FALSE;
+  if (reason)
+  {
+    LASMessage(LAS_VERBOSE, "cannot copy chunks of '%s' because %s", lasreadopener->get_file_name(i), reason);
+  }
+  else if (readers.size() == 0)
+  {
+    LASMessage(LAS_VERBOSE, "no chunks to copy");
+  }
+  else if (!fixed && (header->point_data_format <= 5))
+  {
+    LASMessage(LAS_VERBOSE, "cannot copy chunks because point type %d needs full chunks of %u points", (I32)header->point_data_format, chunk_size);
+  }
+  else
+  {
+    compatible = TRUE;
+  }
+  if (!compatible)
+  {
+    for (i = 0; i < readers.size(); i++)
+    {
+      readers[i]->close();
+      delete readers[i];
+    }
+    return FALSE;
+  }
+
+  // then copy the chunks into a file that has the LASzip items of the files
+  // with the item version of the files and not that of the LAS version
+
+  LASzip* laszip = header->laszip;
+  header->laszip = readers[0]->header.laszip;
+  LASwriterLAS* laswriterlas = new LASwriterLAS();
+  BOOL success = laswriterlas->open(laswriteopener->get_file_name(), header, compressor, items[0].version, (fixed ? (I32)chunk_size : 0), laswriteopener->get_io_obuffer_size());
+  header->laszip = laszip;
+  if (!success)
+  {
+    laserror("cannot open '%s' for copying chunks", laswriteopener->get_file_name());
+  }
+  else if (laswriteopener->get_chunk_checksums())
+  {
+    laswriterlas->set_chunk_checksums();
+  }
+
+  for (i = 0; i < readers.size(); i++)
+  {
+    if (success)
+    {
+      success = laswriterlas->copy_chunks(readers[i]);
+      if (success)
+      {
+        number_files++;
+        npoints += readers[i]->npoints;
+      }
+      else
+      {
+        laserror("cannot copy chunks of '%s'", lasreadopener->get_file_name(numbers[i]));
+      }
+    }
+    readers[i]->close();
+    delete readers[i];
+  }
+
+  // the counters, the bounding box, and the GPS time range of the header come
+  // from the inventory that the writer merged from the headers of the files
+
+  if (success)
+  {
+    success = laswriterlas->update_header(header, TRUE);
+  }
+  laswriterlas->close();
+  delete laswriterlas;
+  return success;
+}
+
+LASchunkcopier::LASchunkcopier()
+{
+  number_files = 0;
+  npoints = 0;
+}
+
+LASchunkcopier::~LASchunkcopier()
+{
+}
@@ -30,6 +30,7 @@
 */
 #include "lasreader.hpp"
 
+#include "bytestream_shm.hpp"
 #include "lascopc.hpp"
 #include "lasfilter.hpp"
 #include "lasindex.hpp"
@@ -433,6 +434,9 @@ I32 LASreadOpener::unparse(CHAR* string) const {
   if (stored) {
     n += sprintf(string + n, "-stored ");
   }
+  if (stored_raw) {
+    n += sprintf(string + n, "-stored_raw %u ", stored_raw);
+  }
   if (merged) {
     n += sprintf(string + n, "-merged ");
   }
@@ -475,6 +479,21 @@ I32 LASreadOpener::unparse(CHAR* string) const {
   if (io_ibuffer_size != LAS_TOOLS_IO_IBUFFER_SIZE) {
     n += sprintf(string + n, "-io_ibuffer %u ", io_ibuffer_size);
   }
+  if (merged_catalog) {
+    n += sprintf(string + n, "-merged_catalog \"%s\" ", merged_catalog);
+  }
+  if (merged_threads != 4) {
+    n += sprintf(string + n, "-merged_threads %u ", merged_threads);
+  }
+  if (merged_prefetch) {
+    n += sprintf(string + n, "-merged_prefetch %u ", merged_prefetch);
+  }
+  if (decode_threads > 1) {
+    n += sprintf(string + n, "-decode_threads %u ", decode_threads);
+  }
+  if (seek_cache) {
+    n += sprintf(string + n, "-seek_cache %u ", seek_cache);
+  }
   if (!temp_file_base.empty()) {
     n += sprintf(string + n, "-temp_files \"%s\" ", temp_file_base.c_str());
   }
@@ -484,6 +503,9 @@ I32 LASreadOpener::unparse(CHAR* string) const {
   if (skip_lines) {
     n += sprintf(string + n, "-iskip %d ", skip_lines);
   }
+  if (raster_decimate > 1) {
+    n += sprintf(string + n, "-iraster_decimate %u ", raster_decimate);
+  }
   if (itxt){
     if (ipts) {
       n += sprintf(string + n, "-ipts ");
@@ -588,6 +610,9 @@ LASreader* LASreadOpener::open(const CHAR* other_file_name, BOOL reset_after_oth
       lasreadermerged->set_scale_scan_angle(scale_scan_angle);
       lasreadermerged->set_io_ibuffer_size(io_ibuffer_size);
       lasreadermerged->set_copc_stream_order(copc_stream_order);
+      lasreadermerged->set_catalog_file_name(merged_catalog);
+      lasreadermerged->set_header_scan_threads(merged_threads);
+      lasreadermerged->set_prefetch_depth(merged_prefetch);
       if (file_names_ID) {
         for (file_name_current = 0; file_name_current < file_name_number; file_name_current++)
           lasreadermerged->add_file_name(file_names[file_name_current], file_names_ID[file_name_current]);
@@ -643,6 +668,8 @@ LASreader* LASreadOpener::open(const CHAR* other_file_name, BOOL reset_after_oth
       U32 i;
       LASreaderBuffered* lasreaderbuffered = new LASreaderBuffered(this);
       lasreaderbuffered->set_buffer_size(buffer_size);
+      lasreaderbuffered->set_neighbor_threads(buffered_threads);
+      lasreaderbuffered->set_neighbor_cache(buffered_cache);
       lasreaderbuffered->set_scale_factor(scale_factor);
       lasreaderbuffered->set_offset(offset);
       lasreaderbuffered->set_parse_string(parse_string);
@@ -797,6 +824,8 @@ LASreader* LASreadOpener::open(const CHAR* other_file_name, BOOL reset_after_oth
           lasreaderlas = new LASreaderLASrescalereoffset(this, scale_factor[0], scale_factor[1], scale_factor[2], offset[0], offset[1], offset[2]);
 
         lasreaderlas->set_keep_copc(keep_copc);
+        lasreaderlas->set_decode_threads(decode_threads);
+        lasreaderlas->set_seek_cache(seek_cache * 1024 * 1024);
         if (lasreaderlas->open(file_name, io_ibuffer_size, FALSE, decompress_selective)) {
           LASMessage(LAS_VERY_VERBOSE, "open file '%s'", file_name);
         } else {
@@ -1389,6 +1418,10 @@ LASreader* LASreadOpener::open(const CHAR* other_file_name, BOOL reset_after_oth
               attribute_pre_scales[i], attribute_pre_offsets[i], attribute_no_datas[i]);
         }
       }
+      if (shm_name) {
+        laserror("only LAS or LAZ can be streamed through shared memory");
+        return 0;
+      }
       if (!lasreadertxt->open(stdin, 0, point_type, parse_string, skip_lines, FALSE)) {
         laserror("cannot open lasreadertxt with file name '%s'", file_name);
         delete lasreadertxt;
@@ -1441,7 +1474,22 @@ LASreader* LASreadOpener::open(const CHAR* other_file_name, BOOL reset_after_oth
         lasreaderlas = new LASreaderLASreoffset(this, offset[0], offset[1], offset[2]);
       else
         lasreaderlas = new LASreaderLASrescalereoffset(this, scale_factor[0], scale_factor[1], scale_factor[2], offset[0], offset[1], offset[2]);
-      if (!lasreaderlas->open(stdin)) {
+      lasreaderlas->set_decode_threads(decode_threads);
+      lasreaderlas->set_seek_cache(seek_cache * 1024 * 1024);
+      if (shm_name) {
+        ByteStreamInSHM* in = new ByteStreamInSHM();
+        if (!in->open(shm_name)) {
+          laserror("cannot open shared memory stream '%s'", shm_name);
+          delete in;
+          delete lasreaderlas;
+          return 0;
+        }
+        if (!lasreaderlas->open(in)) {
+          laserror("cannot open lasreaderlas from shared memory stream '%s'", shm_name);
+          delete lasreaderlas;
+          return 0;
+        }
+      } else if (!lasreaderlas->open(stdin)) {
         laserror("cannot open lasreaderlas from stdin ");
         delete lasreaderlas;
         return 0;
@@ -1717,16 +1765,22 @@ void LASreadOpener::usage() const {
       "Supported LAS Inputs\n"
       "  -i lidar.las\n"
       "  -i lidar.laz\n"
+      "  -i lidar.laz -decode_threads 4\n"
+      "  -i lidar.laz -seek_cache 16 (MB of decoded points to replay when seeking back)\n"
       "  -i lidar1.las lidar2.las lidar3.las -merged\n"
       "  -i *.las -merged\n"
+      "  -i *.laz -merged -merged_catalog tiles.lmc -merged_threads 16\n"
+      "  -i *.laz -merged -merged_prefetch 2\n"
       "  -i *.las -subdir\n"
       "  -i flight0??.laz flight1??.laz\n"
       "  -i terrasolid.bin\n"
       "  -i esri.shp\n"
       "  -i lidar.txt -iparse xyzti -iskip 2 (on-the-fly from ASCII)\n"
       "  -i lidar.txt -iparse xyzi -itranslate_intensity 1024\n"
+      "  -i dem.bil -iraster_decimate 10 (average of 10x10 raster cells)\n"
       "  -lof file_list.txt\n"
       "  -stdin (pipe from stdin)\n"
+      "  -istream_shm name (pipe from shared memory)\n"
       "  -rescale 0.01 0.01 0.001\n"
       "  -rescale_xy 0.01 0.01\n"
       "  -rescale_z 0.01\n"
@@ -1966,6 +2020,30 @@ void LASreadOpener::parse(int argc, char* argv[], BOOL parse_ignore, BOOL suppre
         *argv[i] = '\0';
         *argv[i + 1] = '\0';
         i += 1;
+      } else if (strcmp(argv[i], "-iraster_decimate") == 0) {
+        if ((i + 1) >= argc) {
+          laserror("'%s' needs 1 argument: block_size", argv[i]);
+        }
+        U32 decimate;
+        if (sscanf(argv[i + 1], "%u", &decimate) != 1) {
+          laserror("'%s' needs 1 argument: block_size but '%s' is not a valid number.", argv[i], argv[i + 1]);
+        }
+        if (decimate == 0) {
+          laserror("'%s' needs 1 argument: block_size but %u is not valid.", argv[i], decimate);
+        }
+        set_raster_decimate(decimate);
+        *argv[i] = '\0';
+        *argv[i + 1] = '\0';
+        i += 1;
+      } else if (strcmp(argv[i], "-istream_shm") == 0) {
+        if ((i + 1) >= argc) {
+          laserror("'%s' needs 1 argument: name", argv[i]);
+        }
+        set_shm_name(argv[i + 1]);
+        use_stdin = TRUE;
+        *argv[i] = '\0';
+        *argv[i + 1] = '\0';
+        i += 1;
       } else if (strcmp(argv[i], "-io_ibuffer") == 0) {
         if ((i + 1) >= argc) {
           laserror("'%s' needs 1 argument: size", argv[i]);
@@ -2174,10 +2252,39 @@ void LASreadOpener::parse(int argc, char* argv[], BOOL parse_ignore, BOOL suppre
     } else if (strncmp(argv[i], "-s", 2) == 0) {
       if (strcmp(argv[i], "-stdin") == 0) {
         use_stdin = TRUE;
+        set_shm_name(0);
         *argv[i] = '\0';
       } else if (strcmp(argv[i], "-stored") == 0) {
         set_stored(TRUE);
         *argv[i] = '\0';
+      } else if (strcmp(argv[i], "-stored_raw") == 0) {
+        if ((i + 1) >= argc) {
+          laserror("'%s' needs 1 argument: megabytes", argv[i]);
+        }
+        U32 megabytes;
+        if (sscanf(argv[i + 1], "%u", &megabytes) != 1) {
+          laserror("'%s' needs 1 argument: megabytes but '%s' is not a valid number.", argv[i], argv[i + 1]);
+        }
+        set_stored(TRUE);
+        set_stored_raw(megabytes);
+        *argv[i] = '\0';
+        *argv[i + 1] = '\0';
+        i += 1;
+      } else if (strcmp(argv[i], "-seek_cache") == 0) {
+        if ((i + 1) >= argc) {
+          laserror("'%s' needs 1 argument: megabytes", argv[i]);
+        }
+        U32 megabytes;
+        if (sscanf(argv[i + 1], "%u", &megabytes) != 1) {
+          laserror("'%s' needs 1 argument: megabytes but '%s' is not a valid number.", argv[i], argv[i + 1]);
+        }
+        if (megabytes >= 4096) {
+          laserror("'%s' needs 1 argument: megabytes but %u is not below 4096.", argv[i], megabytes);
+        }
+        set_seek_cache(megabytes);
+        *argv[i] = '\0';
+        *argv[i + 1] = '\0';
+        i += 1;
       } else if (strcmp(argv[i], "-subdir") == 0) {
         set_subdir(TRUE);
         *argv[i] = '\0';
@@ -2259,6 +2366,41 @@ void LASreadOpener::parse(int argc, char* argv[], BOOL parse_ignore, BOOL suppre
     } else if (strcmp(argv[i], "-merged") == 0) {
       set_merged(TRUE);
       *argv[i] = '\0';
+    } else if (strcmp(argv[i], "-merged_catalog") == 0) {
+      if ((i + 1) >= argc) {
+        laserror("'%s' needs 1 argument: file_name", argv[i]);
+      }
+      set_merged_catalog(argv[i + 1]);
+      *argv[i] = '\0';
+      *argv[i + 1] = '\0';
+      i += 1;
+    } else if (strcmp(argv[i], "-merged_threads") == 0) {
+      if ((i + 1) >= argc) {
+        laserror("'%s' needs 1 argument: number", argv[i]);
+      }
+      U32 threads;
+      if (sscanf(argv[i + 1], "%u", &threads) != 1) {
+        laserror("'%s' needs 1 argument: number but '%s' is not a valid number.", argv[i], argv[i + 1]);
+      }
+      if (threads == 0) {
+        laserror("'%s' needs 1 argument: number but %u is not valid.", argv[i], threads);
+      }
+      set_merged_threads(threads);
+      *argv[i] = '\0';
+      *argv[i + 1] = '\0';
+      i += 1;
+    } else if (strcmp(argv[i], "-merged_prefetch") == 0) {
+      if ((i + 1) >= argc) {
+        laserror("'%s' needs 1 argument: depth", argv[i]);
+      }
+      U32 depth;
+      if (sscanf(argv[i + 1], "%u", &depth) != 1) {
+        laserror("'%s' needs 1 argument: depth but '%s' is not a valid number.", argv[i], argv[i + 1]);
+      }
+      set_merged_prefetch(depth);
+      *argv[i] = '\0';
+      *argv[i + 1] = '\0';
+      i += 1;
     } else if (strcmp(argv[i], "-buffered") == 0) {
       if ((i + 1) >= argc) {
         laserror("'%s' needs 1 argument: buffer_size", argv[i]);
@@ -2274,6 +2416,48 @@ void LASreadOpener::parse(int argc, char* argv[], BOOL parse_ignore, BOOL suppre
       *argv[i] = '\0';
       *argv[i + 1] = '\0';
       i += 1;
+    } else if (strcmp(argv[i], "-buffered_threads") == 0) {
+      if ((i + 1) >= argc) {
+        laserror("'%s' needs 1 argument: number", argv[i]);
+      }
+      U32 threads;
+      if (sscanf(argv[i + 1], "%u", &threads) != 1) {
+        laserror("'%s' needs 1 argument: number but '%s' is not a valid number.", argv[i], argv[i + 1]);
+      }
+      if (threads == 0) {
+        laserror("'%s' needs 1 argument: number but %u is not valid.", argv[i], threads);
+      }
+      set_buffered_threads(threads);
+      *argv[i] = '\0';
+      *argv[i + 1] = '\0';
+      i += 1;
+    } else if (strcmp(argv[i], "-decode_threads") == 0) {
+      if ((i + 1) >= argc) {
+        laserror("'%s' needs 1 argument: number", argv[i]);
+      }
+      U32 threads;
+      if (sscanf(argv[i + 1], "%u", &threads) != 1) {
+        laserror("'%s' needs 1 argument: number but '%s' is not a valid number.", argv[i], argv[i + 1]);
+      }
+      if (threads == 0) {
+        laserror("'%s' needs 1 argument: number but %u is not valid.", argv[i], threads);
+      }
+      set_decode_threads(threads);
+      *argv[i] = '\0';
+      *argv[i + 1] = '\0';
+      i += 1;
+    } else if (strcmp(argv[i], "-buffered_cache") == 0) {
+      if ((i + 1) >= argc) {
+        laserror("'%s' needs 1 argument: megabytes", argv[i]);
+      }
+      U32 megabytes;
+      if (sscanf(argv[i + 1], "%u", &megabytes) != 1) {
+        laserror("'%s' needs 1 argument: megabytes but '%s' is not a valid number.", argv[i], argv[i + 1]);
+      }
+      set_buffered_cache(megabytes);
+      *argv[i] = '\0';
+      *argv[i + 1] = '\0';
+      i += 1;
     } else if (strcmp(argv[i], "-temp_files") == 0) {
       if ((i + 1) >= argc) {
         laserror("'%s' needs 1 argument: base name", argv[i]);
@@ -2585,6 +2769,10 @@ void LASreadOpener::set_stored(const BOOL stored) {
   this->stored = stored;
 }
 
+void LASreadOpener::set_stored_raw(const U32 stored_raw) {
+  this->stored_raw = stored_raw;
+}
+
 void LASreadOpener::set_buffer_size(const F32 buffer_size) {
   this->buffer_size = buffer_size;
 }
@@ -2593,6 +2781,22 @@ F32 LASreadOpener::get_buffer_size() const {
   return buffer_size;
 }
 
+void LASreadOpener::set_buffered_threads(const U32 buffered_threads) {
+  this->buffered_threads = buffered_threads;
+}
+
+void LASreadOpener::set_decode_threads(const U32 decode_threads) {
+  this->decode_threads = decode_threads;
+}
+
+void LASreadOpener::set_seek_cache(const U32 seek_cache) {
+  this->seek_cache = seek_cache;
+}
+
+void LASreadOpener::set_buffered_cache(const U32 buffered_cache) {
+  this->buffered_cache = buffered_cache;
+}
+
 void LASreadOpener::set_filter(LASfilter* filter) {
   this->filter = filter;
 }
@@ -3238,6 +3442,32 @@ const CHAR* LASreadOpener::get_parse_string() const {
   return parse_string;
 }
 
+void LASreadOpener::set_merged_catalog(const CHAR* merged_catalog) {
+  if (this->merged_catalog) free(this->merged_catalog);
+  if (merged_catalog) {
+    this->merged_catalog = LASCopyString(merged_catalog);
+  } else {
+    this->merged_catalog = 0;
+  }
+}
+
+void LASreadOpener::set_shm_name(const CHAR* shm_name) {
+  if (this->shm_name) free(this->shm_name);
+  if (shm_name) {
+    this->shm_name = LASCopyString(shm_name);
+  } else {
+    this->shm_name = 0;
+  }
+}
+
+void LASreadOpener::set_merged_threads(const U32 merged_threads) {
+  this->merged_threads = merged_threads;
+}
+
+void LASreadOpener::set_merged_prefetch(const U32 merged_prefetch) {
+  this->merged_prefetch = merged_prefetch;
+}
+
 void LASreadOpener::set_scale_factor(const F64* scale_factor) {
   if (scale_factor) {
     if (this->scale_factor == 0) this->scale_factor = new F64[3];
@@ -3303,6 +3533,10 @@ void LASreadOpener::set_skip_lines(const U32 number_of_lines) {
   this->skip_lines = number_of_lines;
 }
 
+void LASreadOpener::set_raster_decimate(const U32 decimate) {
+  this->raster_decimate = decimate;
+}
+
 void LASreadOpener::set_populate_header(BOOL populate_header) {
   this->populate_header = populate_header;
 }
@@ -3389,11 +3623,17 @@ LASreadOpener::LASreadOpener() {
   merged = FALSE;
   subdir = FALSE;
   stored = FALSE;
+  stored_raw = 0;
   use_stdin = FALSE;
+  shm_name = 0;
   comma_not_point = FALSE;
   scale_factor = 0;
   offset = 0;
   buffer_size = 0.0f;
+  buffered_threads = 4;
+  decode_threads = 1;
+  seek_cache = 0;
+  buffered_cache = 0;
   auto_reoffset = FALSE;
   offset_adjust = FALSE;
   files_are_flightlines = 0;
@@ -3421,6 +3661,10 @@ LASreadOpener::LASreadOpener() {
   point_type = 0;
   parse_string = 0;
   skip_lines = 0;
+  raster_decimate = 1;
+  merged_catalog = 0;
+  merged_threads = 4;
+  merged_prefetch = 0;
   populate_header = FALSE;
   keep_lastiling = FALSE;
   keep_copc = FALSE;
@@ -3480,6 +3724,8 @@ LASreadOpener::~LASreadOpener() {
     }
   }
   if (parse_string) free(parse_string);
+  if (merged_catalog) free(merged_catalog);
+  if (shm_name) free(shm_name);
   if (scale_factor) delete[] scale_factor;
   if (offset) delete[] offset;
   if (inside_tile) delete[] inside_tile;
@@ -143,216 +143,68 @@ BOOL LASreaderBIL::open(const CHAR* file_name)
   header.min_y = ulycenter - (nrows-1)*static_cast<F64>(ydim);
   header.max_x = ulxcenter + (ncols-1)*static_cast<F64>(xdim);
   header.max_y = ulycenter;
-  header.min_z = F64_MAX;
-  header.max_z = F64_MIN;
 
-  // init the bounding box z and count the rasters
+  // the raster is not scanned here because a query may only need a small part of it.
+  // the number of points is bounded by the number of cells (or blocks when decimating)
+  // and the z range comes from the optional *.stx file. both are recounted for the
+  // window of an '-inside' query.
 
-  F32 elevation = 0;
-  npoints = 0;
+  pixel_bytes = ((nbits == 32) ? 4 : ((nbits == 16) ? 2 : nbands));
+  set_window(header.min_x, header.min_y, header.max_x, header.max_y);
 
-  if (nbits == 32)
-  {
-    if (floatpixels)
-    {
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&elevation, 4, 1, file) == 1)
-          {
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
-    else
-    {
-      I32 elev;
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&elev, 4, 1, file) == 1)
-          {
-            elevation = (F32)elev;
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
-  }
-  else if (nbits == 16)
+  raster_npoints = static_cast<I64>((ncols + decimate - 1) / decimate) * static_cast<I64>((nrows + decimate - 1) / decimate);
+
+  if (read_stx_file(file_name))
   {
-    if (signedpixels)
-    {
-      I16 elev;
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&elev, 2, 1, file) == 1)
-          {
-            elevation = (F32)elev;
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
-    else
-    {
-      U16 elev;
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&elev, 2, 1, file) == 1)
-          {
-            elevation = (F32)elev;
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
+    raster_min_z = header.min_z;
+    raster_max_z = header.max_z;
   }
   else
   {
-    if (signedpixels)
-    {
-      I8 rgb[4];
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&rgb, 1, nbands, file) == (U32)nbands)
-          {
-            elevation = (F32)(rgb[0]);
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
-    else
-    {
-      U8 rgb[4];
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&rgb, 1, nbands, file) == (U32)nbands)
-          {
-            elevation = (F32)(rgb[0]);
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
+    LASMessage(LAS_VERBOSE, "no *.stx file for '%s'. z range of BIL raster is unknown", file_name);
+    raster_min_z = 0;
+    raster_max_z = 0;
   }
 
+  npoints = raster_npoints;
+  header.number_of_point_records = (npoints > U32_MAX ? 0 : (U32)npoints);
+  header.min_z = raster_min_z;
+  header.max_z = raster_max_z;
+
   // close the BIL file
 
   close();
 
-  // check the header values
+  // populate scale and offset
 
-  header.number_of_point_records = (U32)npoints;
+  populate_scale_and_offset();
 
-  if (npoints)
-  {
-    // populate scale and offset
+  // check bounding box for this scale and offset
 
-    populate_scale_and_offset();
+  populate_bounding_box();
 
-    // check bounding box for this scale and offset
+  // add the VLR for Raster LAZ (decimated points no longer lie on the raster grid)
 
-    populate_bounding_box();
-  }
-  else
+  if (decimate == 1)
   {
-    LASMessage(LAS_WARNING, "BIL raster contains only no data values");
-    header.min_z = 0;
-    header.max_z = 0;
+    LASvlrRasterLAZ vlrRasterLAZ;
+    vlrRasterLAZ.nbands = 1;
+    vlrRasterLAZ.nbits = 32;
+    vlrRasterLAZ.ncols = ncols;
+    vlrRasterLAZ.nrows = nrows;
+    vlrRasterLAZ.reserved1 = 0;
+    vlrRasterLAZ.reserved2 = 0;
+    vlrRasterLAZ.stepx = xdim;
+    vlrRasterLAZ.stepx_y = 0.0;
+    vlrRasterLAZ.stepy = ydim;
+    vlrRasterLAZ.stepy_x = 0.0;
+    vlrRasterLAZ.llx = ulxcenter - 0.5*xdim;
+    vlrRasterLAZ.lly = ulycenter + (0.5 - nrows)*ydim;
+    vlrRasterLAZ.sigmaxy = 0.0;
+
+    header.add_vlr("Raster LAZ", 7113, (U16)vlrRasterLAZ.get_payload_size(), vlrRasterLAZ.get_payload(), FALSE, "by LAStools of rapidlasso GmbH", FALSE);
   }
 
-  // add the VLR for Raster LAZ 
-
-  LASvlrRasterLAZ vlrRasterLAZ;
-  vlrRasterLAZ.nbands = 1;
-  vlrRasterLAZ.nbits = 32;
-  vlrRasterLAZ.ncols = ncols;
-  vlrRasterLAZ.nrows = nrows;
-  vlrRasterLAZ.reserved1 = 0;
-  vlrRasterLAZ.reserved2 = 0;
-  vlrRasterLAZ.stepx = xdim;
-  vlrRasterLAZ.stepx_y = 0.0;
-  vlrRasterLAZ.stepy = ydim;
-  vlrRasterLAZ.stepy_x = 0.0;
-  vlrRasterLAZ.llx = ulxcenter - 0.5*xdim;
-  vlrRasterLAZ.lly = ulycenter + (0.5 - nrows)*ydim;
-  vlrRasterLAZ.sigmaxy = 0.0;
-
-  header.add_vlr("Raster LAZ", 7113, (U16)vlrRasterLAZ.get_payload_size(), vlrRasterLAZ.get_payload(), FALSE, "by LAStools of rapidlasso GmbH", FALSE);
-
   // reopen
 
   return reopen(file_name);
@@ -630,6 +482,76 @@ BOOL LASreaderBIL::read_blw_file(const CHAR* file_name)
   return TRUE;
 }
 
+// reads the z range of the first band from the optional ESRI statistics file
+// whose lines are 'band min max mean stddev'
+
+BOOL LASreaderBIL::read_stx_file(const CHAR* file_name)
+{
+  if (file_name == 0)
+  {
+    laserror("file name pointer is zero");
+    return FALSE;
+  }
+
+  // create *.stx file name
+
+  I32 len = (I32)strlen(file_name) - 3;
+  CHAR* file_name_stx = LASCopyString(file_name);
+
+  while ((len > 0) && (file_name_stx[len] != '.')) len--;
+
+  if ((len < 0) || (file_name_stx[len] != '.'))
+  {
+    free(file_name_stx);
+    return FALSE;
+  }
+
+  file_name_stx[len+1] = 's';
+  file_name_stx[len+2] = 't';
+  file_name_stx[len+3] = 'x';
+
+  FILE* file = LASfopen(file_name_stx, "r");
+
+  if (file == 0)
+  {
+    file_name_stx[len+1] = 'S';
+    file_name_stx[len+2] = 'T';
+    file_name_stx[len+3] = 'X';
+
+    file = LASfopen(file_name_stx, "r");
+  }
+
+  free(file_name_stx);
+
+  if (file == 0)
+  {
+    return FALSE;
+  }
+
+  CHAR line[512];
+  I32 band = 0;
+  F64 min_z = 0;
+  F64 max_z = 0;
+
+  BOOL found = FALSE;
+  while (!found && fgets(line, 256, file))
+  {
+    found = ((sscanf(line, "%d %lf %lf", &band, &min_z, &max_z) == 3) && (band == 1) && (min_z <= max_z));
+  }
+
+  fclose(file);
+
+  if (!found)
+  {
+    LASMessage(LAS_WARNING, "no z range for band 1 in *.stx file of '%s'", file_name);
+    return FALSE;
+  }
+
+  header.min_z = min_z;
+  header.max_z = max_z;
+  return TRUE;
+}
+
 void LASreaderBIL::set_scale_factor(const F64* scale_factor)
 {
   if (scale_factor)
@@ -663,156 +585,335 @@ void LASreaderBIL::set_offset(const F64* offset)
 }
 
 
+void LASreaderBIL::set_decimate(const I32 decimate)
+{
+  this->decimate = (decimate > 1 ? decimate : 1);
+}
+
+BOOL LASreaderBIL::inside_none()
+{
+  LASreader::inside_none();
+  set_window(header.min_x, header.min_y, header.max_x, header.max_y);
+  npoints = raster_npoints;
+  header.number_of_point_records = (npoints > U32_MAX ? 0 : (U32)npoints);
+  header.min_z = raster_min_z;
+  header.max_z = raster_max_z;
+  return TRUE;
+}
+
+BOOL LASreaderBIL::inside_tile(const F32 ll_x, const F32 ll_y, const F32 size)
+{
+  LASreader::inside_tile(ll_x, ll_y, size);
+  set_window(ll_x, ll_y, static_cast<F64>(ll_x) + static_cast<F64>(size), static_cast<F64>(ll_y) + static_cast<F64>(size));
+  count_window();
+  return TRUE;
+}
+
+BOOL LASreaderBIL::inside_circle(const F64 center_x, const F64 center_y, const F64 radius)
+{
+  LASreader::inside_circle(center_x, center_y, radius);
+  set_window(center_x - radius, center_y - radius, center_x + radius, center_y + radius);
+  count_window();
+  return TRUE;
+}
+
+BOOL LASreaderBIL::inside_rectangle(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y)
+{
+  LASreader::inside_rectangle(min_x, min_y, max_x, max_y);
+  set_window(min_x, min_y, max_x, max_y);
+  count_window();
+  return TRUE;
+}
+
 BOOL LASreaderBIL::seek(const I64 p_index)
 {
   return FALSE;
 }
 
-BOOL LASreaderBIL::read_point_default()
+// restricts reading to the rows and columns of the raster that overlap the given
+// area. the window is grown to whole blocks so that decimated points do not depend
+// on the query. the exact inside test is still done by LASreader on each point.
+
+void LASreaderBIL::set_window(F64 min_x, F64 min_y, F64 max_x, F64 max_y)
 {
-  F32 elevation;
-  while (p_idx < npoints)
+  F64 col_min = (min_x - ulxcenter) / xdim;
+  F64 col_max = (max_x - ulxcenter) / xdim;
+  F64 row_min = (ulycenter - max_y) / ydim;
+  F64 row_max = (ulycenter - min_y) / ydim;
+
+  win_col_min = (col_min < 0 ? 0 : (col_min > ncols ? ncols : I32_FLOOR(col_min)));
+  win_col_max = (col_max < 0 ? -1 : (col_max > ncols ? ncols-1 : I32_CEIL(col_max)));
+  win_row_min = (row_min < 0 ? 0 : (row_min > nrows ? nrows : I32_FLOOR(row_min)));
+  win_row_max = (row_max < 0 ? -1 : (row_max > nrows ? nrows-1 : I32_CEIL(row_max)));
+
+  if (win_col_max >= ncols) win_col_max = ncols - 1;
+  if (win_row_max >= nrows) win_row_max = nrows - 1;
+
+  if ((win_col_min > win_col_max) || (win_row_min > win_row_max))
+  {
+    // nothing to read
+    win_col_min = 0;
+    win_col_max = 0;
+    win_row_min = nrows;
+    win_row_max = nrows - 1;
+  }
+  else if (decimate > 1)
   {
-    if (col == ncols)
+    win_col_min -= (win_col_min % decimate);
+    win_row_min -= (win_row_min % decimate);
+    win_col_max += (decimate - 1) - (win_col_max % decimate);
+    win_row_max += (decimate - 1) - (win_row_max % decimate);
+    if (win_col_max >= ncols) win_col_max = ncols - 1;
+    if (win_row_max >= nrows) win_row_max = nrows - 1;
+  }
+
+  I32 wcols = win_col_max - win_col_min + 1;
+
+  if (pixels) free(pixels);
+  pixels = (U8*)malloc(wcols*pixel_bytes);
+  if (elevations) delete [] elevations;
+  elevations = new F32[decimate*wcols];
+
+  col = win_col_min;
+  row = win_row_min;
+  buffer_row = -1;
+}
+
+// counts the points and finds the z range of the window by reading only its rows
+// and then rewinds to the first row of the window
+
+void LASreaderBIL::count_window()
+{
+  if (file == 0)
+  {
+    return;
+  }
+
+  F64 x, y;
+  F32 elevation = 0;
+  F64 min_z = F64_MAX;
+  F64 max_z = F64_MIN;
+  I64 count = 0;
+
+  while (read_cell(&x, &y, &elevation))
+  {
+    if (max_z < elevation) max_z = elevation;
+    if (min_z > elevation) min_z = elevation;
+    count++;
+  }
+  npoints = count;
+  header.number_of_point_records = (npoints > U32_MAX ? 0 : (U32)npoints);
+  if (count)
+  {
+    header.min_z = header.get_z((I32)(header.get_Z(min_z)));
+    header.max_z = header.get_z((I32)(header.get_Z(max_z)));
+  }
+
+  col = win_col_min;
+  row = win_row_min;
+  buffer_row = -1;
+  p_idx = 0;
+  p_cnt = 0;
+}
+
+// reads up to 'decimate' rows of the window with one fread per row and converts
+// the pixels to elevations
+
+BOOL LASreaderBIL::read_rows(const I32 first_row)
+{
+  I32 wcols = win_col_max - win_col_min + 1;
+  I32 brows = ((first_row + decimate - 1) <= win_row_max ? decimate : win_row_max - first_row + 1);
+
+  for (I32 r = 0; r < brows; r++)
+  {
+    I64 offset = (static_cast<I64>(first_row + r)*ncols + win_col_min)*pixel_bytes;
+    if (offset != file_offset)
     {
-      col = 0;
-      row++;
+      if (fseek_las(file, offset, SEEK_SET))
+      {
+        LASMessage(LAS_WARNING, "seeking to row %d of %d failed. read %lld points", first_row + r, nrows, p_cnt);
+        npoints = p_idx;
+        return FALSE;
+      }
     }
+    if (fread((void*)pixels, pixel_bytes, wcols, file) != (size_t)wcols)
+    {
+      LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", first_row + r, nrows, win_col_min, ncols, p_cnt);
+      npoints = p_idx;
+      file_offset = -1;
+      return FALSE;
+    }
+    file_offset = offset + wcols*pixel_bytes;
+
+    F32* elevation = elevations + r*wcols;
+    I32 c;
 
     if (nbits == 32)
     {
       if (floatpixels)
       {
-        if (fread((void*)&elevation, 4, 1, file) != 1)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_cnt);
-          npoints = p_idx;
-          return FALSE;
-        }
+        memcpy(elevation, pixels, 4*wcols);
       }
       else
       {
-        I32 elev;
-        if (fread((void*)&elev, 4, 1, file) != 1)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_cnt);
-          npoints = p_idx;
-          return FALSE;
-        }
-        elevation = (F32)elev;
+        for (c = 0; c < wcols; c++) elevation[c] = (F32)(((I32*)pixels)[c]);
       }
     }
     else if (nbits == 16)
     {
       if (signedpixels)
       {
-        I16 elev;
-        if (fread((void*)&elev, 2, 1, file) != 1)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_cnt);
-          npoints = p_idx;
-          return FALSE;
-        }
-        elevation = (F32)elev;
+        for (c = 0; c < wcols; c++) elevation[c] = (F32)(((I16*)pixels)[c]);
       }
       else
       {
-        U16 elev;
-        if (fread((void*)&elev, 2, 1, file) != 1)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_cnt);
-          npoints = p_idx;
-          return FALSE;
-        }
-        elevation = (F32)elev;
+        for (c = 0; c < wcols; c++) elevation[c] = (F32)(((U16*)pixels)[c]);
       }
     }
     else
     {
       if (signedpixels)
       {
-        I8 rgb[4];
-        if (fread((void*)rgb, 1, nbands, file) != (U32)nbands)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_cnt);
-          npoints = p_idx;
-          return FALSE;
-        }
-        elevation = rgb[0];
+        for (c = 0; c < wcols; c++) elevation[c] = (F32)((I8)(pixels[c*nbands]));
       }
       else
       {
-        U8 rgb[4];
-        if (fread((void*)rgb, 1, nbands, file) != (U32)nbands)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_cnt);
-          npoints = p_idx;
-          return FALSE;
-        }
-        elevation = rgb[0];
+        for (c = 0; c < wcols; c++) elevation[c] = (F32)(pixels[c*nbands]);
       }
     }
+  }
+
+  buffer_row = first_row;
+  return TRUE;
+}
+
+// returns the next cell (or the average of the next non-empty block) of the window
 
-    if (elevation != nodata)
+BOOL LASreaderBIL::read_cell(F64* x, F64* y, F32* elevation)
+{
+  I32 wcols = win_col_max - win_col_min + 1;
+
+  while (row <= win_row_max)
+  {
+    if (buffer_row != row)
     {
-      F64 x = ulxcenter + col * static_cast<F64>(xdim);
-      F64 y = ulycenter - row * static_cast<F64>(ydim);
-      F64 z = elevation;
+      if (!read_rows(row))
+      {
+        return FALSE;
+      }
+    }
 
-      if (opener->is_offset_adjust() == FALSE) 
+    if (decimate == 1)
+    {
+      while (col <= win_col_max)
       {
-        // compute the quantized x, y, and z values
-        if (!point.set_x(x)) {
-          overflow_I32_x++;
+        F32 e = elevations[col - win_col_min];
+        if (e != nodata)
+        {
+          *x = ulxcenter + col * static_cast<F64>(xdim);
+          *y = ulycenter - row * static_cast<F64>(ydim);
+          *elevation = e;
+          col++;
+          return TRUE;
         }
-        if (!point.set_y(y)) {
-          overflow_I32_y++;
+        col++;
+      }
+    }
+    else
+    {
+      I32 brows = ((row + decimate - 1) <= win_row_max ? decimate : win_row_max - row + 1);
+      while (col <= win_col_max)
+      {
+        I32 bcols = ((col + decimate - 1) <= win_col_max ? decimate : win_col_max - col + 1);
+        F64 sum = 0.0;
+        I32 count = 0;
+        for (I32 r = 0; r < brows; r++)
+        {
+          const F32* e = elevations + r*wcols + (col - win_col_min);
+          for (I32 c = 0; c < bcols; c++)
+          {
+            if (e[c] != nodata)
+            {
+              sum += e[c];
+              count++;
+            }
+          }
         }
-        if (!point.set_z(z)) {
-          overflow_I32_z++;
+        I32 block_col = col;
+        col += decimate;
+        if (count)
+        {
+          *x = ulxcenter + (block_col + 0.5*(bcols - 1)) * static_cast<F64>(xdim);
+          *y = ulycenter - (row + 0.5*(brows - 1)) * static_cast<F64>(ydim);
+          *elevation = (F32)(sum / count);
+          return TRUE;
         }
-      } 
-      else 
-      {
-        I64 X = 0;
-        I64 Y = 0;
-        I64 Z = 0;
-        if (x >= orig_x_offset)
-          X = ((I64)((x / orig_x_scale_factor) + 0.5));
-        else
-          X = ((I64)((x / orig_x_scale_factor) - 0.5));
-        if (y >= orig_y_offset)
-          Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) + 0.5));
-        else
-          Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) - 0.5));
-        if (z >= orig_z_offset)
-          Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) + 0.5));
-        else
-          Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) - 0.5));
-
-        if (I32_FITS_IN_RANGE(X))
-          point.set_X(static_cast<I32>(X));
-        else
-          overflow_I32_x++;
-        if (I32_FITS_IN_RANGE(Y))
-          point.set_Y(static_cast<I32>(Y));
-        else
-          overflow_I32_y++;
-        if (I32_FITS_IN_RANGE(Z))
-          point.set_Z(static_cast<I32>(Z));
-        else
-          overflow_I32_z++;
       }
-      p_idx++;
-      p_cnt++;
-      col++;
-      return TRUE;    
     }
-    else
+    col = win_col_min;
+    row += decimate;
+  }
+  return FALSE;
+}
+
+BOOL LASreaderBIL::read_point_default()
+{
+  F64 x, y;
+  F32 elevation;
+  if ((p_idx < npoints) && read_cell(&x, &y, &elevation))
+  {
+    F64 z = elevation;
+
+    if (opener->is_offset_adjust() == FALSE) 
     {
-      col++;
+      // compute the quantized x, y, and z values
+      if (!point.set_x(x)) {
+        overflow_I32_x++;
+      }
+      if (!point.set_y(y)) {
+        overflow_I32_y++;
+      }
+      if (!point.set_z(z)) {
+        overflow_I32_z++;
+      }
+    } 
+    else 
+    {
+      I64 X = 0;
+      I64 Y = 0;
+      I64 Z = 0;
+      if (x >= orig_x_offset)
+        X = ((I64)((x / orig_x_scale_factor) + 0.5));
+      else
+        X = ((I64)((x / orig_x_scale_factor) - 0.5));
+      if (y >= orig_y_offset)
+        Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) + 0.5));
+      else
+        Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) - 0.5));
+      if (z >= orig_z_offset)
+        Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) + 0.5));
+      else
+        Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) - 0.5));
+
+      if (I32_FITS_IN_RANGE(X))
+        point.set_X(static_cast<I32>(X));
+      else
+        overflow_I32_x++;
+      if (I32_FITS_IN_RANGE(Y))
+        point.set_Y(static_cast<I32>(Y));
+      else
+        overflow_I32_y++;
+      if (I32_FITS_IN_RANGE(Z))
+        point.set_Z(static_cast<I32>(Z));
+      else
+        overflow_I32_z++;
     }
+    p_idx++;
+    p_cnt++;
+    return TRUE;    
   }
+  // the count of an unqueried raster is only an upper bound
+  npoints = p_idx;
   return FALSE;
 }
 
@@ -865,8 +966,10 @@ BOOL LASreaderBIL::reopen(const CHAR* file_name)
     LASMessage(LAS_WARNING, "setvbuf() failed with buffer size %d", 2*LAS_TOOLS_IO_IBUFFER_SIZE);
   }
 
-  col = 0;
-  row = 0;
+  col = win_col_min;
+  row = win_row_min;
+  buffer_row = -1;
+  file_offset = 0;
   p_idx = 0;
   p_cnt = 0;
 
@@ -896,6 +999,26 @@ void LASreaderBIL::clean()
   overflow_I32_x = 0;
   overflow_I32_y = 0;
   overflow_I32_z = 0;
+  win_col_min = 0;
+  win_col_max = -1;
+  win_row_min = 0;
+  win_row_max = -1;
+  raster_npoints = 0;
+  raster_min_z = 0;
+  raster_max_z = 0;
+  pixel_bytes = 0;
+  buffer_row = -1;
+  file_offset = 0;
+  if (pixels)
+  {
+    free(pixels);
+    pixels = 0;
+  }
+  if (elevations)
+  {
+    delete [] elevations;
+    elevations = 0;
+  }
 }
 
 LASreaderBIL::LASreaderBIL(LASreadOpener* opener) :LASreader(opener)
@@ -903,6 +1026,9 @@ LASreaderBIL::LASreaderBIL(LASreadOpener* opener) :LASreader(opener)
   file = 0;
   scale_factor = 0;
   offset = 0;
+  decimate = ((opener && (opener->get_raster_decimate() > 1)) ? (I32)opener->get_raster_decimate() : 1);
+  pixels = 0;
+  elevations = 0;
   orig_x_offset = 0.0;
   orig_y_offset = 0.0;
   orig_z_offset = 0.0;
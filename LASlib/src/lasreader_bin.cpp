@@ -233,6 +233,18 @@ BOOL LASreaderBIN::open(ByteStreamIn* stream)
   // initialize point
 
   point.init(&header, header.point_data_format, header.point_data_record_length);
+
+  // all records have the same size so we can read many of them at once
+
+  record_size = (version == 20020715 ? sizeof(TSpoint) : sizeof(TSrow));
+  if (point.have_gps_time) record_size += sizeof(U32);
+  if (point.have_rgb) record_size += sizeof(U32);
+  if (block) delete [] block;
+  block_records = LAS_TOOLS_IO_IBUFFER_SIZE / record_size;
+  block = new U8[block_records * record_size];
+  block_size = 1;
+  block_count = 0;
+  block_index = 0;
   
   // set point count to zero
 
@@ -267,34 +279,58 @@ BOOL LASreaderBIN::seek(const I64 p_index)
 {
   if (p_index < npoints)
   {
-    long pos = sizeof(TSheader);
-    if (version == 20020715)
-      pos += (sizeof(TSpoint)*(U32)p_index);
-    else
-      pos += (sizeof(TSrow)*(U32)p_index);
-    if (point.have_gps_time)
-      pos += (sizeof(U32)*(U32)p_index);
-    if (point.have_rgb)
-      pos += (sizeof(U32)*(U32)p_index);
     p_idx = p_index;
-    return stream->seek(pos);
+    block_size = 1;
+    block_count = 0;
+    block_index = 0;
+    return stream->seek(sizeof(TSheader) + p_index*record_size);
   }
   return FALSE;
 }
 
+// reads the next records with one call. after a seek the block starts with a single
+// record and then doubles in size so that the sparse reads used to estimate the
+// bounding box stay cheap.
+
+BOOL LASreaderBIN::read_block()
+{
+  U32 count = block_size;
+  if (count > (npoints - p_idx)) count = (U32)(npoints - p_idx);
+
+  try { stream->getBytes(block, count*record_size); } catch(...)
+  {
+    laserror("reading terrasolid point after %u of %u", (U32)p_cnt, (U32)npoints);
+    return FALSE;
+  }
+
+  block_count = count;
+  block_index = 0;
+  if (block_size < block_records)
+  {
+    block_size *= 2;
+    if (block_size > block_records) block_size = block_records;
+  }
+  return TRUE;
+}
+
 BOOL LASreaderBIN::read_point_default()
 {
   if (p_idx < npoints)
   {
+    if (block_index == block_count)
+    {
+      if (!read_block()) return FALSE;
+    }
+
+    const U8* record = block + block_index * record_size;
+    block_index++;
+
     int echo;
     if (version == 20020715)
     {
       TSpoint tspoint;
-      try { stream->getBytes((U8*)&tspoint, sizeof(TSpoint)); } catch(...)
-      {
-        laserror("reading terrasolid point after %u of %u", (U32)p_cnt, (U32)npoints);
-        return FALSE;
-      }
+      memcpy(&tspoint, record, sizeof(TSpoint));
+      record += sizeof(TSpoint);
       point.set_X(tspoint.x);
       point.set_Y(tspoint.y);
       point.set_Z(tspoint.z);
@@ -306,11 +342,8 @@ BOOL LASreaderBIN::read_point_default()
     else
     {
       TSrow tsrow;
-      try { stream->getBytes((U8*)&tsrow, sizeof(TSrow)); } catch(...)
-      {
-        laserror("reading terrasolid row after %u of %u", (U32)p_cnt, (U32)npoints);
-        return FALSE;
-      }
+      memcpy(&tsrow, record, sizeof(TSrow));
+      record += sizeof(TSrow);
       point.set_X(tsrow.x);
       point.set_Y(tsrow.y);
       point.set_Z(tsrow.z);
@@ -364,26 +397,17 @@ BOOL LASreaderBIN::read_point_default()
     if (point.have_gps_time)
     {
       U32 time;
-      try { stream->getBytes((U8*)&time, sizeof(U32)); } catch(...)
-      {
-        laserror("reading terrasolid time");
-        return FALSE;
-      }
+      memcpy(&time, record, sizeof(U32));
+      record += sizeof(U32);
       // this is gps week
       point.gps_time = 0.0002*time;
     }
 
     if (point.have_rgb)
     {
-      U8 rgba[4];
-      try { stream->getBytes((U8*)rgba, sizeof(U8)*4); } catch(...)
-      {
-        laserror("reading terrasolid color");
-        return FALSE;
-      }
-      point.rgb[0] = 256*rgba[0];
-      point.rgb[1] = 256*rgba[1];
-      point.rgb[2] = 256*rgba[2];
+      point.rgb[0] = 256*record[0];
+      point.rgb[1] = 256*record[1];
+      point.rgb[2] = 256*record[2];
     }
     p_idx++;
     p_cnt++;
@@ -419,11 +443,22 @@ LASreaderBIN::LASreaderBIN(LASreadOpener* opener):LASreader(opener)
   file = 0;
   stream = 0;
   version = 0;
+  record_size = 0;
+  block = 0;
+  block_records = 0;
+  block_size = 0;
+  block_count = 0;
+  block_index = 0;
 }
 
 LASreaderBIN::~LASreaderBIN()
 {
   if (stream) close();
+  if (block)
+  {
+    delete [] block;
+    block = 0;
+  }
 }
 
 LASreaderBINrescale::LASreaderBINrescale(LASreadOpener* opener, F64 x_scale_factor, F64 y_scale_factor, F64 z_scale_factor) : LASreaderBIN(opener)
@@ -1031,108 +1031,23 @@ BOOL LASreaderDTM::open(const CHAR* file_name)
   header.min_y = ll_y;
   header.max_x = ll_x + (ncols-1)*static_cast<F64>(xdim);
   header.max_y = ll_y + (nrows-1)*static_cast<F64>(ydim);
-  header.min_z = F64_MAX;
-  header.max_z = F64_MIN;
 
-  // init the bounding box z and count the rasters
+  // the raster is not scanned here because a query may only need a small part of it.
+  // the number of points is bounded by the number of cells (or blocks when decimating)
+  // and the z range comes from the DTM header. both are recounted for the window of
+  // an '-inside' query.
 
-  npoints = 0;
-
-  if (data_type == 2) // F32
+  if (data_type == 2 || data_type == 1) // F32 or I32
   {
-    F32 elevation = 0;
-    for (row = 0; row < nrows; row++)
-    {
-      for (col = 0; col < ncols; col++)
-      {
-        if (fread((void*)&elevation, 4, 1, file) == 1)
-        {
-          if (elevation != nodata)
-          {
-            if (header.max_z < elevation) header.max_z = elevation;
-            if (header.min_z > elevation) header.min_z = elevation;
-            npoints++;
-          }
-        }
-        else
-        {
-          col = ncols;
-          row = nrows;
-        }
-      }
-    }
-  }
-  else if (data_type == 1) // I32
-  {
-    I32 elevation = 0;
-    for (row = 0; row < nrows; row++)
-    {
-      for (col = 0; col < ncols; col++)
-      {
-        if (fread((void*)&elevation, 4, 1, file) == 1)
-        {
-          if (((F32)elevation) != nodata)
-          {
-            if (header.max_z < elevation) header.max_z = elevation;
-            if (header.min_z > elevation) header.min_z = elevation;
-            npoints++;
-          }
-        }
-        else
-        {
-          col = ncols;
-          row = nrows;
-        }
-      }
-    }
+    pixel_bytes = 4;
   }
   else if (data_type == 0) // I16
   {
-    I16 elevation;
-    for (row = 0; row < nrows; row++)
-    {
-      for (col = 0; col < ncols; col++)
-      {
-        if (fread((void*)&elevation, 2, 1, file) == 1)
-        {
-          if (((F32)elevation) != nodata)
-          {
-            if (header.max_z < elevation) header.max_z = elevation;
-            if (header.min_z > elevation) header.min_z = elevation;
-            npoints++;
-          }
-        }
-        else
-        {
-          col = ncols;
-          row = nrows;
-        }
-      }
-    }
+    pixel_bytes = 2;
   }
   else if (data_type == 3) // F64
   {
-    F64 elevation;
-    for (row = 0; row < nrows; row++)
-    {
-      for (col = 0; col < ncols; col++)
-      {
-        if (fread((void*)&elevation, 8, 1, file) == 1)
-        {
-          if (((F32)elevation) != nodata)
-          {
-            if (header.max_z < elevation) header.max_z = elevation;
-            if (header.min_z > elevation) header.min_z = elevation;
-            npoints++;
-          }
-        }
-        else
-        {
-          col = ncols;
-          row = nrows;
-        }
-      }
-    }
+    pixel_bytes = 8;
   }
   else
   {
@@ -1140,45 +1055,56 @@ BOOL LASreaderDTM::open(const CHAR* file_name)
     return FALSE;
   }
 
-  // update the header point count
+  set_window(header.min_x, header.min_y, header.max_x, header.max_y);
 
-  header.number_of_point_records = (U32)npoints;
+  raster_npoints = static_cast<I64>((ncols + decimate - 1) / decimate) * static_cast<I64>((nrows + decimate - 1) / decimate);
 
-  if (npoints)
+  if (min_z <= max_z)
   {
-    // populate scale and offset
-
-    populate_scale_and_offset();
-
-    // check bounding box for this scale and offset
-
-    populate_bounding_box();
+    raster_min_z = min_z;
+    raster_max_z = max_z;
   }
   else
   {
-    LASMessage(LAS_WARNING, "DTM raster contains only no data values");
-    header.min_z = 0;
-    header.max_z = 0;
+    LASMessage(LAS_WARNING, "DTM header has min_z %g above max_z %g. z range is unknown", min_z, max_z);
+    raster_min_z = 0;
+    raster_max_z = 0;
   }
 
-  // add the VLR for Raster LAZ
+  npoints = raster_npoints;
+  header.number_of_point_records = (npoints > U32_MAX ? 0 : (U32)npoints);
+  header.min_z = raster_min_z;
+  header.max_z = raster_max_z;
+
+  // populate scale and offset
+
+  populate_scale_and_offset();
+
+  // check bounding box for this scale and offset
 
-  LASvlrRasterLAZ vlrRasterLAZ;
-  vlrRasterLAZ.nbands = 1;
-  vlrRasterLAZ.nbits = 32;
-  vlrRasterLAZ.ncols = ncols;
-  vlrRasterLAZ.nrows = nrows;
-  vlrRasterLAZ.reserved1 = 0;
-  vlrRasterLAZ.reserved2 = 0;
-  vlrRasterLAZ.stepx = xdim;
-  vlrRasterLAZ.stepx_y = 0.0;
-  vlrRasterLAZ.stepy = ydim;
-  vlrRasterLAZ.stepy_x = 0.0;
-  vlrRasterLAZ.llx = ll_x;
-  vlrRasterLAZ.lly = ll_y;
-  vlrRasterLAZ.sigmaxy = 0.0;
+  populate_bounding_box();
 
-  header.add_vlr("Raster LAZ", 7113, (U16)vlrRasterLAZ.get_payload_size(), vlrRasterLAZ.get_payload(), FALSE, "by LAStools of rapidlasso GmbH", FALSE);
+  // add the VLR for Raster LAZ (decimated points no longer lie on the raster grid)
+
+  if (decimate == 1)
+  {
+    LASvlrRasterLAZ vlrRasterLAZ;
+    vlrRasterLAZ.nbands = 1;
+    vlrRasterLAZ.nbits = 32;
+    vlrRasterLAZ.ncols = ncols;
+    vlrRasterLAZ.nrows = nrows;
+    vlrRasterLAZ.reserved1 = 0;
+    vlrRasterLAZ.reserved2 = 0;
+    vlrRasterLAZ.stepx = xdim;
+    vlrRasterLAZ.stepx_y = 0.0;
+    vlrRasterLAZ.stepy = ydim;
+    vlrRasterLAZ.stepy_x = 0.0;
+    vlrRasterLAZ.llx = ll_x;
+    vlrRasterLAZ.lly = ll_y;
+    vlrRasterLAZ.sigmaxy = 0.0;
+
+    header.add_vlr("Raster LAZ", 7113, (U16)vlrRasterLAZ.get_payload_size(), vlrRasterLAZ.get_payload(), FALSE, "by LAStools of rapidlasso GmbH", FALSE);
+  }
 
   // reopen
 
@@ -1217,132 +1143,319 @@ void LASreaderDTM::set_offset(const F64* offset)
   }
 }
 
+void LASreaderDTM::set_decimate(const I32 decimate)
+{
+  this->decimate = (decimate > 1 ? decimate : 1);
+}
+
+BOOL LASreaderDTM::inside_none()
+{
+  LASreader::inside_none();
+  set_window(header.min_x, header.min_y, header.max_x, header.max_y);
+  npoints = raster_npoints;
+  header.number_of_point_records = (npoints > U32_MAX ? 0 : (U32)npoints);
+  header.min_z = raster_min_z;
+  header.max_z = raster_max_z;
+  return TRUE;
+}
+
+BOOL LASreaderDTM::inside_tile(const F32 ll_x, const F32 ll_y, const F32 size)
+{
+  LASreader::inside_tile(ll_x, ll_y, size);
+  set_window(ll_x, ll_y, static_cast<F64>(ll_x) + static_cast<F64>(size), static_cast<F64>(ll_y) + static_cast<F64>(size));
+  count_window();
+  return TRUE;
+}
+
+BOOL LASreaderDTM::inside_circle(const F64 center_x, const F64 center_y, const F64 radius)
+{
+  LASreader::inside_circle(center_x, center_y, radius);
+  set_window(center_x - radius, center_y - radius, center_x + radius, center_y + radius);
+  count_window();
+  return TRUE;
+}
+
+BOOL LASreaderDTM::inside_rectangle(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y)
+{
+  LASreader::inside_rectangle(min_x, min_y, max_x, max_y);
+  set_window(min_x, min_y, max_x, max_y);
+  count_window();
+  return TRUE;
+}
+
 BOOL LASreaderDTM::seek(const I64 p_index)
 {
   return FALSE;
 }
 
-BOOL LASreaderDTM::read_point_default()
+// restricts reading to the columns and rows of the raster that overlap the given
+// area. the window is grown to whole blocks so that decimated points do not depend
+// on the query. the exact inside test is still done by LASreader on each point.
+
+void LASreaderDTM::set_window(F64 min_x, F64 min_y, F64 max_x, F64 max_y)
 {
-  while (p_idx < npoints)
+  F64 col_min = (min_x - ll_x) / xdim;
+  F64 col_max = (max_x - ll_x) / xdim;
+  F64 row_min = (min_y - ll_y) / ydim;
+  F64 row_max = (max_y - ll_y) / ydim;
+
+  win_col_min = (col_min < 0 ? 0 : (col_min > ncols ? ncols : I32_FLOOR(col_min)));
+  win_col_max = (col_max < 0 ? -1 : (col_max > ncols ? ncols-1 : I32_CEIL(col_max)));
+  win_row_min = (row_min < 0 ? 0 : (row_min > nrows ? nrows : I32_FLOOR(row_min)));
+  win_row_max = (row_max < 0 ? -1 : (row_max > nrows ? nrows-1 : I32_CEIL(row_max)));
+
+  if (win_col_max >= ncols) win_col_max = ncols - 1;
+  if (win_row_max >= nrows) win_row_max = nrows - 1;
+
+  if ((win_col_min > win_col_max) || (win_row_min > win_row_max))
   {
-    if (row == nrows)
-    {
-      row = 0;
-      col++;
-    }
+    // nothing to read
+    win_col_min = ncols;
+    win_col_max = ncols - 1;
+    win_row_min = 0;
+    win_row_max = 0;
+  }
+  else if (decimate > 1)
+  {
+    win_col_min -= (win_col_min % decimate);
+    win_row_min -= (win_row_min % decimate);
+    win_col_max += (decimate - 1) - (win_col_max % decimate);
+    win_row_max += (decimate - 1) - (win_row_max % decimate);
+    if (win_col_max >= ncols) win_col_max = ncols - 1;
+    if (win_row_max >= nrows) win_row_max = nrows - 1;
+  }
 
-    F32 elevation;
+  I32 wrows = win_row_max - win_row_min + 1;
 
-    if (data_type == 2) // F32
+  if (pixels) free(pixels);
+  pixels = (U8*)malloc(wrows*pixel_bytes);
+  if (elevations) delete [] elevations;
+  elevations = new F32[decimate*wrows];
+
+  col = win_col_min;
+  row = win_row_min;
+  buffer_col = -1;
+}
+
+// counts the points and finds the z range of the window by reading only its columns
+// and then rewinds to the first column of the window
+
+void LASreaderDTM::count_window()
+{
+  if (file == 0)
+  {
+    return;
+  }
+
+  F64 x, y;
+  F32 elevation = 0;
+  F64 min_z = F64_MAX;
+  F64 max_z = F64_MIN;
+  I64 count = 0;
+
+  while (read_cell(&x, &y, &elevation))
+  {
+    if (max_z < elevation) max_z = elevation;
+    if (min_z > elevation) min_z = elevation;
+    count++;
+  }
+  npoints = count;
+  header.number_of_point_records = (npoints > U32_MAX ? 0 : (U32)npoints);
+  if (count)
+  {
+    header.min_z = header.get_z((I32)(header.get_Z(min_z)));
+    header.max_z = header.get_z((I32)(header.get_Z(max_z)));
+  }
+
+  col = win_col_min;
+  row = win_row_min;
+  buffer_col = -1;
+  p_idx = 0;
+  p_cnt = 0;
+}
+
+// reads up to 'decimate' columns (profiles) of the window with one fread per column
+// and converts the pixels to elevations
+
+BOOL LASreaderDTM::read_cols(const I32 first_col)
+{
+  I32 wrows = win_row_max - win_row_min + 1;
+  I32 bcols = ((first_col + decimate - 1) <= win_col_max ? decimate : win_col_max - first_col + 1);
+
+  for (I32 c = 0; c < bcols; c++)
+  {
+    I64 offset = 200 + (static_cast<I64>(first_col + c)*nrows + win_row_min)*pixel_bytes;
+    if (offset != file_offset)
     {
-      if (fread((void*)&elevation, 4, 1, file) != 1)
+      if (fseek_las(file, offset, SEEK_SET))
       {
-        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_cnt);
+        LASMessage(LAS_WARNING, "seeking to col %d of %d failed. read %lld points", first_col + c, ncols, p_cnt);
         npoints = p_idx;
         return FALSE;
       }
     }
+    if (fread((void*)pixels, pixel_bytes, wrows, file) != (size_t)wrows)
+    {
+      LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", win_row_min, nrows, first_col + c, ncols, p_cnt);
+      npoints = p_idx;
+      file_offset = -1;
+      return FALSE;
+    }
+    file_offset = offset + wrows*pixel_bytes;
+
+    F32* elevation = elevations + c*wrows;
+    I32 r;
+
+    if (data_type == 2) // F32
+    {
+      memcpy(elevation, pixels, 4*wrows);
+    }
     else if (data_type == 1) // I32
     {
-      I32 elev;
-      if (fread((void*)&elev, 4, 1, file) != 1)
-      {
-        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_cnt);
-        npoints = p_idx;
-        return FALSE;
-      }
-      elevation = (F32)elev;
+      for (r = 0; r < wrows; r++) elevation[r] = (F32)(((I32*)pixels)[r]);
     }
     else if (data_type == 0) // I16
     {
-      I16 elev;
-      if (fread((void*)&elev, 2, 1, file) != 1)
+      for (r = 0; r < wrows; r++) elevation[r] = (F32)(((I16*)pixels)[r]);
+    }
+    else // F64
+    {
+      for (r = 0; r < wrows; r++) elevation[r] = (F32)(((F64*)pixels)[r]);
+    }
+  }
+
+  buffer_col = first_col;
+  return TRUE;
+}
+
+// returns the next cell (or the average of the next non-empty block) of the window
+
+BOOL LASreaderDTM::read_cell(F64* x, F64* y, F32* elevation)
+{
+  I32 wrows = win_row_max - win_row_min + 1;
+
+  while (col <= win_col_max)
+  {
+    if (buffer_col != col)
+    {
+      if (!read_cols(col))
       {
-        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_cnt);
-        npoints = p_idx;
         return FALSE;
       }
-      elevation = (F32)elev;
     }
-    else if (data_type == 3) // F64
+
+    if (decimate == 1)
     {
-      F64 elev;
-      if (fread((void*)&elev, 8, 1, file) != 1)
+      while (row <= win_row_max)
       {
-        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_cnt);
-        npoints = p_idx;
-        return FALSE;
+        F32 e = elevations[row - win_row_min];
+        if (e != nodata)
+        {
+          *x = ll_x + col * static_cast<F64>(xdim);
+          *y = ll_y + row * static_cast<F64>(ydim);
+          *elevation = e;
+          row++;
+          return TRUE;
+        }
+        row++;
       }
-      elevation = (F32)elev;
     }
     else
     {
-      laserror("unknown data type %d", (I32)data_type);
-      return FALSE;
-    }
-
-    if (elevation != nodata)
-    {
-      F64 x = ll_x + col* static_cast<F64>(xdim);
-      F64 y = ll_y + row * static_cast<F64>(ydim);
-      F64 z = elevation;
-
-      if (opener->is_offset_adjust() == FALSE)
+      I32 bcols = ((col + decimate - 1) <= win_col_max ? decimate : win_col_max - col + 1);
+      while (row <= win_row_max)
       {
-        // compute the quantized x, y, and z values
-        if (!point.set_x(x)) {
-          overflow_I32_x++;
-        }
-        if (!point.set_y(y)) {
-          overflow_I32_y++;
+        I32 brows = ((row + decimate - 1) <= win_row_max ? decimate : win_row_max - row + 1);
+        F64 sum = 0.0;
+        I32 count = 0;
+        for (I32 c = 0; c < bcols; c++)
+        {
+          const F32* e = elevations + c*wrows + (row - win_row_min);
+          for (I32 r = 0; r < brows; r++)
+          {
+            if (e[r] != nodata)
+            {
+              sum += e[r];
+              count++;
+            }
+          }
         }
-        if (!point.set_z(z)) {
-          overflow_I32_z++;
+        I32 block_row = row;
+        row += decimate;
+        if (count)
+        {
+          *x = ll_x + (col + 0.5*(bcols - 1)) * static_cast<F64>(xdim);
+          *y = ll_y + (block_row + 0.5*(brows - 1)) * static_cast<F64>(ydim);
+          *elevation = (F32)(sum / count);
+          return TRUE;
         }
       }
-      else
-      {
-        I64 X = 0;
-        I64 Y = 0;
-        I64 Z = 0;
-
-        if (x >= orig_x_offset)
-          X = ((I64)((x / orig_x_scale_factor) + 0.5));
-        else
-          X = ((I64)((x / orig_x_scale_factor) - 0.5));
-        if (y >= orig_y_offset)
-          Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) + 0.5));
-        else
-          Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) - 0.5));
-        if (z >= orig_z_offset)
-          Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) + 0.5));
-        else
-          Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) - 0.5));
-
-        if (I32_FITS_IN_RANGE(X))
-          point.set_X(static_cast<I32>(X));
-        else
-          overflow_I32_x++;
-        if (I32_FITS_IN_RANGE(Y))
-          point.set_Y(static_cast<I32>(Y));
-        else
-          overflow_I32_y++;
-        if (I32_FITS_IN_RANGE(Z))
-          point.set_Z(static_cast<I32>(Z));
-        else
-          overflow_I32_z++;
+    }
+    row = win_row_min;
+    col += decimate;
+  }
+  return FALSE;
+}
+
+BOOL LASreaderDTM::read_point_default()
+{
+  F64 x, y;
+  F32 elevation;
+  if ((p_idx < npoints) && read_cell(&x, &y, &elevation))
+  {
+    F64 z = elevation;
+
+    if (opener->is_offset_adjust() == FALSE)
+    {
+      // compute the quantized x, y, and z values
+      if (!point.set_x(x)) {
+        overflow_I32_x++;
+      }
+      if (!point.set_y(y)) {
+        overflow_I32_y++;
+      }
+      if (!point.set_z(z)) {
+        overflow_I32_z++;
       }
-      p_idx++;
-      p_cnt++;
-      row++;
-      return TRUE;
     }
     else
     {
-      row++;
+      I64 X = 0;
+      I64 Y = 0;
+      I64 Z = 0;
+
+      if (x >= orig_x_offset)
+        X = ((I64)((x / orig_x_scale_factor) + 0.5));
+      else
+        X = ((I64)((x / orig_x_scale_factor) - 0.5));
+      if (y >= orig_y_offset)
+        Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) + 0.5));
+      else
+        Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) - 0.5));
+      if (z >= orig_z_offset)
+        Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) + 0.5));
+      else
+        Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) - 0.5));
+
+      if (I32_FITS_IN_RANGE(X))
+        point.set_X(static_cast<I32>(X));
+      else
+        overflow_I32_x++;
+      if (I32_FITS_IN_RANGE(Y))
+        point.set_Y(static_cast<I32>(Y));
+      else
+        overflow_I32_y++;
+      if (I32_FITS_IN_RANGE(Z))
+        point.set_Z(static_cast<I32>(Z));
+      else
+        overflow_I32_z++;
     }
+    p_idx++;
+    p_cnt++;
+    return TRUE;
   }
+  // the count of an unqueried raster is only an upper bound
+  npoints = p_idx;
   return FALSE;
 }
 
@@ -1403,8 +1516,9 @@ BOOL LASreaderDTM::reopen(const CHAR* file_name)
     LASMessage(LAS_WARNING, "setvbuf() failed with buffer size %d", 2*LAS_TOOLS_IO_IBUFFER_SIZE);
   }
 
-  col = 0;
-  row = 0;
+  col = win_col_min;
+  row = win_row_min;
+  buffer_col = -1;
   p_idx = 0;
   p_cnt = 0;
 
@@ -1414,6 +1528,7 @@ BOOL LASreaderDTM::reopen(const CHAR* file_name)
   {
     fgetc(file);
   }
+  file_offset = 200;
   return TRUE;
 }
 
@@ -1437,6 +1552,26 @@ void LASreaderDTM::clean()
   overflow_I32_x = 0;
   overflow_I32_y = 0;
   overflow_I32_z = 0;
+  win_col_min = 0;
+  win_col_max = -1;
+  win_row_min = 0;
+  win_row_max = -1;
+  raster_npoints = 0;
+  raster_min_z = 0;
+  raster_max_z = 0;
+  pixel_bytes = 0;
+  buffer_col = -1;
+  file_offset = 0;
+  if (pixels)
+  {
+    free(pixels);
+    pixels = 0;
+  }
+  if (elevations)
+  {
+    delete [] elevations;
+    elevations = 0;
+  }
 }
 
 LASreaderDTM::LASreaderDTM(LASreadOpener* opener) :LASreader(opener)
@@ -1444,6 +1579,9 @@ LASreaderDTM::LASreaderDTM(LASreadOpener* opener) :LASreader(opener)
   file = 0;
   scale_factor = 0;
   offset = 0;
+  decimate = ((opener && (opener->get_raster_decimate() > 1)) ? (I32)opener->get_raster_decimate() : 1);
+  pixels = 0;
+  elevations = 0;
   orig_x_offset = 0.0;
   orig_y_offset = 0.0;
   orig_z_offset = 0.0;
@@ -428,6 +428,13 @@ BOOL LASreaderLAS::open(ByteStreamIn* stream, BOOL peek_only, U32 decompress_sel
     }
   }
 
+  // maybe the file was written to a non-seekable stream and ends with a trailer
+
+  if (probe_stream_trailer && stream->isSeekable())
+  {
+    read_stream_trailer();
+  }
+
   npoints = (header.number_of_point_records ? header.number_of_point_records : header.extended_number_of_point_records);
   p_idx = 0;
   p_cnt = 0;
@@ -1510,11 +1517,87 @@ BOOL LASreaderLAS::open(ByteStreamIn* stream, BOOL peek_only, U32 decompress_sel
 
   if (!reader->init(stream)) return FALSE;
 
+  if (decode_threads > 1) reader->set_threads(decode_threads, npoints);
+  if (seek_cache) reader->set_seek_cache(seek_cache);
+
   checked_end = FALSE;
 
   return TRUE;
 }
 
+BOOL LASreaderLAS::read_stream_trailer()
+{
+  LASvlr_stream_trailer trailer;
+  I64 here = stream->tell();
+  try
+  {
+    if (!stream->seekEnd(60 + LAS_TOOLS_STREAM_TRAILER_PAYLOAD)) throw 1;
+    U16 reserved;
+    stream->get16bitsLE((U8*)&reserved);
+    CHAR user_id[16];
+    stream->getBytes((U8*)user_id, 16);
+    U16 record_id;
+    stream->get16bitsLE((U8*)&record_id);
+    I64 record_length_after_header;
+    stream->get64bitsLE((U8*)&record_length_after_header);
+    if ((strncmp(user_id, "LAStools", 16) != 0) || (record_id != LAS_TOOLS_STREAM_TRAILER_RECORD_ID) || (record_length_after_header != LAS_TOOLS_STREAM_TRAILER_PAYLOAD)) throw 1;
+    CHAR description[32];
+    stream->getBytes((U8*)description, 32);
+    stream->get64bitsLE((U8*)&(trailer.number_of_point_records));
+    U32 i;
+    for (i = 0; i < 15; i++)
+    {
+      stream->get64bitsLE((U8*)&(trailer.number_of_points_by_return[i]));
+    }
+    stream->get64bitsLE((U8*)&(trailer.max_x));
+    stream->get64bitsLE((U8*)&(trailer.min_x));
+    stream->get64bitsLE((U8*)&(trailer.max_y));
+    stream->get64bitsLE((U8*)&(trailer.min_y));
+    stream->get64bitsLE((U8*)&(trailer.max_z));
+    stream->get64bitsLE((U8*)&(trailer.min_z));
+    stream->get64bitsLE((U8*)&(trailer.max_gps_time));
+    stream->get64bitsLE((U8*)&(trailer.min_gps_time));
+    stream->get64bitsLE((U8*)&(trailer.start_of_first_extended_variable_length_record));
+    stream->get32bitsLE((U8*)&(trailer.number_of_extended_variable_length_records));
+  }
+  catch(...)
+  {
+    stream->seek(here);
+    return FALSE;
+  }
+  stream->seek(here);
+
+  // the legacy counters stay zero where they cannot hold the values
+
+  U32 i;
+  BOOL legacy = (((header.point_data_format & 63) <= 5) && (trailer.number_of_point_records <= U32_MAX));
+  header.number_of_point_records = (legacy ? (U32)trailer.number_of_point_records : 0);
+  header.extended_number_of_point_records = trailer.number_of_point_records;
+  for (i = 0; i < 15; i++)
+  {
+    if (i < 5) header.number_of_points_by_return[i] = (legacy && (trailer.number_of_points_by_return[i] <= U32_MAX) ? (U32)trailer.number_of_points_by_return[i] : 0);
+    header.extended_number_of_points_by_return[i] = trailer.number_of_points_by_return[i];
+  }
+  header.max_x = trailer.max_x;
+  header.min_x = trailer.min_x;
+  header.max_y = trailer.max_y;
+  header.min_y = trailer.min_y;
+  header.max_z = trailer.max_z;
+  header.min_z = trailer.min_z;
+  if ((header.version_major == 1) && (header.version_minor >= 5))
+  {
+    header.max_gps_time = trailer.max_gps_time;
+    header.min_gps_time = trailer.min_gps_time;
+  }
+  if ((header.version_major == 1) && (header.version_minor >= 4))
+  {
+    header.start_of_first_extended_variable_length_record = trailer.start_of_first_extended_variable_length_record;
+    header.number_of_extended_variable_length_records = trailer.number_of_extended_variable_length_records;
+  }
+  LASMessage(LAS_VERBOSE, "header values of %lld points from trailer of streamed output", trailer.number_of_point_records);
+  return TRUE;
+}
+
 I32 LASreaderLAS::get_format() const
 {
   if (header.laszip)
@@ -1651,6 +1734,9 @@ LASreaderLAS::LASreaderLAS(LASreadOpener* opener) : LASreader(opener)
   delete_stream = TRUE;
   reader = 0;
   keep_copc = FALSE;
+  decode_threads = 1;
+  seek_cache = 0;
+  probe_stream_trailer = TRUE;
   checked_end = FALSE;
 }
 
@@ -644,7 +644,15 @@ BOOL LASreaderPLY::read_point_default()
     {
       if (streamin) // binary
       {
-        read_binary_point();
+        if (!read_binary_point() && (p_idx == npoints))
+        {
+          // truncated file
+          if (!populated_header)
+          {
+            populate_bounding_box();
+          }
+          return FALSE;
+        }
       }
       else // ascii
       {
@@ -834,6 +842,15 @@ void LASreaderPLY::clean()
     free(type_string);
     type_string = 0;
   }
+  if (binary_buffer)
+  {
+    free(binary_buffer);
+    binary_buffer = 0;
+  }
+  binary_record_size = 0;
+  binary_buffer_records = 0;
+  binary_buffer_count = 0;
+  binary_buffer_index = 0;
   populated_header = FALSE;
 }
 
@@ -845,6 +862,7 @@ LASreaderPLY::LASreaderPLY(LASreadOpener* opener) :LASreader(opener)
   point_type = 0;
   parse_string = 0;
   type_string = 0;
+  binary_buffer = 0;
   scale_factor = 0;
   offset = 0;
   translate_intensity = 0.0f;
@@ -1090,16 +1108,114 @@ F64 LASreaderPLY::read_binary_value(CHAR type)
   return value;
 }
 
+static inline U32 get_binary_size(CHAR type)
+{
+  if (type == 'd') return 8;
+  if ((type == 'f') || (type == 'I') || (type == 'i')) return 4;
+  if ((type == 'S') || (type == 's')) return 2;
+  return 1;
+}
+
+static inline F64 get_binary_value(const U8* bytes, CHAR type)
+{
+  if (type == 'f')
+  {
+    F32 temp_f32;
+    memcpy(&temp_f32, bytes, 4);
+    return (F64)temp_f32;
+  }
+  else if (type == 'd')
+  {
+    F64 temp_f64;
+    memcpy(&temp_f64, bytes, 8);
+    return temp_f64;
+  }
+  else if (type == 'C')
+  {
+    return (F64)bytes[0];
+  }
+  else if (type == 'c')
+  {
+    return (F64)((I8)bytes[0]);
+  }
+  else if (type == 'I')
+  {
+    U32 temp_u32;
+    memcpy(&temp_u32, bytes, 4);
+    return (F64)temp_u32;
+  }
+  else if (type == 'i')
+  {
+    I32 temp_i32;
+    memcpy(&temp_i32, bytes, 4);
+    return (F64)temp_i32;
+  }
+  else if (type == 'S')
+  {
+    U16 temp_u16;
+    memcpy(&temp_u16, bytes, 2);
+    return (F64)temp_u16;
+  }
+  else if (type == 's')
+  {
+    I16 temp_i16;
+    memcpy(&temp_i16, bytes, 2);
+    return (F64)temp_i16;
+  }
+  return 0;
+}
+
+BOOL LASreaderPLY::read_binary_block()
+{
+  binary_buffer_index = 0;
+  binary_buffer_count = (U32)fread(binary_buffer, binary_record_size, binary_buffer_records, file);
+  return (binary_buffer_count > 0);
+}
+
 BOOL LASreaderPLY::read_binary_point()
 {
   const CHAR* p = parse_string;
   const CHAR* t = type_string;
+  const U8* record = 0;
 
   F64 value;
 
+  if (binary_record_size)
+  {
+    // fetch the next fixed-size vertex record from the block buffer
+    if (binary_buffer_index == binary_buffer_count)
+    {
+      if (!read_binary_block())
+      {
+        LASMessage(LAS_WARNING, "end-of-file after %lld of %lld points", p_cnt, npoints);
+        npoints = p_idx;
+        return FALSE;
+      }
+    }
+    record = binary_buffer + (size_t)binary_buffer_index*binary_record_size;
+    binary_buffer_index++;
+
+    // the coordinates come first in most files
+    if ((p[0] == 'x') && (p[1] == 'y') && (p[2] == 'z'))
+    {
+      point.coordinates[0] = get_binary_value(record + binary_offsets[0], t[0]);
+      point.coordinates[1] = get_binary_value(record + binary_offsets[1], t[1]);
+      point.coordinates[2] = get_binary_value(record + binary_offsets[2], t[2]);
+      p += 3;
+      t += 3;
+    }
+  }
+
   while (p[0])
   {
-    value = read_binary_value(t[0]);
+    if (record)
+    {
+      value = get_binary_value(record + binary_offsets[t - type_string], t[0]);
+    }
+    else
+    {
+      value = read_binary_value(t[0]);
+    }
     if (p[0] == 'x') // we expect the x coordinate
     {
       point.coordinates[0] = value;
@@ -1539,6 +1655,7 @@ BOOL LASreaderPLY::parse(const char* parse_string)
 BOOL LASreaderPLY::parse_header()
 {
   BOOL skip_remaining = FALSE;
+  BOOL little_endian = FALSE;
   CHAR line[512];
   U32 items = 0;
   U32 offset = 0;
@@ -1579,6 +1696,7 @@ BOOL LASreaderPLY::parse_header()
       if (strncmp(&line[7], "binary_little_endian", 20) == 0)
       {
         streamin = new ByteStreamInFileLE(file);
+        little_endian = TRUE;
       }
       else if (strncmp(&line[7], "binary_big_endian", 18) == 0)
       {
@@ -1849,6 +1967,37 @@ BOOL LASreaderPLY::parse_header()
     LASMessage(LAS_VERBOSE, "parsed: %s", line);
   }
 
+  // vertices of little endian binary files are fixed-size records that we read in large blocks
+
+  binary_record_size = 0;
+  binary_buffer_count = 0;
+  binary_buffer_index = 0;
+
+  if (streamin && little_endian && Endian::IS_LITTLE_ENDIAN)
+  {
+    for (U32 i = 0; i < items; i++)
+    {
+      binary_offsets[i] = binary_record_size;
+      binary_record_size += get_binary_size(type_string[i]);
+    }
+    if (binary_record_size)
+    {
+      U32 records = (LAS_TOOLS_IO_IBUFFER_SIZE * 16) / binary_record_size;
+      if (records == 0) records = 1;
+      if (binary_buffer_records != records)
+      {
+        if (binary_buffer) free(binary_buffer);
+        binary_buffer_records = records;
+        binary_buffer = (U8*)malloc((size_t)binary_record_size*binary_buffer_records);
+      }
+      if (binary_buffer == 0)
+      {
+        laserror("allocating buffer for %u PLY vertices of %u bytes", binary_buffer_records, binary_record_size);
+        return FALSE;
+      }
+    }
+  }
+
   return TRUE;
 }
 
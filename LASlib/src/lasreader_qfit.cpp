@@ -177,6 +177,15 @@ BOOL LASreaderQFIT::open(ByteStreamIn* stream)
     return FALSE;
   }
 
+  // allocate the block of records that are read at once
+
+  if (block) delete [] block;
+  block_records = LAS_TOOLS_IO_IBUFFER_SIZE / version;
+  block = new I32[block_records * (version / 4)];
+  block_size = 1;
+  block_count = 0;
+  block_index = 0;
+
   // seek to end of file find out number of points
 
   stream->seekEnd();
@@ -298,57 +307,75 @@ BOOL LASreaderQFIT::seek(const I64 p_index)
   if (p_index < npoints)
   {
     p_idx = p_index;
+    block_size = 1;
+    block_count = 0;
+    block_index = 0;
     return stream->seek(p_index*version+offset);
   }
   return FALSE;
 }
 
-BOOL LASreaderQFIT::read_point_default()
+// reads the next records with one call and swaps all their 32 bit words at once if
+// needed. after a seek the block starts with a single record and then doubles in size
+// so that the sparse reads used to estimate the bounding box stay cheap.
+
+BOOL LASreaderQFIT::read_block()
 {
-  if (p_idx < npoints)
+  U32 count = block_size;
+  if (count > (npoints - p_idx)) count = (U32)(npoints - p_idx);
+
+  try { stream->getBytes((U8*)block, count*version); } catch(...)
+  {
+    laserror("reading QFIT point after %u of %u", (U32)p_cnt, (U32)npoints);
+    return FALSE;
+  }
+
+  if (endian_swap)
   {
-    try { stream->getBytes((U8*)buffer, version); } catch(...)
+    U32 i;
+    U32 words = count * (version / 4);
+    U32* word = (U32*)block;
+    for (i = 0; i < words; i++)
     {
-      laserror("reading QFIT point after %u of %u", (U32)p_cnt, (U32)npoints);
-      return FALSE;
+      word[i] = (word[i] >> 24) | ((word[i] >> 8) & 0x0000FF00) | ((word[i] << 8) & 0x00FF0000) | (word[i] << 24);
     }
+  }
+
+  block_count = count;
+  block_index = 0;
+  if (block_size < block_records)
+  {
+    block_size *= 2;
+    if (block_size > block_records) block_size = block_records;
+  }
+  return TRUE;
+}
 
-    if (endian_swap)
+BOOL LASreaderQFIT::read_point_default()
+{
+  if (p_idx < npoints)
+  {
+    if (block_index == block_count)
     {
-      ENDIAN_SWAP_32_((U8*)&buffer[0]);
-      ENDIAN_SWAP_32_((U8*)&buffer[1]);
-      ENDIAN_SWAP_32_((U8*)&buffer[2]);
-      ENDIAN_SWAP_32_((U8*)&buffer[3]);
-      ENDIAN_SWAP_32_((U8*)&buffer[5]);
-      ENDIAN_SWAP_32_((U8*)&buffer[6]);
-      ENDIAN_SWAP_32_((U8*)&buffer[7]);
-      ENDIAN_SWAP_32_((U8*)&buffer[8]);
-      ENDIAN_SWAP_32_((U8*)&buffer[9]);
-      if (version >= 48)
-      {
-        ENDIAN_SWAP_32_((U8*)&buffer[10]);
-        ENDIAN_SWAP_32_((U8*)&buffer[11]);
-      }
-      if (version >= 56)
-      {
-        ENDIAN_SWAP_32_((U8*)&buffer[12]);
-        ENDIAN_SWAP_32_((U8*)&buffer[13]);
-      }
+      if (!read_block()) return FALSE;
     }
 
-    point.gps_time = 0.001*buffer[0];
-    point.set_X(buffer[2]);
+    const I32* record = block + block_index * (version / 4);
+    block_index++;
+
+    point.gps_time = 0.001*record[0];
+    point.set_X(record[2]);
     if (point.get_X() > 180000000) point.set_X(point.get_X() - 360000000); //  convert LARGE positive east longitude to negative
-    point.set_Y(buffer[1]);
-    point.set_Z(buffer[3]);
-    point.intensity = buffer[5];
-    point.set_scan_angle(0.001f*buffer[6]-180.0f);
-    point.set_attribute(scan_azimuth_start, (I32)buffer[6]);
-    point.set_attribute(pitch_start, (I32)buffer[7]);
-    point.set_attribute(roll_start, (I32)buffer[8]);
+    point.set_Y(record[1]);
+    point.set_Z(record[3]);
+    point.intensity = record[5];
+    point.set_scan_angle(0.001f*record[6]-180.0f);
+    point.set_attribute(scan_azimuth_start, (I32)record[6]);
+    point.set_attribute(pitch_start, (I32)record[7]);
+    point.set_attribute(roll_start, (I32)record[8]);
     if (version == 48)
     {
-      point.set_attribute(pulse_width_start, (U8)buffer[10]);
+      point.set_attribute(pulse_width_start, (U8)record[10]);
     }
 
     if (!populated_header)
@@ -425,6 +452,9 @@ BOOL LASreaderQFIT::reopen(const char* file_name)
   else
     stream = new ByteStreamInFileBE(file);
 
+  block_size = 1;
+  block_count = 0;
+  block_index = 0;
   p_idx = 0;
   p_cnt = 0;
   return stream->seek(offset);
@@ -438,6 +468,11 @@ LASreaderQFIT::LASreaderQFIT(LASreadOpener* opener) :LASreader(opener)
   little_endian = TRUE;
   endian_swap = FALSE;
   offset = 0;
+  block = 0;
+  block_records = 0;
+  block_size = 0;
+  block_count = 0;
+  block_index = 0;
   populated_header = FALSE;
   scan_azimuth_start = -1;
   pitch_start = -1;
@@ -454,6 +489,11 @@ LASreaderQFIT::LASreaderQFIT(LASreadOpener* opener) :LASreader(opener)
 LASreaderQFIT::~LASreaderQFIT()
 {
   if (stream) close();
+  if (block)
+  {
+    delete [] block;
+    block = 0;
+  }
 }
 
 LASreaderQFITrescale::LASreaderQFITrescale(LASreadOpener* opener, F64 x_scale_factor, F64 y_scale_factor, F64 z_scale_factor) : LASreaderQFIT(opener)
@@ -92,6 +92,22 @@ static void from_little_endian(double* value)
   }
 }
 
+static I32 get_little_endian_int(const U8* bytes)
+{
+  int value;
+  memcpy(&value, bytes, sizeof(int));
+  from_little_endian(&value);
+  return value;
+}
+
+static F64 get_little_endian_double(const U8* bytes)
+{
+  double value;
+  memcpy(&value, bytes, sizeof(double));
+  from_little_endian(&value);
+  return value;
+}
+
 BOOL LASreaderSHP::open(const char* file_name)
 {
   if (file_name == 0)
@@ -225,6 +241,14 @@ BOOL LASreaderSHP::open(const char* file_name)
   {
     npoints = (file_length-50-28)/(12); // over-estimate (assumes all in one record)
   }
+
+  // for multipoints the '.shx' index gives us the record offsets and exact counts
+
+  if ((shape_type == 8 || shape_type == 18 || shape_type == 28) && !piped)
+  {
+    read_shx(file_name);
+  }
+
   header.number_of_point_records = (U32)npoints;
   header.number_of_points_by_return[0] = (U32)npoints;
 
@@ -236,6 +260,8 @@ BOOL LASreaderSHP::open(const char* file_name)
 
   populate_bounding_box();
   
+  record_idx = 0;
+  record_position = 100;
   p_idx = 0;
   p_cnt = 0;
   return TRUE;
@@ -273,6 +299,46 @@ void LASreaderSHP::set_offset(const F64* offset)
   }
 }
 
+BOOL LASreaderSHP::inside_none()
+{
+  LASreader::inside_none();
+  record_filter = FALSE;
+  return TRUE;
+}
+
+BOOL LASreaderSHP::inside_tile(const F32 ll_x, const F32 ll_y, const F32 size)
+{
+  LASreader::inside_tile(ll_x, ll_y, size);
+  record_filter = TRUE;
+  record_min_x = ll_x;
+  record_min_y = ll_y;
+  record_max_x = static_cast<F64>(ll_x) + static_cast<F64>(size);
+  record_max_y = static_cast<F64>(ll_y) + static_cast<F64>(size);
+  return TRUE;
+}
+
+BOOL LASreaderSHP::inside_circle(const F64 center_x, const F64 center_y, const F64 radius)
+{
+  LASreader::inside_circle(center_x, center_y, radius);
+  record_filter = TRUE;
+  record_min_x = center_x - radius;
+  record_min_y = center_y - radius;
+  record_max_x = center_x + radius;
+  record_max_y = center_y + radius;
+  return TRUE;
+}
+
+BOOL LASreaderSHP::inside_rectangle(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y)
+{
+  LASreader::inside_rectangle(min_x, min_y, max_x, max_y);
+  record_filter = TRUE;
+  record_min_x = min_x;
+  record_min_y = min_y;
+  record_max_x = max_x;
+  record_max_y = max_y;
+  return TRUE;
+}
+
 BOOL LASreaderSHP::seek(const I64 p_index)
 {
   return FALSE;
@@ -280,133 +346,9 @@ BOOL LASreaderSHP::seek(const I64 p_index)
 
 BOOL LASreaderSHP::read_point_default()
 {
-  if (point_count == number_of_points)
+  while (point_count == number_of_points)
   {
-    int i, int_input;
-    if (fread(&int_input, sizeof(int), 1, file) != 1) { npoints = p_idx; return FALSE; }; // record number (BIG)
-    if (fread(&int_input, sizeof(int), 1, file) != 1) { npoints = p_idx; return FALSE; }; // content length (BIG)
-    if (fread(&int_input, sizeof(int), 1, file) != 1) { npoints = p_idx; return FALSE; }; // shape type (LITTLE)
-    from_little_endian(&int_input);
-    if (int_input != shape_type)
-    {
-      LASMessage(LAS_WARNING, "wrong shape type %d != %d in record", int_input, shape_type);
-    }
-    double double_input;
-    if (shape_type == 8 || shape_type == 18 || shape_type == 28) // Multipoint
-    {
-      if (fread(&double_input, sizeof(double), 1, file) != 1) { npoints = p_idx; return FALSE; }; // xmin (LITTLE)
-      if (fread(&double_input, sizeof(double), 1, file) != 1) { npoints = p_idx; return FALSE; }; // ymin (LITTLE)
-      if (fread(&double_input, sizeof(double), 1, file) != 1) { npoints = p_idx; return FALSE; }; // xmax (LITTLE)
-      if (fread(&double_input, sizeof(double), 1, file) != 1) { npoints = p_idx; return FALSE; }; // ymax (LITTLE)
-      if (fread(&int_input, sizeof(int), 1, file) != 1) { npoints = p_idx; return FALSE; }; // number of points (LITTLE)
-      from_little_endian(&int_input);
-      if ((int_input < 0) || (int_input > (I32_MAX / 3))) { npoints = p_idx; return FALSE; }
-      number_of_points = int_input;
-    }
-    else // or regular point?
-    {
-      number_of_points = 1;
-    }
-    if (shape_type == 11 || shape_type == 18)
-    {
-      if (points_allocated < number_of_points)
-      {
-        if (points) delete [] points;
-        points = new I32[number_of_points*3];
-        points_allocated = number_of_points;
-      }
-      // read points x and y
-      for (i = 0; i < number_of_points; i++)
-      {
-        if (fread(&double_input, sizeof(double), 1, file) != 1) { npoints = p_idx; return FALSE; }; // x of point (LITTLE)
-        from_little_endian(&double_input);
-        if (opener->is_offset_adjust() == FALSE) 
-        {
-          points[3*i+0] = (I32)header.get_X(double_input);
-        } else {
-          if (double_input >= orig_x_offset) 
-            points[3 * i + 0] = (I32)(((double_input - orig_x_offset) / orig_x_scale_factor) + 0.5);
-          else 
-            points[3 * i + 0] = (I32)(((double_input - orig_x_offset) / orig_x_scale_factor) - 0.5);
-        }
-        if (fread(&double_input, sizeof(double), 1, file) != 1) { npoints = p_idx; return FALSE; }; // y of point (LITTLE)
-        from_little_endian(&double_input);
-        if (opener->is_offset_adjust() == FALSE) {
-          points[3 * i + 1] = (I32)header.get_Y(double_input);
-        } else {
-          if (double_input >= orig_y_offset)
-            points[3 * i + 1] = (I32)(((double_input - orig_y_offset) / orig_y_scale_factor) + 0.5);
-          else
-            points[3 * i + 1] = (I32)(((double_input - orig_y_offset) / orig_y_scale_factor) - 0.5);
-        }
-      }
-      // read points z and write LAS points
-      if (shape_type == 18) // Multipoint
-      {
-        if (fread(&double_input, sizeof(double), 1, file) != 1) { npoints = p_idx; return FALSE; }; // zmin (LITTLE)
-        if (fread(&double_input, sizeof(double), 1, file) != 1) { npoints = p_idx; return FALSE; }; // zmin (LITTLE)
-      }
-      for (i = 0; i < number_of_points; i++)
-      {
-        if (fread(&double_input, sizeof(double), 1, file) != 1) { npoints = p_idx; return FALSE; }; // z of point (LITTLE)
-        from_little_endian(&double_input);
-        if (opener->is_offset_adjust() == FALSE) {
-          points[3 * i + 2] = (I32)header.get_Z(double_input);
-        } else {
-          if (double_input >= orig_z_offset)
-            points[3 * i + 2] = (I32)(((double_input - orig_z_offset) / orig_z_scale_factor) + 0.5);
-          else
-            points[3 * i + 2] = (I32)(((double_input - orig_z_offset) / orig_z_scale_factor) - 0.5);
-        }
-      }
-    }
-    else
-    {
-      if (points_allocated < number_of_points)
-      {
-        if (points) delete [] points;
-        points = new I32[number_of_points*2];
-        points_allocated = number_of_points;
-      }
-      // read points x and y and write LAS points
-      for (i = 0; i < number_of_points; i++)
-      {
-        if (fread(&double_input, sizeof(double), 1, file) != 1) { npoints = p_idx; return FALSE; }; // x of point (LITTLE)
-        from_little_endian(&double_input);
-        if (opener->is_offset_adjust() == FALSE) {
-          points[2 * i + 0] = (I32)header.get_X(double_input);
-        } else {
-          if (double_input >= orig_x_offset)
-            points[2 * i + 0] = (I32)(((double_input - orig_x_offset) / orig_x_scale_factor) + 0.5);
-          else
-            points[2 * i + 0] = (I32)(((double_input - orig_x_offset) / orig_x_scale_factor) - 0.5);
-        }
-        if (fread(&double_input, sizeof(double), 1, file) != 1) { npoints = p_idx; return FALSE; }; // y of point (LITTLE)
-        from_little_endian(&double_input);
-        if (opener->is_offset_adjust() == FALSE) {
-          points[2 * i + 1] = (I32)header.get_Y(double_input);
-        } else {
-          if (double_input >= orig_y_offset)
-            points[2 * i + 1] = (I32)(((double_input - orig_y_offset) / orig_y_scale_factor) + 0.5);
-          else
-            points[2 * i + 1] = (I32)(((double_input - orig_y_offset) / orig_y_scale_factor) - 0.5);
-        }
-      }
-    }
-    // read points m
-    if (shape_type == 11 || shape_type == 21 || shape_type == 18 || shape_type == 28)
-    {
-      if (shape_type == 18 || shape_type == 28) // Multipoint
-      {
-        if (fread(&double_input, sizeof(double), 1, file) != 1) { npoints = p_idx; return FALSE; }; // mmin (LITTLE)
-        if (fread(&double_input, sizeof(double), 1, file) != 1) { npoints = p_idx; return FALSE; }; // mmin (LITTLE)
-      }
-      for (i = 0; i < number_of_points; i++)
-      {
-        if (fread(&double_input, sizeof(double), 1, file) != 1) { npoints = p_idx; return FALSE; }; // m of point (LITTLE)
-      }
-    }
-    point_count = 0;
+    if (!read_record()) { npoints = p_idx; return FALSE; }
   }
   if (shape_type == 11 || shape_type == 18)
   {
@@ -447,6 +389,280 @@ BOOL LASreaderSHP::read_point_default()
   return TRUE;
 }
 
+// reads the next record with a single fread into the record buffer and then decodes
+// all its coordinates in one go. when an area of interest is set, records whose
+// bounding box does not overlap it are skipped. for multipoints only the first 40
+// bytes are read in that case and the rest of the record is skipped with a seek.
+
+BOOL LASreaderSHP::read_record()
+{
+  if (shx_records)
+  {
+    if (record_idx >= number_of_records) return FALSE;
+    I64 offset = 2 * (I64)shx_records[2 * record_idx];
+    if (offset != record_position)
+    {
+      if (fseek_las(file, offset, SEEK_SET)) return FALSE;
+      record_position = offset;
+    }
+  }
+  int int_input[2];
+  if (fread(int_input, sizeof(int), 2, file) != 2) return FALSE; // record number and content length (BIG)
+  from_big_endian(&int_input[1]);
+  if ((int_input[1] < 2) || (int_input[1] > (I32_MAX / 2)))
+  {
+    LASMessage(LAS_WARNING, "corrupt content length %d of record %d", int_input[1], record_idx);
+    return FALSE;
+  }
+  I32 content_length = 2 * int_input[1];
+  record_position += 8;
+  record_idx++;
+
+  BOOL multipoint = (shape_type == 8 || shape_type == 18 || shape_type == 28);
+  I32 bytes = content_length;
+  if (record_filter && multipoint && !piped && (content_length >= 40)) bytes = 40;
+
+  if (record_buffer_allocated < content_length)
+  {
+    if (record_buffer) delete [] record_buffer;
+    record_buffer = new U8[content_length];
+    record_buffer_allocated = content_length;
+  }
+  if (fread(record_buffer, 1, bytes, file) != (size_t)bytes) return FALSE;
+  record_position += bytes;
+
+  number_of_points = 0;
+  point_count = 0;
+
+  I32 type = get_little_endian_int(record_buffer);
+  if (type == 0) // null shape
+  {
+    if (bytes < content_length)
+    {
+      record_position += (content_length - bytes);
+      if (fseek_las(file, record_position, SEEK_SET)) return FALSE;
+    }
+    return TRUE;
+  }
+  if (type != shape_type)
+  {
+    LASMessage(LAS_WARNING, "wrong shape type %d != %d in record", type, shape_type);
+  }
+
+  I32 n;
+  if (multipoint)
+  {
+    if (content_length < 40) return FALSE;
+    n = get_little_endian_int(record_buffer + 36);
+    if ((n < 0) || (n > (I32_MAX / 32))) return FALSE;
+    if (record_filter)
+    {
+      if ((get_little_endian_double(record_buffer +  4) > record_max_x) || (get_little_endian_double(record_buffer + 12) > record_max_y) ||
+          (get_little_endian_double(record_buffer + 20) < record_min_x) || (get_little_endian_double(record_buffer + 28) < record_min_y))
+      {
+        if (bytes < content_length)
+        {
+          record_position += (content_length - bytes);
+          if (fseek_las(file, record_position, SEEK_SET)) return FALSE;
+        }
+        p_idx += n;
+        return TRUE;
+      }
+    }
+    if (content_length < (40 + 16 * n + (shape_type == 18 ? 16 + 8 * n : 0)))
+    {
+      LASMessage(LAS_WARNING, "record %d with %d points is too short (%d bytes)", record_idx - 1, n, content_length);
+      return FALSE;
+    }
+    if (bytes < content_length)
+    {
+      if (fread(record_buffer + bytes, 1, content_length - bytes, file) != (size_t)(content_length - bytes)) return FALSE;
+      record_position += (content_length - bytes);
+    }
+  }
+  else
+  {
+    n = 1;
+    if (content_length < (shape_type == 11 ? 28 : 20)) return FALSE;
+    if (record_filter)
+    {
+      F64 x = get_little_endian_double(record_buffer + 4);
+      F64 y = get_little_endian_double(record_buffer + 12);
+      if ((x < record_min_x) || (x > record_max_x) || (y < record_min_y) || (y > record_max_y))
+      {
+        p_idx++;
+        return TRUE;
+      }
+    }
+  }
+
+  I32 stride = ((shape_type == 11 || shape_type == 18) ? 3 : 2);
+  if (points_allocated < n)
+  {
+    if (points) delete [] points;
+    points = new I32[n * stride];
+    points_allocated = n;
+  }
+
+  if (multipoint)
+  {
+    decode_xy(record_buffer + 40, n, points, stride);
+    if (shape_type == 18) decode_z(record_buffer + 40 + 16 * n + 16, n, points + 2, stride);
+  }
+  else
+  {
+    decode_xy(record_buffer + 4, 1, points, stride);
+    if (shape_type == 11) decode_z(record_buffer + 20, 1, points + 2, stride);
+  }
+  number_of_points = n;
+  return TRUE;
+}
+
+void LASreaderSHP::decode_xy(const U8* xy, I32 count, I32* dest, I32 stride)
+{
+  I32 i;
+  F64 x, y;
+  if (opener->is_offset_adjust() == FALSE)
+  {
+    for (i = 0; i < count; i++, xy += 16, dest += stride)
+    {
+      dest[0] = (I32)header.get_X(get_little_endian_double(xy));
+      dest[1] = (I32)header.get_Y(get_little_endian_double(xy + 8));
+    }
+  }
+  else
+  {
+    for (i = 0; i < count; i++, xy += 16, dest += stride)
+    {
+      x = get_little_endian_double(xy);
+      y = get_little_endian_double(xy + 8);
+      if (x >= orig_x_offset)
+        dest[0] = (I32)(((x - orig_x_offset) / orig_x_scale_factor) + 0.5);
+      else
+        dest[0] = (I32)(((x - orig_x_offset) / orig_x_scale_factor) - 0.5);
+      if (y >= orig_y_offset)
+        dest[1] = (I32)(((y - orig_y_offset) / orig_y_scale_factor) + 0.5);
+      else
+        dest[1] = (I32)(((y - orig_y_offset) / orig_y_scale_factor) - 0.5);
+    }
+  }
+}
+
+void LASreaderSHP::decode_z(const U8* z, I32 count, I32* dest, I32 stride)
+{
+  I32 i;
+  F64 value;
+  if (opener->is_offset_adjust() == FALSE)
+  {
+    for (i = 0; i < count; i++, z += 8, dest += stride)
+    {
+      dest[0] = (I32)header.get_Z(get_little_endian_double(z));
+    }
+  }
+  else
+  {
+    for (i = 0; i < count; i++, z += 8, dest += stride)
+    {
+      value = get_little_endian_double(z);
+      if (value >= orig_z_offset)
+        dest[0] = (I32)(((value - orig_z_offset) / orig_z_scale_factor) + 0.5);
+      else
+        dest[0] = (I32)(((value - orig_z_offset) / orig_z_scale_factor) - 0.5);
+    }
+  }
+}
+
+// the '.shx' file next to a '.shp' file lists offset and content length of every
+// record (both in 16-bit words). we keep the table to find the records and use
+// the content lengths to count the points exactly instead of over-estimating.
+
+BOOL LASreaderSHP::read_shx(const char* file_name)
+{
+  size_t len = strlen(file_name);
+  if ((len < 4) || (file_name[len-4] != '.') || ((file_name[len-1] != 'p') && (file_name[len-1] != 'P')))
+  {
+    return FALSE;
+  }
+  CHAR* file_name_shx = LASCopyString(file_name);
+  file_name_shx[len-1] = (file_name[len-1] == 'p' ? 'x' : 'X');
+  FILE* file_shx = fopen(file_name_shx, "rb");
+  free(file_name_shx);
+  if (file_shx == 0)
+  {
+    return FALSE;
+  }
+  int int_input[25];
+  if (fread(int_input, sizeof(int), 25, file_shx) != 25)
+  {
+    fclose(file_shx);
+    return FALSE;
+  }
+  from_big_endian(&int_input[0]);
+  from_big_endian(&int_input[6]);
+  if ((int_input[0] != 9994) || (int_input[6] < 50))
+  {
+    LASMessage(LAS_WARNING, "ignoring corrupt '.shx' file");
+    fclose(file_shx);
+    return FALSE;
+  }
+  I32 records = (int_input[6] - 50) / 4;
+  U32* shx = new U32[2 * (size_t)records + 1];
+  if (fread(shx, sizeof(U32), 2 * (size_t)records, file_shx) != 2 * (size_t)records)
+  {
+    LASMessage(LAS_WARNING, "ignoring truncated '.shx' file");
+    delete [] shx;
+    fclose(file_shx);
+    return FALSE;
+  }
+  fclose(file_shx);
+
+  I64 count = 0;
+  I32 i, length;
+  for (i = 0; i < 2 * records; i++)
+  {
+    from_big_endian((int*)&shx[i]);
+  }
+  for (i = 0; i < records; i++)
+  {
+    if (shx[2 * i] < 50)
+    {
+      LASMessage(LAS_WARNING, "ignoring corrupt '.shx' file");
+      delete [] shx;
+      return FALSE;
+    }
+    length = 2 * (I32)shx[2 * i + 1];
+    if (shape_type == 8)
+    {
+      if (length >= 40) count += (length - 40) / 16;
+    }
+    else if (shape_type == 28)
+    {
+      if (length >= 56) count += (length - 56) / 24;
+    }
+    else if (length >= 40) // shape_type == 18 has optional measures so we look at the record
+    {
+      int number;
+      if (fseek_las(file, 2 * (I64)shx[2 * i] + 8 + 36, SEEK_SET) || (fread(&number, sizeof(int), 1, file) != 1))
+      {
+        LASMessage(LAS_WARNING, "ignoring '.shx' file that does not match '.shp' file");
+        delete [] shx;
+        fseek_las(file, 100, SEEK_SET);
+        return FALSE;
+      }
+      from_little_endian(&number);
+      if (number > 0) count += number;
+    }
+  }
+  if (shape_type == 18)
+  {
+    fseek_las(file, 100, SEEK_SET);
+  }
+  shx_records = shx;
+  number_of_records = records;
+  npoints = count;
+  return TRUE;
+}
+
 ByteStreamIn* LASreaderSHP::get_stream() const
 {
   return 0;
@@ -499,6 +715,10 @@ BOOL LASreaderSHP::reopen(const char* file_name)
   if (fread(&double_input, sizeof(double), 1, file) != 1) return FALSE; // mmin (LITTLE)
   if (fread(&double_input, sizeof(double), 1, file) != 1) return FALSE; // mmax (LITTLE)
 
+  number_of_points = 0;
+  point_count = 0;
+  record_idx = 0;
+  record_position = 100;
   p_idx = 0;
   p_cnt = 0;
   return TRUE;
@@ -512,6 +732,12 @@ void LASreaderSHP::clean()
     fclose(file);
     file = 0;
   }
+  if (shx_records)
+  {
+    delete [] shx_records;
+    shx_records = 0;
+  }
+  number_of_records = 0;
   number_of_points = 0;
   point_count = 0;
 }
@@ -527,6 +753,14 @@ LASreaderSHP::LASreaderSHP(LASreadOpener* opener):LASreader(opener)
   points_allocated = 0;
   number_of_points = 0;
   point_count = 0;
+  shx_records = 0;
+  number_of_records = 0;
+  record_idx = 0;
+  record_position = 0;
+  record_buffer = 0;
+  record_buffer_allocated = 0;
+  record_filter = FALSE;
+  record_min_x = record_min_y = record_max_x = record_max_y = 0.0;
   orig_x_offset = 0.0;
   orig_y_offset = 0.0;
   orig_z_offset = 0.0;
@@ -553,6 +787,11 @@ LASreaderSHP::~LASreaderSHP()
     delete [] points;
     points = 0;
   }
+  if (record_buffer)
+  {
+    delete [] record_buffer;
+    record_buffer = 0;
+  }
 }
 
 void LASreaderSHP::populate_scale_and_offset()
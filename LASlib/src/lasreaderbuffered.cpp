@@ -38,6 +38,164 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// the buffers of tiles that are done are kept for the next tile instead of being
+// returned to the system because tile-wise processing allocates the same amount
+// of buffer memory again and again
+
+class LASbufferPool
+{
+public:
+  U8* get(size_t size)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if ((size == buffer_size) && buffers.size())
+    {
+      U8* buffer = buffers.back();
+      buffers.pop_back();
+      return buffer;
+    }
+    return (U8*)malloc_las(size);
+  };
+  void put(U8* buffer, size_t size)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (size != buffer_size)
+    {
+      release();
+      buffer_size = size;
+    }
+    buffers.push_back(buffer);
+  };
+  LASbufferPool() : buffer_size(0) {};
+  ~LASbufferPool() { release(); };
+private:
+  void release()
+  {
+    for (size_t i = 0; i < buffers.size(); i++) free(buffers[i]);
+    buffers.clear();
+  };
+  std::mutex mutex;
+  size_t buffer_size;
+  std::vector<U8*> buffers;
+};
+
+static LASbufferPool buffer_pool;
+
+// the decoded buffer points of recently read neighbor areas. tiles processed in
+// row-major or similar order ask for areas of the same neighbor file that are
+// inside an area read for an earlier tile. those points are then taken from the
+// cache. the least recently used areas are evicted to stay within the budget.
+
+struct LASbufferCacheKey
+{
+  F64 min_x;
+  F64 min_y;
+  F64 max_x;
+  F64 max_y;
+  F64 scale[3];
+  F64 offset[3];
+  U32 point_size;
+  U8 point_data_format;
+};
+
+class LASbufferCache
+{
+public:
+  void set_budget(size_t budget)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->budget = budget;
+    evict(0);
+  };
+  const std::vector<U8>* find(const CHAR* file_name, const LASbufferCacheKey& key)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::list<Entry>::iterator it = entries.begin(); it != entries.end(); it++)
+    {
+      const LASbufferCacheKey& area = it->key;
+      if ((area.point_size != key.point_size) || (area.point_data_format != key.point_data_format)) continue;
+      if (memcmp(area.scale, key.scale, sizeof(key.scale)) || memcmp(area.offset, key.offset, sizeof(key.offset))) continue;
+      if (it->file_name != file_name) continue;
+      // only the part of the requested area that is covered by the file needs to be in the cached area
+      F64 min_x = (key.min_x > it->file_min_x ? key.min_x : it->file_min_x);
+      F64 min_y = (key.min_y > it->file_min_y ? key.min_y : it->file_min_y);
+      F64 max_x = (key.max_x < it->file_max_x ? key.max_x : it->file_max_x);
+      F64 max_y = (key.max_y < it->file_max_y ? key.max_y : it->file_max_y);
+      if ((min_x <= max_x) && (min_y <= max_y))
+      {
+        if ((area.min_x > min_x) || (area.min_y > min_y)) continue;
+        if ((area.max_x <= max_x) && (area.max_x < key.max_x)) continue;
+        if ((area.max_y <= max_y) && (area.max_y < key.max_y)) continue;
+      }
+      entries.splice(entries.begin(), entries, it);
+      return &(entries.front().points);
+    }
+    return 0;
+  };
+  void insert(const CHAR* file_name, const LASreader* lasreader, const LASbufferCacheKey& key, std::vector<U8>& points)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (points.capacity() > budget) return;
+    evict(points.capacity());
+    entries.push_front(Entry());
+    entries.front().file_name = file_name;
+    entries.front().key = key;
+    entries.front().file_min_x = lasreader->get_orig_min_x();
+    entries.front().file_min_y = lasreader->get_orig_min_y();
+    entries.front().file_max_x = lasreader->get_orig_max_x();
+    entries.front().file_max_y = lasreader->get_orig_max_y();
+    entries.front().points.swap(points);
+    used += entries.front().points.capacity();
+  };
+  LASbufferCache() : budget(0), used(0) {};
+private:
+  struct Entry
+  {
+    std::string file_name;
+    LASbufferCacheKey key;
+    F64 file_min_x;
+    F64 file_min_y;
+    F64 file_max_x;
+    F64 file_max_y;
+    std::vector<U8> points;
+  };
+  void evict(size_t size)
+  {
+    while (entries.size() && ((used + size) > budget))
+    {
+      used -= entries.back().points.capacity();
+      entries.pop_back();
+    }
+  };
+  std::mutex mutex;
+  size_t budget;
+  size_t used;
+  std::list<Entry> entries;
+};
+
+static LASbufferCache buffer_cache;
+
+// the points that one neighbor contributes to the buffer
+
+struct LASbufferedNeighbor
+{
+  const CHAR* file_name;
+  LASreader* lasreader;
+  const std::vector<U8>* cached;
+  std::vector<U8> points;
+  U32 number;
+  U32 number_of_points_by_return[5];
+  F64 min[3];
+  F64 max[3];
+};
+
 void LASreaderBuffered::set_scale_factor(const F64* scale_factor)
 {
   lasreadopener.set_scale_factor(scale_factor);
@@ -139,6 +297,17 @@ void LASreaderBuffered::set_buffer_size(const F32 buffer_size)
   this->buffer_size = buffer_size;
 }
 
+void LASreaderBuffered::set_neighbor_threads(const U32 neighbor_threads)
+{
+  this->neighbor_threads = neighbor_threads;
+}
+
+void LASreaderBuffered::set_neighbor_cache(const U32 megabytes)
+{
+  neighbor_cache = (megabytes > 0);
+  buffer_cache.set_budget((size_t)megabytes * 1024 * 1024);
+}
+
 BOOL LASreaderBuffered::open()
 {
   if (!lasreadopener.active())
@@ -200,68 +369,77 @@ BOOL LASreaderBuffered::open()
 
     lasreadopener_neighbors.set_offset(&header.x_offset);
 
-    // open neighbors
-
-    LASreader* lasreader_neighbor = lasreadopener_neighbors.open();
-    if (lasreader_neighbor == 0)
-    {
-      laserror("opening neighbor '%s'", lasreadopener_neighbors.get_file_name());
-      return FALSE;
-    }
+    // without filter or transform (which keep state) each neighbor can be read by its own thread
 
-    // a point type change could be problematic
-    if (header.point_data_format != lasreader_neighbor->header.point_data_format)
+    if (((neighbor_threads > 1) || neighbor_cache) && (filter == 0) && (transform == 0))
     {
-      if (!point_type_change) LASMessage(LAS_WARNING, "files have different point types: %d vs %d", header.point_data_format, lasreader_neighbor->header.point_data_format);
-      point_type_change = TRUE;
+      if (!load_neighbors()) return FALSE;
     }
-    // a point size change could be problematic
-    if (header.point_data_record_length != lasreader_neighbor->header.point_data_record_length)
+    else
     {
-      if (!point_size_change) LASMessage(LAS_WARNING, "files have different point sizes: %d vs %d", header.point_data_record_length, lasreader_neighbor->header.point_data_record_length);
-      point_size_change = TRUE;
-    }
+      // open neighbors as one merged file
 
-    while (lasreader_neighbor->read_point())
-    {
-      // copy
-      point = lasreader_neighbor->point;
-      // copy_point_to_buffer
-      copy_point_to_buffer();
-      // increment number of points by return
-      if (point.return_number == 1)
+      LASreader* lasreader_neighbor = lasreadopener_neighbors.open();
+      if (lasreader_neighbor == 0)
       {
-        header.number_of_points_by_return[0]++;
+        laserror("opening neighbor '%s'", lasreadopener_neighbors.get_file_name());
+        return FALSE;
       }
-      else if (point.return_number == 2)
-      {
-        header.number_of_points_by_return[1]++;
-      }
-      else if (point.return_number == 3)
+
+      // a point type change could be problematic
+      if (header.point_data_format != lasreader_neighbor->header.point_data_format)
       {
-        header.number_of_points_by_return[2]++;
+        if (!point_type_change) LASMessage(LAS_WARNING, "files have different point types: %d vs %d", header.point_data_format, lasreader_neighbor->header.point_data_format);
+        point_type_change = TRUE;
       }
-      else if (point.return_number == 4)
+      // a point size change could be problematic
+      if (header.point_data_record_length != lasreader_neighbor->header.point_data_record_length)
       {
-        header.number_of_points_by_return[3]++;
+        if (!point_size_change) LASMessage(LAS_WARNING, "files have different point sizes: %d vs %d", header.point_data_record_length, lasreader_neighbor->header.point_data_record_length);
+        point_size_change = TRUE;
       }
-      else if (point.return_number == 5)
+
+      while (lasreader_neighbor->read_point())
       {
-        header.number_of_points_by_return[4]++;
+        // copy
+        point = lasreader_neighbor->point;
+        // copy_point_to_buffer
+        copy_point_to_buffer();
+        // increment number of points by return
+        if (point.return_number == 1)
+        {
+          header.number_of_points_by_return[0]++;
+        }
+        else if (point.return_number == 2)
+        {
+          header.number_of_points_by_return[1]++;
+        }
+        else if (point.return_number == 3)
+        {
+          header.number_of_points_by_return[2]++;
+        }
+        else if (point.return_number == 4)
+        {
+          header.number_of_points_by_return[3]++;
+        }
+        else if (point.return_number == 5)
+        {
+          header.number_of_points_by_return[4]++;
+        }
+        // grow bounding box
+        xyz = point.get_x();
+        if (header.min_x > xyz) header.min_x = xyz;
+        else if (header.max_x < xyz) header.max_x = xyz;
+        xyz = point.get_y();
+        if (header.min_y > xyz) header.min_y = xyz;
+        else if (header.max_y < xyz) header.max_y = xyz;
+        xyz = point.get_z();
+        if (header.min_z > xyz) header.min_z = xyz;
+        else if (header.max_z < xyz) header.max_z = xyz;
       }
-      // grow bounding box
-      xyz = point.get_x();
-      if (header.min_x > xyz) header.min_x = xyz;
-      else if (header.max_x < xyz) header.max_x = xyz;
-      xyz = point.get_y();
-      if (header.min_y > xyz) header.min_y = xyz;
-      else if (header.max_y < xyz) header.max_y = xyz;
-      xyz = point.get_z();
-      if (header.min_z > xyz) header.min_z = xyz;
-      else if (header.max_z < xyz) header.max_z = xyz;
+      lasreader_neighbor->close();
+      delete lasreader_neighbor;
     }
-    lasreader_neighbor->close();
-    delete lasreader_neighbor;
 
     if (header.number_of_point_records)
     {
@@ -362,6 +540,188 @@ BOOL LASreaderBuffered::open()
   return TRUE;
 }
 
+// opens the neighbors one after the other and then decompresses the points inside
+// the buffer area with several threads into one point array per neighbor. these
+// are appended to the buffer in the order of the neighbors so the result is the
+// same as that of reading them merged. neighbor areas that are inside an area of
+// the same file that an earlier tile has read are taken from the buffer cache.
+
+BOOL LASreaderBuffered::load_neighbors()
+{
+  U32 i;
+  F64 r_min_x = header.min_x - buffer_size;
+  F64 r_min_y = header.min_y - buffer_size;
+  F64 r_max_x = header.max_x + buffer_size;
+  F64 r_max_y = header.max_y + buffer_size;
+
+  LASpoint layout_point;
+  if (header.laszip)
+    layout_point.init(&header, header.laszip->num_items, header.laszip->items, &header);
+  else
+    layout_point.init(&header, header.point_data_format, header.point_data_record_length, &header);
+
+  LASbufferCacheKey key;
+  key.min_x = r_min_x;
+  key.min_y = r_min_y;
+  key.max_x = r_max_x;
+  key.max_y = r_max_y;
+  key.scale[0] = header.x_scale_factor;
+  key.scale[1] = header.y_scale_factor;
+  key.scale[2] = header.z_scale_factor;
+  key.offset[0] = header.x_offset;
+  key.offset[1] = header.y_offset;
+  key.offset[2] = header.z_offset;
+  key.point_data_format = header.point_data_format;
+  key.point_size = layout_point.total_point_size;
+
+  std::vector<LASbufferedNeighbor> neighbors;
+
+  for (i = 0; i < lasreadopener_neighbors.get_file_name_number(); i++)
+  {
+    const CHAR* file_name = lasreadopener_neighbors.get_file_name(i);
+    const std::vector<U8>* cached = (neighbor_cache ? buffer_cache.find(file_name, key) : 0);
+    LASreader* lasreader_neighbor = 0;
+    if (cached == 0)
+    {
+      lasreader_neighbor = lasreadopener_neighbors.open(file_name, FALSE);
+      if (lasreader_neighbor == 0)
+      {
+        laserror("opening neighbor '%s'", file_name);
+        for (i = 0; i < neighbors.size(); i++) if (neighbors[i].lasreader) delete neighbors[i].lasreader;
+        return FALSE;
+      }
+      // skip neighbors whose bounding box does not overlap the buffer area
+      if ((lasreader_neighbor->get_orig_min_x() > r_max_x) || (lasreader_neighbor->get_orig_min_y() > r_max_y) || (lasreader_neighbor->get_orig_max_x() < r_min_x) || (lasreader_neighbor->get_orig_max_y() < r_min_y))
+      {
+        lasreader_neighbor->close();
+        delete lasreader_neighbor;
+        continue;
+      }
+      // a point type change could be problematic
+      if (header.point_data_format != lasreader_neighbor->header.point_data_format)
+      {
+        if (!point_type_change) LASMessage(LAS_WARNING, "files have different point types: %d vs %d", header.point_data_format, lasreader_neighbor->header.point_data_format);
+        point_type_change = TRUE;
+      }
+      // a point size change could be problematic
+      if (header.point_data_record_length != lasreader_neighbor->header.point_data_record_length)
+      {
+        if (!point_size_change) LASMessage(LAS_WARNING, "files have different point sizes: %d vs %d", header.point_data_record_length, lasreader_neighbor->header.point_data_record_length);
+        point_size_change = TRUE;
+      }
+    }
+    neighbors.push_back(LASbufferedNeighbor());
+    LASbufferedNeighbor& neighbor = neighbors.back();
+    neighbor.file_name = file_name;
+    neighbor.lasreader = lasreader_neighbor;
+    neighbor.cached = cached;
+    neighbor.number = 0;
+    memset(neighbor.number_of_points_by_return, 0, sizeof(neighbor.number_of_points_by_return));
+    neighbor.min[0] = neighbor.min[1] = neighbor.min[2] = F64_MAX;
+    neighbor.max[0] = neighbor.max[1] = neighbor.max[2] = F64_MIN;
+  }
+
+  std::atomic<U32> next(0);
+
+  auto load = [&]()
+  {
+    LASpoint buffer_point;
+    if (header.laszip)
+      buffer_point.init(&header, header.laszip->num_items, header.laszip->items, &header);
+    else
+      buffer_point.init(&header, header.point_data_format, header.point_data_record_length, &header);
+    U32 size = buffer_point.total_point_size;
+    U32 k;
+    while ((k = next++) < neighbors.size())
+    {
+      LASbufferedNeighbor& neighbor = neighbors[k];
+      LASreader* lasreader_neighbor = neighbor.lasreader;
+      size_t used = 0;
+      size_t cached_used = 0;
+      buffer_point.zero();
+      while (true)
+      {
+        if (lasreader_neighbor)
+        {
+          if (!lasreader_neighbor->read_point()) break;
+          buffer_point = lasreader_neighbor->point;
+        }
+        else
+        {
+          if (cached_used == neighbor.cached->size()) break;
+          buffer_point.copy_from(&((*neighbor.cached)[cached_used]));
+          cached_used += size;
+          if (!buffer_point.inside_rectangle(r_min_x, r_min_y, r_max_x, r_max_y)) continue;
+        }
+        if ((used + size) > neighbor.points.size())
+        {
+          neighbor.points.resize(neighbor.points.size() ? 2 * neighbor.points.size() : (size_t)size * points_per_buffer);
+        }
+        buffer_point.copy_to(&(neighbor.points[used]));
+        used += size;
+        neighbor.number++;
+        if ((buffer_point.return_number >= 1) && (buffer_point.return_number <= 5))
+        {
+          neighbor.number_of_points_by_return[buffer_point.return_number - 1]++;
+        }
+        F64 xyz[3] = { buffer_point.get_x(), buffer_point.get_y(), buffer_point.get_z() };
+        for (U32 j = 0; j < 3; j++)
+        {
+          if (neighbor.min[j] > xyz[j]) neighbor.min[j] = xyz[j];
+          if (neighbor.max[j] < xyz[j]) neighbor.max[j] = xyz[j];
+        }
+      }
+      neighbor.points.resize(used);
+      if (lasreader_neighbor) lasreader_neighbor->close();
+    }
+  };
+
+  U32 threads = (neighbor_threads < neighbors.size() ? neighbor_threads : (U32)neighbors.size());
+  std::vector<std::thread> workers;
+  for (i = 1; i < threads; i++)
+  {
+    try { workers.push_back(std::thread(load)); } catch (...) { break; }
+  }
+  load();
+  for (i = 0; i < workers.size(); i++)
+  {
+    workers[i].join();
+  }
+
+  U32 cache_hits = 0;
+  for (i = 0; i < neighbors.size(); i++)
+  {
+    LASbufferedNeighbor& neighbor = neighbors[i];
+    copy_points_to_buffer(neighbor.points.data(), neighbor.number);
+    header.number_of_points_by_return[0] += neighbor.number_of_points_by_return[0];
+    header.number_of_points_by_return[1] += neighbor.number_of_points_by_return[1];
+    header.number_of_points_by_return[2] += neighbor.number_of_points_by_return[2];
+    header.number_of_points_by_return[3] += neighbor.number_of_points_by_return[3];
+    header.number_of_points_by_return[4] += neighbor.number_of_points_by_return[4];
+    if (neighbor.number)
+    {
+      if (header.min_x > neighbor.min[0]) header.min_x = neighbor.min[0];
+      if (header.min_y > neighbor.min[1]) header.min_y = neighbor.min[1];
+      if (header.min_z > neighbor.min[2]) header.min_z = neighbor.min[2];
+      if (header.max_x < neighbor.max[0]) header.max_x = neighbor.max[0];
+      if (header.max_y < neighbor.max[1]) header.max_y = neighbor.max[1];
+      if (header.max_z < neighbor.max[2]) header.max_z = neighbor.max[2];
+    }
+    if (neighbor.lasreader)
+    {
+      // COPC files may stream the points of another area in another order
+      if (neighbor_cache && (neighbor.lasreader->header.vlr_copc_info == 0)) buffer_cache.insert(neighbor.file_name, neighbor.lasreader, key, neighbor.points);
+      delete neighbor.lasreader;
+    }
+    else
+    {
+      cache_hits++;
+    }
+  }
+  LASMessage(LAS_VERBOSE, "LASreaderBuffered: read %u neighbors with %u threads (%u from cache).", (U32)neighbors.size(), (U32)workers.size() + 1, cache_hits);
+  return TRUE;
+}
+
 BOOL LASreaderBuffered::reopen()
 {
   p_idx = 0;
@@ -516,7 +876,7 @@ void LASreaderBuffered::clean_buffer()
     U32 i;
     for (i = 0; i < number_of_buffers; i++)
     {
-      free(buffers[i]);
+      if (buffers[i]) buffer_pool.put(buffers[i], (size_t)point.total_point_size * (size_t)points_per_buffer);
     }
     free(buffers);
     buffers = 0;
@@ -527,34 +887,59 @@ void LASreaderBuffered::clean_buffer()
   point_count = 0;
 }
 
+U8* LASreaderBuffered::add_buffer()
+{
+  if (buffers == 0)
+  {
+    size_of_buffers_array = 1024;
+    buffers = (U8**)malloc_las(sizeof(U8*) * size_of_buffers_array);
+    number_of_buffers = 0;
+  }
+  else if (number_of_buffers == size_of_buffers_array)
+  {
+    size_of_buffers_array *= 2;
+    buffers = (U8**)realloc_las(buffers, sizeof(U8*)*size_of_buffers_array);
+  }
+  if (buffers != nullptr)
+  {
+    buffers[number_of_buffers] = buffer_pool.get((size_t)point.total_point_size * (size_t)points_per_buffer);
+    current_buffer = buffers[number_of_buffers];
+  }
+  number_of_buffers++;
+  return current_buffer;
+}
+
 BOOL LASreaderBuffered::copy_point_to_buffer()
 {
   U32 point_count_in_buffer = (buffered_points % points_per_buffer);
   if (point_count_in_buffer == 0)
   {
-    if (buffers == 0)
-    {
-      size_of_buffers_array = 1024;
-      buffers = (U8**)malloc_las(sizeof(U8*) * size_of_buffers_array);
-      number_of_buffers = 0;
-    }
-    else if (number_of_buffers == size_of_buffers_array)
-    {
-      size_of_buffers_array *= 2;
-      buffers = (U8**)realloc_las(buffers, sizeof(U8*)*size_of_buffers_array);
-    }
-    if (buffers != nullptr)
-    {
-      buffers[number_of_buffers] = (U8*)malloc_las((size_t)point.total_point_size * (size_t)points_per_buffer);
-      current_buffer = buffers[number_of_buffers];
-    }
-    number_of_buffers++;
+    add_buffer();
   }
   if (current_buffer != nullptr) point.copy_to(&(current_buffer[point_count_in_buffer * point.total_point_size]));
   buffered_points++;
   return TRUE;
 }
 
+BOOL LASreaderBuffered::copy_points_to_buffer(const U8* points, U32 number)
+{
+  while (number)
+  {
+    U32 point_count_in_buffer = (buffered_points % points_per_buffer);
+    if (point_count_in_buffer == 0)
+    {
+      add_buffer();
+    }
+    U32 count = points_per_buffer - point_count_in_buffer;
+    if (count > number) count = number;
+    if (current_buffer != nullptr) memcpy(&(current_buffer[point_count_in_buffer * point.total_point_size]), points, (size_t)count * point.total_point_size);
+    points += (size_t)count * point.total_point_size;
+    buffered_points += count;
+    number -= count;
+  }
+  return TRUE;
+}
+
 BOOL LASreaderBuffered::copy_point_from_buffer()
 {
   if (point_count >= buffered_points)
@@ -583,6 +968,8 @@ LASreaderBuffered::LASreaderBuffered(LASreadOpener* opener): LASreader(opener),
   lasreadopener_neighbors.set_merged(TRUE);
 
   buffer_size = 0.0f;
+  neighbor_threads = 1;
+  neighbor_cache = FALSE;
   buffers = 0;
   clean();
   clean_buffer();
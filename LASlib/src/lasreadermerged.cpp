@@ -35,15 +35,244 @@
 #include "lascopc.hpp"
 #include "lasfilter.hpp"
 #include "lastransform.hpp"
+#include "bytestreamin_array.hpp"
 
 #include <stdlib.h>
 #include <string.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// enough bytes to hold the header of LAS 1.0 to 1.5 files plus some user data
+
+static const U32 LAS_MERGED_HEADER_BLOCK_SIZE = 1024;
+
+// the catalog stores file size, modification time, and the header bytes of each
+// LAS/LAZ file under its absolute path. as long as size and modification time do
+// not change the header bytes from the catalog are used instead of the file.
+
+static BOOL read_merged_catalog(const CHAR* file_name, std::unordered_map<std::string, LASmergedCatalogEntry>& catalog)
+{
+  FILE* file = LASfopen(file_name, "rb");
+  if (file == 0) return FALSE;
+  CHAR signature[16];
+  U32 version, count, length, i;
+  BOOL ok = ((fread(signature, 1, 16, file) == 16) && (strncmp(signature, "LASmergedCatalog", 16) == 0));
+  ok = ok && (fread(&version, sizeof(U32), 1, file) == 1) && (version == 1);
+  ok = ok && (fread(&count, sizeof(U32), 1, file) == 1);
+  for (i = 0; ok && (i < count); i++)
+  {
+    LASmergedCatalogEntry entry;
+    std::string path;
+    ok = (fread(&length, sizeof(U32), 1, file) == 1) && (length < 65536);
+    if (!ok) break;
+    path.resize(length);
+    ok = (fread(&path[0], 1, length, file) == length);
+    ok = ok && (fread(&entry.file_size, sizeof(I64), 1, file) == 1);
+    ok = ok && (fread(&entry.file_time, sizeof(I64), 1, file) == 1);
+    ok = ok && (fread(&length, sizeof(U32), 1, file) == 1) && (length <= LAS_MERGED_HEADER_BLOCK_SIZE);
+    if (!ok) break;
+    entry.bytes.resize(length);
+    ok = (fread(entry.bytes.data(), 1, length, file) == length);
+    if (ok) catalog[path] = entry;
+  }
+  fclose(file);
+  if (!ok)
+  {
+    LASMessage(LAS_WARNING, "ignoring corrupt catalog '%s'", file_name);
+    catalog.clear();
+  }
+  return ok;
+}
+
+static BOOL has_stream_trailer(FILE* file, I64 file_size)
+{
+  U8 bytes[20];
+  if (file_size < 60 + LAS_TOOLS_STREAM_TRAILER_PAYLOAD) return FALSE;
+  if (fseek_las(file, file_size - 60 - LAS_TOOLS_STREAM_TRAILER_PAYLOAD, SEEK_SET) != 0) return FALSE;
+  if (fread(bytes, 1, 20, file) != 20) return FALSE;
+  U16 record_id = bytes[18] | (bytes[19] << 8);
+  return ((strncmp((const CHAR*)(bytes + 2), "LAStools", 16) == 0) && (record_id == LAS_TOOLS_STREAM_TRAILER_RECORD_ID));
+}
+
+static BOOL write_merged_catalog(const CHAR* file_name, const std::unordered_map<std::string, LASmergedCatalogEntry>& catalog)
+{
+  FILE* file = LASfopen(file_name, "wb");
+  if (file == 0)
+  {
+    LASMessage(LAS_WARNING, "cannot write catalog '%s'", file_name);
+    return FALSE;
+  }
+  U32 version = 1;
+  U32 count = (U32)catalog.size();
+  U32 length;
+  BOOL ok = (fwrite("LASmergedCatalog", 1, 16, file) == 16);
+  ok = ok && (fwrite(&version, sizeof(U32), 1, file) == 1);
+  ok = ok && (fwrite(&count, sizeof(U32), 1, file) == 1);
+  for (std::unordered_map<std::string, LASmergedCatalogEntry>::const_iterator it = catalog.begin(); ok && (it != catalog.end()); it++)
+  {
+    length = (U32)it->first.size();
+    ok = (fwrite(&length, sizeof(U32), 1, file) == 1);
+    ok = ok && (fwrite(it->first.data(), 1, length, file) == length);
+    ok = ok && (fwrite(&(it->second.file_size), sizeof(I64), 1, file) == 1);
+    ok = ok && (fwrite(&(it->second.file_time), sizeof(I64), 1, file) == 1);
+    length = (U32)it->second.bytes.size();
+    ok = ok && (fwrite(&length, sizeof(U32), 1, file) == 1);
+    ok = ok && (fwrite(it->second.bytes.data(), 1, length, file) == length);
+  }
+  if (fclose(file) != 0) ok = FALSE;
+  if (!ok)
+  {
+    LASMessage(LAS_WARNING, "failed writing catalog '%s'", file_name);
+  }
+  return ok;
+}
+
 void LASreaderMerged::set_io_ibuffer_size(I32 io_ibuffer_size)
 {
   this->io_ibuffer_size = io_ibuffer_size;
 }
 
+// reads ahead of the main thread the parts of the next files that opening them
+// touches (header, VLRs, first chunk, LAZ chunk table, EVLRs, and LAX file) so
+// that these are served from the operating system's file cache when the main
+// thread opens them. the bytes themselves are discarded. the prefetcher never
+// touches any reader so that it cannot interfere with the main thread.
+
+class LASmergedPrefetcher
+{
+public:
+  void add(const CHAR* file_name, BOOL is_las)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      queue.push_back(std::make_pair(std::string(file_name), is_las));
+    }
+    condition.notify_one();
+  };
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.clear();
+  };
+  LASmergedPrefetcher() : quit(false), worker(&LASmergedPrefetcher::run, this) {};
+  ~LASmergedPrefetcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      quit = true;
+      queue.clear();
+    }
+    condition.notify_one();
+    worker.join();
+  };
+private:
+  static const U32 FIRST_BYTES = 1048576;
+  static const U32 LAST_BYTES = 4194304;
+  void run()
+  {
+    while (true)
+    {
+      std::pair<std::string, BOOL> next;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this]{ return quit || !queue.empty(); });
+        if (quit) return;
+        next = queue.front();
+        queue.pop_front();
+      }
+      touch(next.first, next.second);
+    }
+  };
+  static U64 get_le(const U8* bytes, U32 count)
+  {
+    U64 value = 0;
+    while (count--) value = (value << 8) | bytes[count];
+    return value;
+  };
+  BOOL touch_bytes(FILE* file, I64 start, I64 count)
+  {
+    if (fseek_las(file, start, SEEK_SET)) return FALSE;
+    while (count > 0)
+    {
+      size_t bytes = (count < (I64)sizeof(scratch) ? (size_t)count : sizeof(scratch));
+      if (fread(scratch, 1, bytes, file) != bytes) return FALSE;
+      count -= bytes;
+    }
+    return TRUE;
+  };
+  void touch(const std::string& file_name, BOOL is_las)
+  {
+    FILE* file = LASfopen(file_name.c_str(), "rb");
+    if (file == 0) return;
+    if (is_las)
+    {
+      U8 header[243];
+      size_t got = fread(header, 1, 243, file);
+      if ((got >= 227) && (strncmp((const CHAR*)header, "LASF", 4) == 0))
+      {
+        U16 header_size = header[94] | (header[95] << 8);
+        U32 offset_to_point_data = (U32)get_le(header + 96, 4);
+        // header, VLRs and the first chunk or points
+        touch_bytes(file, 0, (I64)offset_to_point_data + FIRST_BYTES);
+        // the chunk table of compressed files and the EVLRs are usually at the end
+        I64 file_size = 0;
+        I64 tail_start = 0;
+        if ((fseek_las(file, 0, SEEK_END) == 0) && ((file_size = ftell_las(file)) > 0))
+        {
+          if (header[104] & 0x80)
+          {
+            U8 bytes[8];
+            if ((fseek_las(file, offset_to_point_data, SEEK_SET) == 0) && (fread(bytes, 1, 8, file) == 8))
+            {
+              I64 chunk_table_start = (I64)get_le(bytes, 8);
+              if ((chunk_table_start > (I64)offset_to_point_data) && (chunk_table_start < file_size)) tail_start = chunk_table_start;
+            }
+          }
+          if ((header_size >= 243) && (got >= 243))
+          {
+            I64 evlr_start = (I64)get_le(header + 235, 8);
+            if ((evlr_start > (I64)offset_to_point_data) && (evlr_start < file_size) && ((tail_start == 0) || (evlr_start < tail_start))) tail_start = evlr_start;
+          }
+          if (tail_start)
+          {
+            if ((file_size - tail_start) > LAST_BYTES) tail_start = file_size - LAST_BYTES;
+            touch_bytes(file, tail_start, file_size - tail_start);
+          }
+        }
+      }
+    }
+    else
+    {
+      touch_bytes(file, 0, FIRST_BYTES);
+    }
+    fclose(file);
+    // the spatial index
+    std::string lax_name = FileExtSet(file_name, ".lax");
+    if (lax_name != file_name)
+    {
+      file = LASfopen(lax_name.c_str(), "rb");
+      if (file)
+      {
+        while (fread(scratch, 1, sizeof(scratch), file) == sizeof(scratch));
+        fclose(file);
+      }
+    }
+  };
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::deque< std::pair<std::string, BOOL> > queue;
+  bool quit;
+  U8 scratch[65536];
+  std::thread worker;
+};
+
 BOOL LASreaderMerged::add_file_name(const CHAR* file_name)
 {
   // do we have a file name
@@ -52,14 +281,17 @@ BOOL LASreaderMerged::add_file_name(const CHAR* file_name)
     laserror("file name pointer is NULL");
     return FALSE;
   }
-  // does the file exist
-  FILE* file = LASfopen(file_name, "r");
-  if (file == 0)
+  // does the file exist (for LAS/LAZ this is checked by the header scan)
+  if (!IsLasLazFile(std::string(file_name)) || ((header_scan_threads <= 1) && (catalog_file_name == 0)))
   {
-    laserror("file '%s' cannot be opened", file_name);
-    return FALSE;
+    FILE* file = LASfopen(file_name, "r");
+    if (file == 0)
+    {
+      laserror("file '%s' cannot be opened", file_name);
+      return FALSE;
+    }
+    fclose(file);
   }
-  fclose(file);
   // check file extension
   if (IsLasLazFile(std::string(file_name))) {
     if (lasreaderbin)
@@ -640,6 +872,148 @@ void LASreaderMerged::set_copc_stream_order(U8 order)
   copc_stream_order = order;
 }
 
+void LASreaderMerged::set_catalog_file_name(const CHAR* catalog_file_name)
+{
+  if (this->catalog_file_name) free(this->catalog_file_name);
+  if (catalog_file_name)
+  {
+    this->catalog_file_name = LASCopyString(catalog_file_name);
+  }
+  else
+  {
+    this->catalog_file_name = 0;
+  }
+}
+
+void LASreaderMerged::set_header_scan_threads(U32 header_scan_threads)
+{
+  this->header_scan_threads = header_scan_threads;
+}
+
+void LASreaderMerged::set_prefetch_depth(U32 prefetch_depth)
+{
+  this->prefetch_depth = prefetch_depth;
+}
+
+// reads the first bytes of all LAS/LAZ files with several threads because opening
+// tens of thousands of files one after the other is dominated by file system latency
+// (especially on network drives). the headers are parsed later by the main thread.
+
+BOOL LASreaderMerged::scan_headers()
+{
+  U32 i;
+
+  header_blocks.clear();
+  header_blocks.resize(file_name_number);
+
+  std::unordered_map<std::string, LASmergedCatalogEntry> catalog;
+  if (catalog_file_name) read_merged_catalog(catalog_file_name, catalog);
+
+  std::vector<std::string> paths(file_name_number);
+  for (i = 0; i < file_name_number; i++)
+  {
+    std::error_code error;
+    std::filesystem::path path = std::filesystem::absolute(file_names[i], error);
+    paths[i] = (error ? std::string(file_names[i]) : path.string());
+  }
+
+  // 0 = from catalog, 1 = read from file, 2 = missing
+
+  std::vector<U8> status(file_name_number, 0);
+  std::atomic<U32> next(0);
+
+  auto scan = [&]()
+  {
+    U32 k;
+    while ((k = next++) < file_name_number)
+    {
+      std::error_code error;
+      LASmergedCatalogEntry& entry = header_blocks[k];
+      entry.file_size = (I64)std::filesystem::file_size(paths[k], error);
+      if (error) { status[k] = 2; continue; }
+      entry.file_time = (I64)std::filesystem::last_write_time(paths[k], error).time_since_epoch().count();
+      std::unordered_map<std::string, LASmergedCatalogEntry>::const_iterator cached = catalog.find(paths[k]);
+      if ((cached != catalog.end()) && (cached->second.file_size == entry.file_size) && (cached->second.file_time == entry.file_time))
+      {
+        entry.bytes = cached->second.bytes;
+        continue;
+      }
+      FILE* file = LASfopen(file_names[k], "rb");
+      if (file == 0) { status[k] = 2; continue; }
+      entry.bytes.resize(LAS_MERGED_HEADER_BLOCK_SIZE);
+      entry.bytes.resize(fread(entry.bytes.data(), 1, LAS_MERGED_HEADER_BLOCK_SIZE, file));
+      // the final header values of LAS 1.4 files written to a pipe may be in a
+      // trailer EVLR. such files are opened in full so that it is found.
+      if ((entry.bytes.size() > 25) && (entry.bytes[25] >= 4) && has_stream_trailer(file, entry.file_size))
+      {
+        entry.bytes.clear();
+      }
+      fclose(file);
+      status[k] = 1;
+    }
+  };
+
+  U32 threads = (header_scan_threads < file_name_number ? header_scan_threads : file_name_number);
+  std::vector<std::thread> workers;
+  for (i = 1; i < threads; i++)
+  {
+    try { workers.push_back(std::thread(scan)); } catch (...) { break; }
+  }
+  scan();
+  for (i = 0; i < workers.size(); i++)
+  {
+    workers[i].join();
+  }
+
+  U32 scanned = 0;
+  for (i = 0; i < file_name_number; i++)
+  {
+    if (status[i] == 2)
+    {
+      laserror("file '%s' cannot be opened", file_names[i]);
+      return FALSE;
+    }
+    if (status[i] == 1)
+    {
+      scanned++;
+      if (catalog_file_name) catalog[paths[i]] = header_blocks[i];
+    }
+  }
+  LASMessage(LAS_VERBOSE, "scanned headers of %u files with %u threads (%u from catalog)", file_name_number, (U32)workers.size() + 1, file_name_number - scanned);
+  if (catalog_file_name && scanned)
+  {
+    write_merged_catalog(catalog_file_name, catalog);
+  }
+  return TRUE;
+}
+
+// opens the LAS/LAZ reader in peek mode on the header bytes from the scan. returns
+// FALSE if these bytes are not a complete LAS header so that the file is opened.
+
+BOOL LASreaderMerged::peek_header_block(U32 i)
+{
+  if (i >= header_blocks.size()) return FALSE;
+  const std::vector<U8>& bytes = header_blocks[i].bytes;
+  if ((bytes.size() < 227) || (strncmp((const CHAR*)bytes.data(), "LASF", 4) != 0)) return FALSE;
+  U32 header_size = bytes[94] | (bytes[95] << 8);
+  if ((header_size < 227) || (header_size > bytes.size())) return FALSE;
+  ByteStreamIn* in;
+  if (Endian::IS_LITTLE_ENDIAN)
+    in = new ByteStreamInArrayLE(bytes.data(), header_size);
+  else
+    in = new ByteStreamInArrayBE(bytes.data(), header_size);
+  // the scan has not handed out the header bytes of files with a trailer
+  lasreaderlas->set_probe_stream_trailer(FALSE);
+  BOOL opened = lasreaderlas->open(in, TRUE);
+  lasreaderlas->set_probe_stream_trailer(TRUE);
+  if (!opened)
+  {
+    lasreaderlas->close();
+    return FALSE;
+  }
+  return TRUE;
+}
+
 BOOL LASreaderMerged::open()
 {
   if (file_name_number == 0)
@@ -648,6 +1022,12 @@ BOOL LASreaderMerged::open()
     return FALSE;
   }
 
+  // read the LAS/LAZ headers in parallel or from the catalog
+  if (lasreaderlas && (file_name_number > 1) && ((header_scan_threads > 1) || catalog_file_name))
+  {
+    if (!scan_headers()) return FALSE;
+  }
+
   // allocate space for the individual bounding_boxes
   if (bounding_boxes) delete[] bounding_boxes;
   bounding_boxes = new F64[file_name_number * 4];
@@ -669,7 +1049,8 @@ BOOL LASreaderMerged::open()
     // open the lasreader with the next file name
     if (lasreaderlas)
     {
-      if (!lasreaderlas->open(file_names[i], 512, (first == FALSE) && (attributes == FALSE))) // starting from second just "peek" into file to get bounding box and count
+      BOOL peek_only = (first == FALSE) && (attributes == FALSE); // starting from second just "peek" into file to get bounding box and count
+      if (!(peek_only && peek_header_block(i)) && !lasreaderlas->open(file_names[i], 512, peek_only))
       {
         laserror("could not open lasreaderlas for file '%s'", file_names[i]);
         return FALSE;
@@ -979,6 +1360,8 @@ BOOL LASreaderMerged::open()
     }
     lasreader->close();
   }
+  header_blocks.clear();
+  header_blocks.shrink_to_fit();
 
   if ((npoints > U32_MAX) && (header.version_minor < 4))
   {
@@ -1411,6 +1794,8 @@ BOOL LASreaderMerged::reopen()
   p_idx = 0;
   p_cnt = 0;
   file_name_current = 0;
+  prefetch_next = 0;
+  if (prefetcher) prefetcher->clear();
   if (inside) inside_none();
   if (filter) filter->reset();
   return TRUE;
@@ -1418,6 +1803,11 @@ BOOL LASreaderMerged::reopen()
 
 void LASreaderMerged::clean()
 {
+  if (prefetcher)
+  {
+    delete prefetcher;
+    prefetcher = 0;
+  }
   if (lasreader)
   {
     delete lasreader;
@@ -1459,6 +1849,12 @@ void LASreaderMerged::clean()
   scale_scan_angle = 1.0f;
   populate_header = FALSE;
   keep_lastiling = FALSE;
+  if (catalog_file_name)
+  {
+    free(catalog_file_name);
+    catalog_file_name = 0;
+  }
+  header_blocks.clear();
 
   if (file_names)
   {
@@ -1507,6 +1903,11 @@ LASreaderMerged::LASreaderMerged(LASreadOpener* opener) :LASreader(opener)
   file_names = 0;
   file_names_ID = 0;
   bounding_boxes = 0;
+  catalog_file_name = 0;
+  header_scan_threads = 1;
+  prefetch_depth = 0;
+  prefetch_next = 0;
+  prefetcher = 0;
   clean();
   gps_transform = FALSE;
 }
@@ -1517,6 +1918,57 @@ LASreaderMerged::~LASreaderMerged()
   clean();
 }
 
+// check if bounding box of file overlaps requested bounding box
+
+BOOL LASreaderMerged::file_is_inside(U32 i) const
+{
+  if (inside < 3) // tile or circle
+  {
+    if (bounding_boxes[4 * i + 0] >= header.max_x) return FALSE;
+    if (bounding_boxes[4 * i + 1] >= header.max_y) return FALSE;
+  }
+  else // rectangle
+  {
+    if (bounding_boxes[4 * i + 0] > header.max_x) return FALSE;
+    if (bounding_boxes[4 * i + 1] > header.max_y) return FALSE;
+  }
+  if (bounding_boxes[4 * i + 2] < header.min_x) return FALSE;
+  if (bounding_boxes[4 * i + 3] < header.min_y) return FALSE;
+  return TRUE;
+}
+
+// hands the next 'prefetch_depth' files that will be opened to the prefetcher
+
+void LASreaderMerged::prefetch_ahead()
+{
+  if (prefetcher == 0)
+  {
+    if (file_name_number < 2) return;
+    try
+    {
+      prefetcher = new LASmergedPrefetcher();
+    }
+    catch (...)
+    {
+      LASMessage(LAS_WARNING, "cannot start prefetching. continuing without.");
+      prefetch_depth = 0;
+      return;
+    }
+  }
+  U32 i = file_name_current;
+  U32 ahead = 0;
+  while ((i < file_name_number) && (ahead < prefetch_depth))
+  {
+    if (filtered_file_number.count(i) == 0 && (!inside || file_is_inside(i)))
+    {
+      if (i >= prefetch_next) prefetcher->add(file_names[i], lasreaderlas != 0);
+      ahead++;
+    }
+    i++;
+  }
+  if (prefetch_next < i) prefetch_next = i;
+}
+
 BOOL LASreaderMerged::open_next_file()
 {
   while (file_name_current < file_name_number)
@@ -1526,45 +1978,10 @@ BOOL LASreaderMerged::open_next_file()
       continue;
     }
 
-    if (inside)
+    if (inside && !file_is_inside(file_name_current))
     {
-      // check if bounding box overlaps requested bounding box
-      if (inside < 3) // tile or circle
-      {
-        if (bounding_boxes[4 * file_name_current + 0] >= header.max_x)
-        {
-          file_name_current++;
-          continue;
-        }
-        if (bounding_boxes[4 * file_name_current + 1] >= header.max_y)
-        {
-          file_name_current++;
-          continue;
-        }
-      }
-      else // rectangle
-      {
-        if (bounding_boxes[4 * file_name_current + 0] > header.max_x)
-        {
-          file_name_current++;
-          continue;
-        }
-        if (bounding_boxes[4 * file_name_current + 1] > header.max_y)
-        {
-          file_name_current++;
-          continue;
-        }
-      }
-      if (bounding_boxes[4 * file_name_current + 2] < header.min_x)
-      {
-        file_name_current++;
-        continue;
-      }
-      if (bounding_boxes[4 * file_name_current + 3] < header.min_y)
-      {
-        file_name_current++;
-        continue;
-      }
+      file_name_current++;
+      continue;
     }
     // open the lasreader with the next file name
     if (lasreaderlas)
@@ -1723,6 +2140,7 @@ BOOL LASreaderMerged::open_next_file()
       transform->setPointSource(lasreader->header.file_source_ID);
     }
     file_name_current++;
+    if (prefetch_depth) prefetch_ahead();
     if (filter) lasreader->set_filter(filter);
     if (transform) lasreader->set_transform(transform);
     if (inside)
@@ -37,6 +37,7 @@
 #include "lastransform.hpp"
 
 #include "laswriter_las.hpp"
+#include "laswriterasync.hpp"
 
 #include <stdlib.h>
 #include <string.h>
@@ -102,7 +103,19 @@ BOOL LASreaderPipeOn::open(LASreader* lasreader)
     return FALSE;
   }
 
-  laswriter = laswriterlas;
+  // the piped points are written to stdout in a separate thread
+
+  LASwriterAsync* laswriterasync = new LASwriterAsync();
+
+  if (laswriterasync->open(laswriterlas, &header))
+  {
+    laswriter = laswriterasync;
+  }
+  else
+  {
+    delete laswriterasync;
+    laswriter = laswriterlas;
+  }
 
   npoints = (header.number_of_point_records ? header.number_of_point_records : header.extended_number_of_point_records);
   p_idx = 0;
@@ -173,9 +186,12 @@ BOOL LASreaderPipeOn::read_point_default()
     if (lasreader->read_point())
     {
       point = lasreader->point;
-      if (laswriter)
+      if (laswriter && !laswriter->write_point(&point))
       {
-        laswriter->write_point(&point);
+        // the writer reports the failure when it is closed
+        laswriter->close();
+        delete laswriter;
+        laswriter = 0;
       }
       p_idx++;
       p_cnt++;
@@ -41,6 +41,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+static const U32 LAS_STORED_POINTS_PER_BLOCK = 65536;
+
 BOOL LASreaderStored::open(LASreader* lasreader)
 {
   if (lasreader == 0)
@@ -77,47 +79,18 @@ BOOL LASreaderStored::open(LASreader* lasreader)
     if (!point.init(&header, header.point_data_format, header.point_data_record_length)) return FALSE;
   }
 
-  // create the stream output array
-
-  if (streamoutarray) delete streamoutarray;
-  streamoutarray = 0;
-
-  if (Endian::IS_LITTLE_ENDIAN)
-    streamoutarray = new ByteStreamOutArrayLE((header.number_of_point_records ? (I64)header.number_of_point_records : header.extended_number_of_point_records)*2);
-  else
-    streamoutarray = new ByteStreamOutArrayBE((header.number_of_point_records ? (I64)header.number_of_point_records : header.extended_number_of_point_records)*2);
-
-  if (streamoutarray == 0)
-  {
-    laserror("allocating streamoutarray");
-    return FALSE;
-  }
-
-  // create the LASwriter
+  // either keep the points uncompressed in memory or compress them into memory
 
-  if (laswriter) delete laswriter;
-  laswriter = 0;
-
-  LASwriterLAS* laswriterlas = new LASwriterLAS();
+  clean_arena();
+  format = lasreader->get_format();
+  arena_budget = (opener ? (I64)opener->get_stored_raw() * 1024 * 1024 : 0);
+  arena = (arena_budget > 0);
 
-  if (laswriterlas == 0)
+  if (!arena)
   {
-    laserror("allocating laswriterlas");
-    return FALSE;
+    if (!open_writer()) return FALSE;
   }
 
-  if (!laswriterlas->open(streamoutarray, &header, LASZIP_COMPRESSOR_DEFAULT))
-  {
-    delete laswriterlas;
-    laswriterlas = 0;
-    laserror("opening laswriterlas to streamoutarray");
-    return FALSE;
-  }
-
-  laswriterlas->set_delete_stream(FALSE);
-
-  laswriter = laswriterlas;
-
   npoints = (header.number_of_point_records ? header.number_of_point_records : header.extended_number_of_point_records);
   p_idx = 0;
   p_cnt = 0;
@@ -127,6 +100,30 @@ BOOL LASreaderStored::open(LASreader* lasreader)
 
 BOOL LASreaderStored::reopen()
 {
+  if (arena)
+  {
+    // the uncompressed points are simply read again from the start
+    if (lasreader)
+    {
+      lasreader->close();
+      delete lasreader;
+      lasreader = 0;
+    }
+    if (header.version_minor >= 4)
+    {
+      header.extended_number_of_point_records = arena_count;
+    }
+    if (header.number_of_point_records || (header.version_minor < 4))
+    {
+      header.number_of_point_records = (arena_count > U32_MAX ? 0 : (U32)arena_count);
+    }
+    npoints = arena_count;
+    arena_index = 0;
+    p_idx = 0;
+    p_cnt = 0;
+    return TRUE;
+  }
+
   if (streaminarray)
   {
     streaminarray->seek(0);
@@ -192,6 +189,140 @@ BOOL LASreaderStored::reopen()
   return TRUE;
 }
 
+BOOL LASreaderStored::open_writer()
+{
+  // create the stream output array
+
+  if (streamoutarray) delete streamoutarray;
+  streamoutarray = 0;
+
+  if (Endian::IS_LITTLE_ENDIAN)
+    streamoutarray = new ByteStreamOutArrayLE((header.number_of_point_records ? (I64)header.number_of_point_records : header.extended_number_of_point_records)*2);
+  else
+    streamoutarray = new ByteStreamOutArrayBE((header.number_of_point_records ? (I64)header.number_of_point_records : header.extended_number_of_point_records)*2);
+
+  if (streamoutarray == 0)
+  {
+    laserror("allocating streamoutarray");
+    return FALSE;
+  }
+
+  // create the LASwriter
+
+  if (laswriter) delete laswriter;
+  laswriter = 0;
+
+  LASwriterLAS* laswriterlas = new LASwriterLAS();
+
+  if (laswriterlas == 0)
+  {
+    laserror("allocating laswriterlas");
+    return FALSE;
+  }
+
+  if (!laswriterlas->open(streamoutarray, &header, LASZIP_COMPRESSOR_DEFAULT))
+  {
+    delete laswriterlas;
+    laswriterlas = 0;
+    laserror("opening laswriterlas to streamoutarray");
+    return FALSE;
+  }
+
+  laswriterlas->set_delete_stream(FALSE);
+
+  laswriter = laswriterlas;
+
+  return TRUE;
+}
+
+// copies the point into the current block or - if this exceeds the budget - into
+// the compressed stream
+
+BOOL LASreaderStored::store_point()
+{
+  if ((arena_count + 1) * point.total_point_size > arena_budget)
+  {
+    if (!compress_arena()) return FALSE;
+    return laswriter->write_point(&point);
+  }
+  U32 index_in_block = (U32)(arena_count % LAS_STORED_POINTS_PER_BLOCK);
+  if (index_in_block == 0)
+  {
+    if (arena_block_number == arena_block_allocated)
+    {
+      U32 allocated = (arena_block_allocated ? 2 * arena_block_allocated : 256);
+      U8** blocks = (U8**)malloc_las(sizeof(U8*) * allocated);
+      if (blocks == 0)
+      {
+        LASMessage(LAS_ERROR, "LASreaderStored: allocating %u blocks of points failed", allocated);
+        return FALSE;
+      }
+      if (arena_blocks)
+      {
+        memcpy(blocks, arena_blocks, sizeof(U8*) * arena_block_allocated);
+        free(arena_blocks);
+      }
+      arena_blocks = blocks;
+      arena_block_allocated = allocated;
+    }
+    arena_blocks[arena_block_number] = (U8*)malloc_las((size_t)point.total_point_size * LAS_STORED_POINTS_PER_BLOCK);
+    if (arena_blocks[arena_block_number] == 0)
+    {
+      LASMessage(LAS_ERROR, "LASreaderStored: allocating block %u of points failed", arena_block_number);
+      return FALSE;
+    }
+    arena_block_number++;
+  }
+  point.copy_to(&(arena_blocks[arena_block_number - 1][(size_t)index_in_block * point.total_point_size]));
+  arena_count++;
+  return TRUE;
+}
+
+// the budget for uncompressed points is exhausted. compress what was stored so far
+// and continue with compressed storage.
+
+BOOL LASreaderStored::compress_arena()
+{
+  LASMessage(LAS_VERBOSE, "LASreaderStored: more than %lld bytes of points. compressing them.", arena_budget);
+  if (!open_writer()) return FALSE;
+  LASpoint stored_point;
+  if (header.laszip)
+  {
+    if (!stored_point.init(&header, header.laszip->num_items, header.laszip->items)) return FALSE;
+  }
+  else
+  {
+    if (!stored_point.init(&header, header.point_data_format, header.point_data_record_length)) return FALSE;
+  }
+  I64 i;
+  for (i = 0; i < arena_count; i++)
+  {
+    stored_point.copy_from(&(arena_blocks[i / LAS_STORED_POINTS_PER_BLOCK][(size_t)(i % LAS_STORED_POINTS_PER_BLOCK) * stored_point.total_point_size]));
+    if (!laswriter->write_point(&stored_point)) return FALSE;
+  }
+  clean_arena();
+  arena = FALSE;
+  return TRUE;
+}
+
+void LASreaderStored::clean_arena()
+{
+  if (arena_blocks)
+  {
+    U32 i;
+    for (i = 0; i < arena_block_number; i++)
+    {
+      free(arena_blocks[i]);
+    }
+    free(arena_blocks);
+    arena_blocks = 0;
+  }
+  arena_block_number = 0;
+  arena_block_allocated = 0;
+  arena_count = 0;
+  arena_index = 0;
+}
+
 void LASreaderStored::set_index(LASindex* index)
 {
   if (lasreader) lasreader->set_index(index);
@@ -205,30 +336,36 @@ LASindex* LASreaderStored::get_index() const
 void LASreaderStored::set_filter(LASfilter* filter)
 {
   if (lasreader) lasreader->set_filter(filter);
+  else if (arena) LASreader::set_filter(filter);
 }
 
 void LASreaderStored::set_transform(LAStransform* transform)
 {
   if (lasreader) lasreader->set_transform(transform);
+  else if (arena) LASreader::set_transform(transform);
 }
 
 BOOL LASreaderStored::inside_tile(const F32 ll_x, const F32 ll_y, const F32 size)
 {
+  if (lasreader == 0 && arena) return LASreader::inside_tile(ll_x, ll_y, size);
   return (lasreader ? lasreader->inside_tile(ll_x, ll_y, size) : FALSE);
 }
 
 BOOL LASreaderStored::inside_circle(const F64 center_x, const F64 center_y, const F64 radius)
 {
+  if (lasreader == 0 && arena) return LASreader::inside_circle(center_x, center_y, radius);
   return (lasreader ? lasreader->inside_circle(center_x, center_y, radius) : FALSE);
 }
 
 BOOL LASreaderStored::inside_rectangle(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y)
 {
+  if (lasreader == 0 && arena) return LASreader::inside_rectangle(min_x, min_y, max_x, max_y);
   return (lasreader ? lasreader->inside_rectangle(min_x, min_y, max_x, max_y) : FALSE);
 }
 
 I32 LASreaderStored::get_format() const
 {
+  if (lasreader == 0 && arena) return format;
   return (lasreader ? lasreader->get_format() : LAS_TOOLS_FORMAT_DEFAULT);
 }
 
@@ -239,9 +376,20 @@ BOOL LASreaderStored::read_point_default()
     if (lasreader->read_point())
     {
       point = lasreader->point;
-      if (laswriter)
+      // a point that cannot be stored would be missing when reading again
+      BOOL stored = TRUE;
+      if (arena)
+      {
+        stored = store_point();
+      }
+      else if (laswriter)
       {
-        laswriter->write_point(&point);
+        stored = laswriter->write_point(&point);
+      }
+      if (!stored)
+      {
+        laserror("LASreaderStored: cannot store point %lld", p_cnt);
+        return FALSE;
       }
       p_idx++;
       p_cnt++;
@@ -251,6 +399,14 @@ BOOL LASreaderStored::read_point_default()
     delete lasreader;
     lasreader = 0;
   }
+  else if (arena && (arena_index < arena_count))
+  {
+    point.copy_from(&(arena_blocks[arena_index / LAS_STORED_POINTS_PER_BLOCK][(size_t)(arena_index % LAS_STORED_POINTS_PER_BLOCK) * point.total_point_size]));
+    arena_index++;
+    p_idx++;
+    p_cnt++;
+    return TRUE;
+  }
   if (laswriter)
   {
     laswriter->close();
@@ -283,6 +439,14 @@ LASreaderStored::LASreaderStored(LASreadOpener* opener) :LASreader(opener)
   laswriter = 0;
   streaminarray = 0;
   streamoutarray = 0;
+  arena = FALSE;
+  format = LAS_TOOLS_FORMAT_DEFAULT;
+  arena_budget = 0;
+  arena_blocks = 0;
+  arena_block_number = 0;
+  arena_block_allocated = 0;
+  arena_count = 0;
+  arena_index = 0;
 }
 
 LASreaderStored::~LASreaderStored()
@@ -292,4 +456,5 @@ LASreaderStored::~LASreaderStored()
   if (laswriter) delete laswriter;
   if (streaminarray) delete streaminarray;
   if (streamoutarray) delete streamoutarray;
+  clean_arena();
 }
@@ -0,0 +1,516 @@
+/*
+===============================================================================
+
+  FILE:  lastranscoder.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+#include "lastranscoder.hpp"
+
+#include "bytestreamin.hpp"
+#include "bytestreamout_array.hpp"
+#include "lasmessage.hpp"
+#include "lasreadpoint.hpp"
+#include "laswritepoint.hpp"
+#include "laswriter_las.hpp"
+#include "laszip.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// the main thread reads the compressed bytes of the input chunks in order into
+// a ring of slots and appends the transcoded chunks to the output in the same
+// order. the workers each own a decoder and an encoder and take the next queued
+// slot. one lock is taken per chunk. with one thread the main thread does all.
+
+#define LAS_TRANSCODER_FREE     0
+#define LAS_TRANSCODER_QUEUED   1
+#define LAS_TRANSCODER_BUSY     2
+#define LAS_TRANSCODER_DONE     3
+#define LAS_TRANSCODER_FAILED   4
+
+struct LAStranscoderSlot
+{
+  U32 state;
+  U32 number;
+  I64 number_by_return[15];
+  std::vector<U8> bytes;
+  ByteStreamOutArray* out;
+};
+
+class LAStranscoderWorker
+{
+public:
+  LASreadPoint reader;
+  LASwritePoint writer;
+  LASpoint point_in;
+  LASpoint point_out;
+  std::vector<U8> points;
+  BOOL transcode(LAStranscoderSlot* slot);
+};
+
+BOOL LAStranscoderWorker::transcode(LAStranscoderSlot* slot)
+{
+  U32 stride = reader.get_chunk_point_stride();
+  const U32* offsets = reader.get_chunk_item_offsets();
+  try
+  {
+    points.resize((size_t)slot->number * stride);
+  }
+  catch (...)
+  {
+    return FALSE;
+  }
+  if (!reader.read_chunk(slot->bytes.data(), (U32)slot->bytes.size(), slot->number, points.data())) return FALSE;
+  // the same conversion of the point attributes as in las2las
+  slot->out->seek(0);
+  if (!writer.init_chunk(slot->out)) return FALSE;
+  U32 i, p;
+  for (i = 0; i < 15; i++) slot->number_by_return[i] = 0;
+  for (p = 0; p < slot->number; p++)
+  {
+    const U8* item = points.data() + (size_t)p * stride;
+    for (i = 0; i < point_in.num_items; i++)
+    {
+      memcpy(point_in.point[i], item + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+    point_out = point_in;
+    if (!writer.write((const U8* const*)point_out.point)) return FALSE;
+    // old headers cannot count returns 6 and higher
+    if (point_out.extended_return_number) slot->number_by_return[point_out.extended_return_number - 1]++;
+  }
+  return writer.done_chunk();
+}
+
+struct LAStranscoderQueue
+{
+  std::vector<LAStranscoderSlot> slots;
+  std::vector<LAStranscoderWorker*> workers;
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable queued;
+  std::condition_variable done;
+  U32 next;
+  BOOL quit;
+};
+
+static void las_transcoder_run(LAStranscoderQueue* queue, LAStranscoderWorker* worker)
+{
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  while (TRUE)
+  {
+    // slots are queued in ring order so the oldest queued one is found first
+    LAStranscoderSlot* slot = 0;
+    U32 n = (U32)queue->slots.size();
+    U32 i;
+    for (i = 0; i < n; i++)
+    {
+      LAStranscoderSlot* s = &(queue->slots[(queue->next + i) % n]);
+      if (s->state == LAS_TRANSCODER_QUEUED)
+      {
+        slot = s;
+        queue->next = (queue->next + i + 1) % n;
+        break;
+      }
+    }
+    if (slot == 0)
+    {
+      if (queue->quit) return;
+      queue->queued.wait(lock);
+      continue;
+    }
+    slot->state = LAS_TRANSCODER_BUSY;
+    lock.unlock();
+    BOOL success = worker->transcode(slot);
+    lock.lock();
+    slot->state = (success ? LAS_TRANSCODER_DONE : LAS_TRANSCODER_FAILED);
+    queue->done.notify_all();
+  }
+}
+
+// the fields of the header that describe the points. they are changed to
+// describe the output while transcoding and restored afterwards.
+
+struct LAStranscoderPointFields
+{
+  U8 version_minor;
+  U16 header_size;
+  U32 offset_to_point_data;
+  U8 point_data_format;
+  U16 point_data_record_length;
+  U32 number_of_point_records;
+  U32 number_of_points_by_return[5];
+  U64 start_of_waveform_data_packet_record;
+  U64 extended_number_of_point_records;
+  U64 extended_number_of_points_by_return[15];
+  void save(const LASheader* header);
+  void restore(LASheader* header) const;
+};
+
+void LAStranscoderPointFields::save(const LASheader* header)
+{
+  version_minor = header->version_minor;
+  header_size = header->header_size;
+  offset_to_point_data = header->offset_to_point_data;
+  point_data_format = header->point_data_format;
+  point_data_record_length = header->point_data_record_length;
+  number_of_point_records = header->number_of_point_records;
+  memcpy(number_of_points_by_return, header->number_of_points_by_return, sizeof(number_of_points_by_return));
+  start_of_waveform_data_packet_record = header->start_of_waveform_data_packet_record;
+  extended_number_of_point_records = header->extended_number_of_point_records;
+  memcpy(extended_number_of_points_by_return, header->extended_number_of_points_by_return, sizeof(extended_number_of_points_by_return));
+}
+
+void LAStranscoderPointFields::restore(LASheader* header) const
+{
+  header->version_minor = version_minor;
+  header->header_size = header_size;
+  header->offset_to_point_data = offset_to_point_data;
+  header->point_data_format = point_data_format;
+  header->point_data_record_length = point_data_record_length;
+  header->number_of_point_records = number_of_point_records;
+  memcpy(header->number_of_points_by_return, number_of_points_by_return, sizeof(number_of_points_by_return));
+  header->start_of_waveform_data_packet_record = start_of_waveform_data_packet_record;
+  header->extended_number_of_point_records = extended_number_of_point_records;
+  memcpy(header->extended_number_of_points_by_return, extended_number_of_points_by_return, sizeof(extended_number_of_points_by_return));
+}
+
+BOOL LAStranscoder::upgrade_header(LASheader* header) const
+{
+  // the record length of the new point type keeps the extra bytes of the old
+  static const U16 base_size[11] = { 20, 28, 26, 34, 57, 63, 30, 36, 38, 59, 67 };
+  static const U8 new_type[11] = { 6, 6, 7, 7, 9, 10, 6, 7, 8, 9, 10 };
+
+  U8 point_type = header->point_data_format;
+  if ((point_type > 10) || (header->point_data_record_length < base_size[point_type]))
+  {
+    laserror("cannot transcode point type %d with point size %d", (I32)point_type, (I32)header->point_data_record_length);
+    return FALSE;
+  }
+  if ((point_type == 4) || (point_type == 5) || (point_type == 9) || (point_type == 10))
+  {
+    if (header->global_encoding & 2)
+    {
+      laserror("cannot transcode LAZ with internally stored waveforms");
+      return FALSE;
+    }
+  }
+  header->point_data_record_length = header->point_data_record_length - base_size[point_type] + base_size[new_type[point_type]];
+  header->point_data_format = new_type[point_type];
+
+  if (header->version_minor < 4)
+  {
+    if (header->version_minor < 3)
+    {
+      header->header_size += 148;
+      header->offset_to_point_data += 148;
+      header->start_of_waveform_data_packet_record = 0;
+    }
+    else
+    {
+      header->header_size += 140;
+      header->offset_to_point_data += 140;
+    }
+    header->version_minor = 4;
+  }
+
+  if (point_type <= 5)
+  {
+    if (header->extended_number_of_point_records == 0)
+    {
+      header->extended_number_of_point_records = header->number_of_point_records;
+    }
+    header->number_of_point_records = 0;
+    U32 i;
+    for (i = 0; i < 5; i++)
+    {
+      if (header->extended_number_of_points_by_return[i] == 0)
+      {
+        header->extended_number_of_points_by_return[i] = header->number_of_points_by_return[i];
+      }
+      header->number_of_points_by_return[i] = 0;
+    }
+  }
+  return TRUE;
+}
+
+BOOL LAStranscoder::transcode(LASreader* lasreader, const LASwriteOpener* laswriteopener, U32 threads)
+{
+  number_chunks = 0;
+  npoints = 0;
+
+  if ((lasreader == 0) || (laswriteopener == 0) || (laswriteopener->get_file_name() == 0))
+  {
+    laserror("transcoding needs a reader and the name of the output file");
+    return FALSE;
+  }
+
+  LASheader* header = &(lasreader->header);
+  ByteStreamIn* stream = lasreader->get_stream();
+  if ((lasreader->get_format() != LAS_TOOLS_FORMAT_LAZ) || (header->laszip == 0) || (stream == 0) || !stream->isSeekable())
+  {
+    laserror("transcoding needs a seekable LAZ file");
+    return FALSE;
+  }
+
+  // the items and the point fields of the input are still needed once the
+  // header describes the output. they go back into the header when done.
+
+  LAStranscoderPointFields input_fields;
+  input_fields.save(header);
+  LASzip* laszip = header->laszip;
+  LASreadPoint reader;
+  if (!reader.setup(laszip->num_items, laszip->items, laszip) || !reader.init(stream) || !reader.init_chunks(lasreader->npoints))
+  {
+    laserror("transcoding needs a LAZ file with a complete chunk table");
+    return FALSE;
+  }
+  header->laszip = 0;
+
+  // the output keeps the chunk boundaries of the input
+
+  U32 chunk_size = reader.get_chunk_size();
+  U32 total = reader.get_number_chunks();
+
+  LASwriterLAS* laswriterlas = 0;
+  BOOL opened = FALSE;
+  LAStranscoderQueue queue;
+  I64 number_by_return[15] = { 0 };
+  BOOL success = upgrade_header(header);
+  if (success)
+  {
+    laswriterlas = new LASwriterLAS();
+    success = laswriterlas->open(laswriteopener->get_file_name(), header, LASZIP_COMPRESSOR_LAYERED_CHUNKED, laswriteopener->get_requested_version(), (chunk_size == U32_MAX ? 0 : (I32)chunk_size), laswriteopener->get_io_obuffer_size());
+    if (!success)
+    {
+      laserror("cannot open '%s' for transcoding", laswriteopener->get_file_name());
+    }
+    else
+    {
+      opened = TRUE;
+      if (laswriteopener->get_chunk_checksums())
+      {
+        laswriterlas->set_chunk_checksums();
+      }
+    }
+  }
+
+  if (success)
+  {
+    U32 w, count = (threads > 1 ? threads : 1);
+    for (w = 0; (w < count) && success; w++)
+    {
+      LAStranscoderWorker* worker = new LAStranscoderWorker();
+      queue.workers.push_back(worker);
+      success = worker->reader.setup(laszip->num_items, laszip->items, laszip) && laswriterlas->setup_chunk_writer(&worker->writer)
+        && worker->point_in.init(header, laszip->num_items, laszip->items, header)
+        && worker->point_out.init(header, header->point_data_format, header->point_data_record_length, header);
+    }
+    if (!success)
+    {
+      LASMessage(LAS_ERROR, "cannot set up transcoding of point type %d", (I32)header->point_data_format);
+    }
+    else
+    {
+      queue.slots.resize(2 * count);
+      for (w = 0; w < queue.slots.size(); w++)
+      {
+        queue.slots[w].state = LAS_TRANSCODER_FREE;
+        queue.slots[w].number = 0;
+        queue.slots[w].out = (Endian::IS_LITTLE_ENDIAN ? (ByteStreamOutArray*)new ByteStreamOutArrayLE() : (ByteStreamOutArray*)new ByteStreamOutArrayBE());
+      }
+      queue.next = 0;
+      queue.quit = FALSE;
+      if (count > 1)
+      {
+        try
+        {
+          for (w = 0; w < count; w++)
+          {
+            queue.threads.push_back(std::thread(las_transcoder_run, &queue, queue.workers[w]));
+          }
+        }
+        catch (...)
+        {
+          LASMessage(LAS_WARNING, "could only start %u of %u transcoding threads", (U32)queue.threads.size(), count);
+        }
+      }
+    }
+  }
+
+  // read chunks into free slots and write the transcoded ones in order
+
+  if (success)
+  {
+    U32 i, n = (U32)queue.slots.size();
+    U32 read = 0;
+    U32 head = 0;
+    U32 tail = 0;
+    U32 filled = 0;
+    while (success && (number_chunks < total))
+    {
+      while ((filled < n) && (read < total))
+      {
+        LAStranscoderSlot* slot = &(queue.slots[head]);
+        slot->number = reader.get_chunk_number_of_points(read);
+        if (slot->number == 0)
+        {
+          total = read;
+          break;
+        }
+        I64 start = reader.get_chunk_start(read);
+        I64 end = reader.get_chunk_start(read + 1);
+        try
+        {
+          slot->bytes.resize((size_t)(end - start));
+          if (!stream->seek(start)) throw 1;
+          stream->getBytes(slot->bytes.data(), (U32)(end - start));
+        }
+        catch (...)
+        {
+          LASMessage(LAS_ERROR, "cannot read chunk %u of %u", read, total);
+          success = FALSE;
+          break;
+        }
+        if (queue.threads.size() == 0)
+        {
+          slot->state = (queue.workers[0]->transcode(slot) ? LAS_TRANSCODER_DONE : LAS_TRANSCODER_FAILED);
+        }
+        else
+        {
+          std::lock_guard<std::mutex> lock(queue.mutex);
+          slot->state = LAS_TRANSCODER_QUEUED;
+          queue.queued.notify_one();
+        }
+        head = (head + 1) % n;
+        read++;
+        filled++;
+      }
+      if (!success || (filled == 0)) break;
+
+      LAStranscoderSlot* slot = &(queue.slots[tail]);
+      {
+        std::unique_lock<std::mutex> lock(queue.mutex);
+        while ((slot->state != LAS_TRANSCODER_DONE) && (slot->state != LAS_TRANSCODER_FAILED))
+        {
+          queue.done.wait(lock);
+        }
+      }
+      if (slot->state == LAS_TRANSCODER_FAILED)
+      {
+        LASMessage(LAS_ERROR, "cannot transcode chunk %u of %u", number_chunks, total);
+        success = FALSE;
+        break;
+      }
+      if (!laswriterlas->write_chunk(slot->out->getData(), (U32)slot->out->getCurr(), slot->number))
+      {
+        LASMessage(LAS_ERROR, "cannot write chunk %u of %u", number_chunks, total);
+        success = FALSE;
+        break;
+      }
+      npoints += slot->number;
+      for (i = 0; i < 15; i++) number_by_return[i] += slot->number_by_return[i];
+      number_chunks++;
+      slot->state = LAS_TRANSCODER_FREE;
+      tail = (tail + 1) % n;
+      filled--;
+    }
+  }
+
+  // stop the workers
+
+  if (queue.threads.size())
+  {
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.quit = TRUE;
+      U32 i;
+      for (i = 0; i < queue.slots.size(); i++)
+      {
+        if (queue.slots[i].state == LAS_TRANSCODER_QUEUED) queue.slots[i].state = LAS_TRANSCODER_FREE;
+      }
+      queue.queued.notify_all();
+    }
+    U32 i;
+    for (i = 0; i < queue.threads.size(); i++)
+    {
+      queue.threads[i].join();
+    }
+  }
+  U32 i;
+  for (i = 0; i < queue.slots.size(); i++)
+  {
+    delete queue.slots[i].out;
+  }
+  for (i = 0; i < queue.workers.size(); i++)
+  {
+    delete queue.workers[i];
+  }
+
+  if (laswriterlas)
+  {
+    if (success && (npoints != (I64)lasreader->npoints))
+    {
+      LASMessage(LAS_WARNING, "transcoded %lld points but header of input had %lld", npoints, lasreader->npoints);
+    }
+    if (success)
+    {
+      header->extended_number_of_point_records = npoints;
+      for (i = 0; i < 15; i++) header->extended_number_of_points_by_return[i] = number_by_return[i];
+      laswriterlas->update_header(header);
+    }
+    laswriterlas->close();
+    delete laswriterlas;
+  }
+  reader.done();
+  input_fields.restore(header);
+  header->laszip = laszip;
+
+  // a partially transcoded file must not be mistaken for a result. the errors
+  // after opening it were only reported so that it can be removed here first.
+
+  if (opened && !success)
+  {
+    remove(laswriteopener->get_file_name());
+    laserror("removed incomplete output '%s'", laswriteopener->get_file_name());
+  }
+  return success;
+}
+
+LAStranscoder::LAStranscoder()
+{
+  number_chunks = 0;
+  npoints = 0;
+}
+
+LAStranscoder::~LAStranscoder()
+{
+}
@@ -108,6 +108,118 @@ BOOL LASinventory::add(const LASpoint* point)
   return TRUE;
 }
 
+// adds a block of point records as they are stored in a LAS file (or as they
+// are produced by LASpoint::copy_to()) with the layout of the point type. the
+// loop is branchless and keeps the bounds in local variables.
+
+BOOL LASinventory::add(const U8* points, U32 number, U32 point_size, U8 point_data_format)
+{
+  if ((points == 0) || (number == 0)) return (number == 0);
+  point_data_format &= 63;
+  if (point_data_format > 10) return FALSE;
+  const BOOL extended = (point_data_format >= 6);
+  const U8 return_mask = (extended ? 15 : 7);
+  I32 gps_time_offset = -1;
+  if (extended) gps_time_offset = 22;
+  else if ((point_data_format == 1) || (point_data_format >= 3)) gps_time_offset = 20;
+
+  I32 XYZ[3];
+  F64 gps_time = 0;
+  memcpy(XYZ, points, 12);
+  if (gps_time_offset > 0) memcpy(&gps_time, points + gps_time_offset, 8);
+  I32 lmin_X = XYZ[0], lmax_X = XYZ[0];
+  I32 lmin_Y = XYZ[1], lmax_Y = XYZ[1];
+  I32 lmin_Z = XYZ[2], lmax_Z = XYZ[2];
+  F64 lmin_gps_time = gps_time, lmax_gps_time = gps_time;
+  I64 by_return[16] = {0};
+
+  U32 i;
+  const U8* point = points;
+  for (i = 0; i < number; i++, point += point_size)
+  {
+    memcpy(XYZ, point, 12);
+    lmin_X = (XYZ[0] < lmin_X ? XYZ[0] : lmin_X);
+    lmax_X = (XYZ[0] > lmax_X ? XYZ[0] : lmax_X);
+    lmin_Y = (XYZ[1] < lmin_Y ? XYZ[1] : lmin_Y);
+    lmax_Y = (XYZ[1] > lmax_Y ? XYZ[1] : lmax_Y);
+    lmin_Z = (XYZ[2] < lmin_Z ? XYZ[2] : lmin_Z);
+    lmax_Z = (XYZ[2] > lmax_Z ? XYZ[2] : lmax_Z);
+    by_return[point[14] & return_mask]++;
+  }
+  if (gps_time_offset > 0)
+  {
+    point = points + gps_time_offset;
+    for (i = 0; i < number; i++, point += point_size)
+    {
+      memcpy(&gps_time, point, 8);
+      lmin_gps_time = (gps_time < lmin_gps_time ? gps_time : lmin_gps_time);
+      lmax_gps_time = (gps_time > lmax_gps_time ? gps_time : lmax_gps_time);
+    }
+  }
+
+  extended_number_of_point_records += number;
+  for (i = 0; i < 16; i++) extended_number_of_points_by_return[i] += by_return[i];
+  if (first)
+  {
+    min_X = lmin_X; max_X = lmax_X;
+    min_Y = lmin_Y; max_Y = lmax_Y;
+    min_Z = lmin_Z; max_Z = lmax_Z;
+    if (gps_time_offset > 0)
+    {
+      min_gps_time = lmin_gps_time;
+      max_gps_time = lmax_gps_time;
+    }
+    first = FALSE;
+  }
+  else
+  {
+    if (lmin_X < min_X) min_X = lmin_X;
+    if (lmax_X > max_X) max_X = lmax_X;
+    if (lmin_Y < min_Y) min_Y = lmin_Y;
+    if (lmax_Y > max_Y) max_Y = lmax_Y;
+    if (lmin_Z < min_Z) min_Z = lmin_Z;
+    if (lmax_Z > max_Z) max_Z = lmax_Z;
+    if (gps_time_offset > 0)
+    {
+      if (lmin_gps_time < min_gps_time) min_gps_time = lmin_gps_time;
+      if (lmax_gps_time > max_gps_time) max_gps_time = lmax_gps_time;
+    }
+  }
+  return TRUE;
+}
+
+// merges an inventory that was collected separately (e.g. by another thread)
+
+BOOL LASinventory::merge(const LASinventory* inventory)
+{
+  if (inventory == 0) return FALSE;
+  if (inventory->first) return TRUE;
+  U32 i;
+  extended_number_of_point_records += inventory->extended_number_of_point_records;
+  for (i = 0; i < 16; i++) extended_number_of_points_by_return[i] += inventory->extended_number_of_points_by_return[i];
+  if (first)
+  {
+    min_X = inventory->min_X; max_X = inventory->max_X;
+    min_Y = inventory->min_Y; max_Y = inventory->max_Y;
+    min_Z = inventory->min_Z; max_Z = inventory->max_Z;
+    min_gps_time = inventory->min_gps_time;
+    max_gps_time = inventory->max_gps_time;
+    first = FALSE;
+  }
+  else
+  {
+    if (inventory->min_X < min_X) min_X = inventory->min_X;
+    if (inventory->max_X > max_X) max_X = inventory->max_X;
+    if (inventory->min_Y < min_Y) min_Y = inventory->min_Y;
+    if (inventory->max_Y > max_Y) max_Y = inventory->max_Y;
+    if (inventory->min_Z < min_Z) min_Z = inventory->min_Z;
+    if (inventory->max_Z > max_Z) max_Z = inventory->max_Z;
+    if (inventory->min_gps_time < min_gps_time) min_gps_time = inventory->min_gps_time;
+    if (inventory->max_gps_time > max_gps_time) max_gps_time = inventory->max_gps_time;
+  }
+  return TRUE;
+}
+
 BOOL LASinventory::update_header(LASheader* header) const
 {
   if (header)
@@ -0,0 +1,304 @@
+/*
+===============================================================================
+
+  FILE:  lasverifier.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+#include "lasverifier.hpp"
+
+#include "bytestreamin.hpp"
+#include "lasmessage.hpp"
+#include "lasreadpoint.hpp"
+#include "lasvlr.hpp"
+#include "laszip.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// the threads take the next chunk and read its compressed bytes while holding
+// the lock so that the stream is only used by one of them at a time. they check
+// the chunk without the lock and count it as failed if it does not verify.
+
+struct LASverifierJob
+{
+  std::mutex mutex;
+  ByteStreamIn* stream;
+  const LASreadPoint* table;
+  const U32* checksums;
+  BOOL decode;
+  U32 next;
+  U32 total;
+  U32 number_failed;
+  U32 first_failed;
+};
+
+class LASverifierWorker
+{
+public:
+  LASreadPoint reader;
+  std::vector<U8> bytes;
+  std::vector<U8> points;
+};
+
+static void las_verifier_run(LASverifierJob* job, LASverifierWorker* worker)
+{
+  while (TRUE)
+  {
+    U32 chunk;
+    U32 number;
+    BOOL success = TRUE;
+    {
+      std::lock_guard<std::mutex> lock(job->mutex);
+      if (job->next >= job->total) return;
+      chunk = job->next++;
+      number = job->table->get_chunk_number_of_points(chunk);
+      I64 start = job->table->get_chunk_start(chunk);
+      I64 end = job->table->get_chunk_start(chunk + 1);
+      try
+      {
+        if (end <= start) throw 1;
+        worker->bytes.resize((size_t)(end - start));
+        if (!job->stream->seek(start)) throw 1;
+        job->stream->getBytes(worker->bytes.data(), (U32)(end - start));
+      }
+      catch (...)
+      {
+        success = FALSE;
+      }
+    }
+    if (success && job->checksums)
+    {
+      success = (crc32_las(0, worker->bytes.data(), worker->bytes.size()) == job->checksums[chunk]);
+    }
+    if (success && job->decode && number)
+    {
+      try
+      {
+        worker->points.resize((size_t)number * worker->reader.get_chunk_point_stride());
+        success = worker->reader.read_chunk(worker->bytes.data(), (U32)worker->bytes.size(), number, worker->points.data());
+      }
+      catch (...)
+      {
+        success = FALSE;
+      }
+    }
+    if (!success)
+    {
+      std::lock_guard<std::mutex> lock(job->mutex);
+      if ((job->number_failed == 0) || (chunk < job->first_failed)) job->first_failed = chunk;
+      job->number_failed++;
+    }
+  }
+}
+
+BOOL LASverifier::read_checksums(ByteStreamIn* stream)
+{
+  I64 here = stream->tell();
+  try
+  {
+    // the EVLR is last but comes before a trailer of streamed output
+    I64 distance = 0;
+    CHAR user_id[16];
+    U16 record_id;
+    if (stream->seekEnd(60 + LAS_TOOLS_STREAM_TRAILER_PAYLOAD))
+    {
+      stream->skipBytes(2);
+      stream->getBytes((U8*)user_id, 16);
+      stream->get16bitsLE((U8*)&record_id);
+      if ((strncmp(user_id, "LAStools", 16) == 0) && (record_id == LAS_TOOLS_STREAM_TRAILER_RECORD_ID))
+      {
+        distance = 60 + LAS_TOOLS_STREAM_TRAILER_PAYLOAD;
+      }
+    }
+    if (!stream->seekEnd(distance + 8)) throw 1;
+    I64 start;
+    stream->get64bitsLE((U8*)&start);
+    I64 end = stream->tell();
+    if ((start < 0) || ((start + 60 + 4 + 8) > end)) throw 1;
+    if (!stream->seek(start)) throw 1;
+    stream->skipBytes(2);
+    stream->getBytes((U8*)user_id, 16);
+    stream->get16bitsLE((U8*)&record_id);
+    I64 record_length_after_header;
+    stream->get64bitsLE((U8*)&record_length_after_header);
+    if ((strncmp(user_id, "LAStools", 16) != 0) || (record_id != LAS_TOOLS_CHUNK_CHECKSUMS_RECORD_ID) || (record_length_after_header != (end - start - 60))) throw 1;
+    stream->skipBytes(32);
+    U32 number;
+    stream->get32bitsLE((U8*)&number);
+    if ((4 + 4 * (I64)number + 8) != record_length_after_header) throw 1;
+    checksums = (U32*)malloc_las(sizeof(U32) * (number ? number : 1));
+    if (checksums == 0) throw 1;
+    U32 i;
+    for (i = 0; i < number; i++)
+    {
+      stream->get32bitsLE((U8*)&(checksums[i]));
+    }
+    number_checksums = number;
+  }
+  catch (...)
+  {
+    if (checksums) free(checksums);
+    checksums = 0;
+    number_checksums = 0;
+  }
+  stream->seek(here);
+  return (checksums != 0);
+}
+
+BOOL LASverifier::verify(LASreader* lasreader, BOOL use_checksums, BOOL decode, U32 threads)
+{
+  if (this->checksums) free(this->checksums);
+  this->checksums = 0;
+  number_checksums = 0;
+  number_chunks = 0;
+  number_failed = 0;
+  first_failed = 0;
+  decoded = FALSE;
+
+  if (lasreader == 0)
+  {
+    laserror("verification needs a reader");
+    return FALSE;
+  }
+
+  LASheader* header = &(lasreader->header);
+  ByteStreamIn* stream = lasreader->get_stream();
+  if ((lasreader->get_format() != LAS_TOOLS_FORMAT_LAZ) || (header->laszip == 0) || (stream == 0) || !stream->isSeekable())
+  {
+    laserror("verification needs a seekable LAZ file");
+    return FALSE;
+  }
+
+  LASzip* laszip = header->laszip;
+  LASreadPoint table;
+  if (!table.setup(laszip->num_items, laszip->items, laszip) || !table.init(stream) || !table.init_chunks(lasreader->npoints))
+  {
+    laserror("verification needs a LAZ file with a complete chunk table");
+    return FALSE;
+  }
+  number_chunks = table.get_number_chunks();
+
+  if (use_checksums && read_checksums(stream))
+  {
+    if (number_checksums != number_chunks)
+    {
+      LASMessage(LAS_WARNING, "%u chunk checksums for %u chunks", number_checksums, number_chunks);
+      number_failed = number_chunks;
+      table.done();
+      return TRUE;
+    }
+  }
+  if (this->checksums == 0)
+  {
+    // without checksums the chunks can only be verified by decoding them
+    decode = TRUE;
+  }
+  decoded = decode;
+
+  LASverifierJob job;
+  job.stream = stream;
+  job.table = &table;
+  job.checksums = this->checksums;
+  job.decode = decode;
+  job.next = 0;
+  job.total = number_chunks;
+  job.number_failed = 0;
+  job.first_failed = 0;
+
+  U32 w, count = (threads > 1 ? threads : 1);
+  std::vector<LASverifierWorker*> workers;
+  BOOL success = TRUE;
+  for (w = 0; (w < count) && success; w++)
+  {
+    LASverifierWorker* worker = new LASverifierWorker();
+    workers.push_back(worker);
+    if (decode) success = worker->reader.setup(laszip->num_items, laszip->items, laszip);
+  }
+
+  if (success)
+  {
+    if (count == 1)
+    {
+      las_verifier_run(&job, workers[0]);
+    }
+    else
+    {
+      std::vector<std::thread> pool;
+      try
+      {
+        for (w = 0; w < count; w++)
+        {
+          pool.push_back(std::thread(las_verifier_run, &job, workers[w]));
+        }
+      }
+      catch (...)
+      {
+        LASMessage(LAS_WARNING, "could only start %u of %u verification threads", (U32)pool.size(), count);
+      }
+      if (pool.size() == 0)
+      {
+        las_verifier_run(&job, workers[0]);
+      }
+      for (w = 0; w < pool.size(); w++)
+      {
+        pool[w].join();
+      }
+    }
+    number_failed = job.number_failed;
+    first_failed = job.first_failed;
+  }
+  else
+  {
+    laserror("cannot set up decoding of point type %d", (I32)header->point_data_format);
+  }
+
+  for (w = 0; w < workers.size(); w++)
+  {
+    delete workers[w];
+  }
+  table.done();
+  return success;
+}
+
+LASverifier::LASverifier()
+{
+  number_checksums = 0;
+  checksums = 0;
+  number_chunks = 0;
+  number_failed = 0;
+  first_failed = 0;
+  decoded = FALSE;
+}
+
+LASverifier::~LASverifier()
+{
+  if (checksums) free(checksums);
+}
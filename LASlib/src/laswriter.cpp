@@ -36,6 +36,8 @@
 #include "laswriter_qfit.hpp"
 #include "laswriter_wrl.hpp"
 #include "laswriter_txt.hpp"
+#include "laswriterasync.hpp"
+#include "bytestream_shm.hpp"
 
 #include <stdlib.h>
 #include <string.h>
@@ -49,10 +51,45 @@ void LASwriter::dealloc()
 
 BOOL LASwriteOpener::is_piped() const
 {
-  return ((file_name == 0) && use_stdout);
+  return ((file_name == 0) && (use_stdout || shm_name));
 }
 
 LASwriter* LASwriteOpener::open(const LASheader* header)
+{
+  LASwriter* laswriter = open_writer(header);
+  if (laswriter && async)
+  {
+    LASwriterAsync* laswriterasync = new LASwriterAsync();
+    if (laswriterasync->open(laswriter, header))
+    {
+      return laswriterasync;
+    }
+    LASMessage(LAS_WARNING, "cannot start writer thread. writing synchronously");
+    delete laswriterasync;
+  }
+  return laswriter;
+}
+
+// the chunking strategies need variable chunks, which LASzip only supports
+// for the point types of LAS 1.4
+
+BOOL LASwriteOpener::use_chunking(const LASheader* header) const
+{
+  if ((chunking == LAS_WRITER_CHUNKING_NONE) || (format != LAS_TOOLS_FORMAT_LAZ)) return FALSE;
+  if (header->point_data_format <= 5)
+  {
+    LASMessage(LAS_WARNING, "chunking by cell, GPS time, or bytes needs point type 6 or higher but not %d. using chunk size %u", header->point_data_format, chunk_size);
+    return FALSE;
+  }
+  if (!native)
+  {
+    LASMessage(LAS_WARNING, "chunking by cell, GPS time, or bytes needs the native LAS 1.4 extension. using chunk size %u", chunk_size);
+    return FALSE;
+  }
+  return TRUE;
+}
+
+LASwriter* LASwriteOpener::open_writer(const LASheader* header)
 {
   if (use_nil)
   {
@@ -69,13 +106,20 @@ LASwriter* LASwriteOpener::open(const LASheader* header)
   {
     if (format <= LAS_TOOLS_FORMAT_LAZ)
     {
+      BOOL chunked = use_chunking(header);
       LASwriterLAS* laswriterlas = new LASwriterLAS();
-      if (!laswriterlas->open(file_name, header, (format == LAS_TOOLS_FORMAT_LAZ ? (native ? LASZIP_COMPRESSOR_LAYERED_CHUNKED : LASZIP_COMPRESSOR_CHUNKED) : LASZIP_COMPRESSOR_NONE), requested_version, chunk_size, io_obuffer_size))
+      if (!laswriterlas->open(file_name, header, (format == LAS_TOOLS_FORMAT_LAZ ? (native ? LASZIP_COMPRESSOR_LAYERED_CHUNKED : LASZIP_COMPRESSOR_CHUNKED) : LASZIP_COMPRESSOR_NONE), requested_version, (chunked ? 0 : chunk_size), io_obuffer_size))
       {
         laserror("cannot open laswriterlas with file name '%s'", file_name);
         delete laswriterlas;
         return 0;
       }
+      if (chunked && !laswriterlas->set_chunking(chunking, chunking_value, chunk_size, header))
+      {
+        delete laswriterlas;
+        return 0;
+      }
+      if (chunk_checksums && (format == LAS_TOOLS_FORMAT_LAZ)) laswriterlas->set_chunk_checksums();
       return laswriterlas;
     }
     else if (format == LAS_TOOLS_FORMAT_TXT)
@@ -131,17 +175,67 @@ LASwriter* LASwriteOpener::open(const LASheader* header)
       return 0;
     }
   }
+  else if (shm_name)
+  {
+    if (format <= LAS_TOOLS_FORMAT_LAZ)
+    {
+      ByteStreamOutSHM* out = new ByteStreamOutSHM();
+      if (!out->open(shm_name))
+      {
+        laserror("cannot create shared memory stream '%s'", shm_name);
+        delete out;
+        return 0;
+      }
+      BOOL chunked = use_chunking(header);
+      LASwriterLAS* laswriterlas = new LASwriterLAS();
+      if (!laswriterlas->open(out, header, (format == LAS_TOOLS_FORMAT_LAZ ? (native ? LASZIP_COMPRESSOR_LAYERED_CHUNKED : LASZIP_COMPRESSOR_CHUNKED) : LASZIP_COMPRESSOR_NONE), requested_version, (chunked ? 0 : chunk_size)))
+      {
+        laserror("cannot open laswriterlas to shared memory stream '%s'", shm_name);
+        delete laswriterlas;
+        return 0;
+      }
+      if (chunked && !laswriterlas->set_chunking(chunking, chunking_value, chunk_size, header))
+      {
+        delete laswriterlas;
+        return 0;
+      }
+      if (chunk_checksums && (format == LAS_TOOLS_FORMAT_LAZ)) laswriterlas->set_chunk_checksums();
+      if (stream_trailer && !laswriterlas->set_stream_trailer(header))
+      {
+        delete laswriterlas;
+        return 0;
+      }
+      return laswriterlas;
+    }
+    else
+    {
+      laserror("only LAS or LAZ can be streamed through shared memory, not format %d", format);
+      return 0;
+    }
+  }
   else if (use_stdout)
   {
     if (format <= LAS_TOOLS_FORMAT_LAZ)
     {
+      BOOL chunked = use_chunking(header);
       LASwriterLAS* laswriterlas = new LASwriterLAS();
-      if (!laswriterlas->open(stdout, header, (format == LAS_TOOLS_FORMAT_LAZ ? (native ? LASZIP_COMPRESSOR_LAYERED_CHUNKED : LASZIP_COMPRESSOR_CHUNKED) : LASZIP_COMPRESSOR_NONE), requested_version, chunk_size))
+      if (!laswriterlas->open(stdout, header, (format == LAS_TOOLS_FORMAT_LAZ ? (native ? LASZIP_COMPRESSOR_LAYERED_CHUNKED : LASZIP_COMPRESSOR_CHUNKED) : LASZIP_COMPRESSOR_NONE), requested_version, (chunked ? 0 : chunk_size)))
       {
         laserror("cannot open laswriterlas to stdout");
         delete laswriterlas;
         return 0;
       }
+      if (chunked && !laswriterlas->set_chunking(chunking, chunking_value, chunk_size, header))
+      {
+        delete laswriterlas;
+        return 0;
+      }
+      if (chunk_checksums && (format == LAS_TOOLS_FORMAT_LAZ)) laswriterlas->set_chunk_checksums();
+      if (stream_trailer && !laswriterlas->set_stream_trailer(header))
+      {
+        delete laswriterlas;
+        return 0;
+      }
       return laswriterlas;
     }
     else if (format == LAS_TOOLS_FORMAT_TXT)
@@ -232,7 +326,17 @@ void LASwriteOpener::usage() const
                        "  -ocut 2 (cut the last two characters from name)\n" \
                        "  -olas -olaz -otxt -obin -oqi (specify format)\n" \
                        "  -stdout (pipe to stdout)\n" \
-                       "  -nil    (pipe to NULL)\n", DIRECTORY_SLASH, DIRECTORY_SLASH);
+                       "  -nil    (pipe to NULL)\n" \
+                       "  -ostream_shm name (pipe through shared memory)\n" \
+                       "  -stream_trailer (piped LAS/LAZ 1.4 ends with the final header values and chunk table start)\n" \
+                       "  -chunk_checksums (LAZ ends with an EVLR holding the CRC-32 of every chunk)\n" \
+                       "  -laz_level fast (faster LAZ compression of point types 6 and higher at a lower ratio)\n" \
+                       "  -laz_level max (better LAZ compression of point types 6 and higher, a bit slower)\n" \
+                       "  -laz_level default (standard LAZ compression, e.g. to undo an earlier '-laz_level')\n" \
+                       "  -chunk_by_cell 100 (LAZ chunks do not cross cells of 100 units of points sorted by cell)\n" \
+                       "  -chunk_by_gps_time 10 (LAZ chunks do not cross 10 second windows)\n" \
+                       "  -chunk_by_bytes 1000000 (LAZ chunks of about one million bytes)\n" \
+                       "  -async_write (compress and write in separate thread)\n", DIRECTORY_SLASH, DIRECTORY_SLASH);
 }
 
 BOOL LASwriteOpener::parse(int argc, char* argv[])
@@ -361,14 +465,28 @@ BOOL LASwriteOpener::parse(int argc, char* argv[])
     {
       use_stdout = TRUE;
       use_nil = FALSE;
+      set_shm_name(0);
       *argv[i]='\0';
     }
     else if (strcmp(argv[i],"-nil") == 0)
     {
       use_nil = TRUE;
       use_stdout = FALSE;
+      set_shm_name(0);
       *argv[i]='\0';
     }
+    else if (strcmp(argv[i],"-ostream_shm") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        laserror("'%s' needs 1 argument: name", argv[i]);
+        return FALSE;
+      }
+      set_shm_name(argv[i+1]);
+      use_stdout = FALSE;
+      use_nil = FALSE;
+      *argv[i]='\0'; *argv[i+1]='\0'; i+=1;
+    }
     else if (strcmp(argv[i],"-chunk_size") == 0)
     {
       if ((i+1) >= argc)
@@ -379,6 +497,80 @@ BOOL LASwriteOpener::parse(int argc, char* argv[])
       set_chunk_size(atoi(argv[i+1]));
       *argv[i]='\0'; *argv[i+1]='\0'; i+=1;
     }
+    else if (strcmp(argv[i],"-laz_level") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        laserror("'%s' needs 1 argument: fast, default, or max", argv[i]);
+        return FALSE;
+      }
+      if (strcmp(argv[i+1],"fast") == 0)
+      {
+        set_requested_version(LASZIP_POINT14_VERSION_FAST);
+      }
+      else if (strcmp(argv[i+1],"max") == 0)
+      {
+        set_requested_version(LASZIP_POINT14_VERSION_MAX);
+      }
+      else if (strcmp(argv[i+1],"default") == 0)
+      {
+        set_requested_version(0);
+      }
+      else
+      {
+        laserror("'%s' needs 1 argument: fast, default, or max but '%s' is not valid", argv[i], argv[i+1]);
+        return FALSE;
+      }
+      *argv[i]='\0'; *argv[i+1]='\0'; i+=1;
+    }
+    else if (strcmp(argv[i],"-chunk_by_cell") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        laserror("'%s' needs 1 argument: cell_size", argv[i]);
+        return FALSE;
+      }
+      F64 value;
+      if ((sscanf(argv[i+1], "%lf", &value) != 1) || (value <= 0))
+      {
+        laserror("'%s' needs 1 argument: cell_size but '%s' is not valid", argv[i], argv[i+1]);
+        return FALSE;
+      }
+      set_chunking(LAS_WRITER_CHUNKING_CELL, value);
+      *argv[i]='\0'; *argv[i+1]='\0'; i+=1;
+    }
+    else if (strcmp(argv[i],"-chunk_by_gps_time") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        laserror("'%s' needs 1 argument: seconds", argv[i]);
+        return FALSE;
+      }
+      F64 value;
+      if ((sscanf(argv[i+1], "%lf", &value) != 1) || (value <= 0))
+      {
+        laserror("'%s' needs 1 argument: seconds but '%s' is not valid", argv[i], argv[i+1]);
+        return FALSE;
+      }
+      set_chunking(LAS_WRITER_CHUNKING_GPS_TIME, value);
+      *argv[i]='\0'; *argv[i+1]='\0'; i+=1;
+    }
+    else if (strcmp(argv[i],"-chunk_by_bytes") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        laserror("'%s' needs 1 argument: bytes", argv[i]);
+        return FALSE;
+      }
+      F64 value;
+      if ((sscanf(argv[i+1], "%lf", &value) != 1) || (value <= 0))
+      {
+        laserror("'%s' needs 1 argument: bytes but '%s' is not valid", argv[i], argv[i+1]);
+        return FALSE;
+      }
+      set_chunking(LAS_WRITER_CHUNKING_BYTES, value);
+      *argv[i]='\0'; *argv[i+1]='\0'; i+=1;
+    }
     else if (strcmp(argv[i],"-oparse") == 0)
     {
       if ((i+1) >= argc)
@@ -429,6 +621,21 @@ BOOL LASwriteOpener::parse(int argc, char* argv[])
       set_io_obuffer_size((I32)atoi(argv[i+1]));
       *argv[i]='\0'; *argv[i+1]='\0'; i+=1;
     }
+    else if (strcmp(argv[i],"-async_write") == 0)
+    {
+      set_async(TRUE);
+      *argv[i]='\0';
+    }
+    else if (strcmp(argv[i],"-stream_trailer") == 0)
+    {
+      set_stream_trailer(TRUE);
+      *argv[i]='\0';
+    }
+    else if (strcmp(argv[i],"-chunk_checksums") == 0)
+    {
+      set_chunk_checksums(TRUE);
+      *argv[i]='\0';
+    }
   }
   return TRUE;
 }
@@ -843,6 +1050,7 @@ void LASwriteOpener::set_force(BOOL force)
 // current default item version: 2 for point types 0-5, 3 for point types 6-10 (will be automatically selected. 
 // using version 4 is for the new, slightly fixed encoding of point types 6-10 
 // (not the default, so the supporting software can be spread first, along with LAS 1.5)
+// versions 5 and 6 are version 4 with the fast and the max modeling level for point types 6-10
 void LASwriteOpener::set_requested_version(U32 requested_version ) 
 {
     this->requested_version = requested_version;
@@ -855,6 +1063,40 @@ void LASwriteOpener::set_chunk_size(U32 chunk_size)
   this->chunk_size = chunk_size;
 }
 
+void LASwriteOpener::set_chunking(U32 chunking, F64 chunking_value)
+{
+  this->chunking = chunking;
+  this->chunking_value = chunking_value;
+}
+
+void LASwriteOpener::set_async(BOOL async)
+{
+  this->async = async;
+}
+
+void LASwriteOpener::set_stream_trailer(BOOL stream_trailer)
+{
+  this->stream_trailer = stream_trailer;
+}
+
+void LASwriteOpener::set_chunk_checksums(BOOL chunk_checksums)
+{
+  this->chunk_checksums = chunk_checksums;
+}
+
+void LASwriteOpener::set_shm_name(const CHAR* shm_name)
+{
+  if (this->shm_name) free(this->shm_name);
+  if (shm_name)
+  {
+    this->shm_name = LASCopyString(shm_name);
+  }
+  else
+  {
+    this->shm_name = 0;
+  }
+}
+
 void LASwriteOpener::make_numbered_file_name(const CHAR* file_name, I32 digits)
 {
   I32 len;
@@ -1247,7 +1489,7 @@ void LASwriteOpener::set_scale_rgb(F32 scale_rgb)
 
 BOOL LASwriteOpener::active() const
 {
-  return (file_name != 0 || use_stdout || use_nil);
+  return (file_name != 0 || use_stdout || use_nil || shm_name != 0);
 }
 
 void LASwriteOpener::add_directory(const CHAR* directory)
@@ -1343,6 +1585,12 @@ LASwriteOpener::LASwriteOpener()
   use_stdout = FALSE;
   use_nil = FALSE;
   requested_version = 0;
+  async = FALSE;
+  shm_name = 0;
+  stream_trailer = FALSE;
+  chunk_checksums = FALSE;
+  chunking = LAS_WRITER_CHUNKING_NONE;
+  chunking_value = 0;
 }
 
 LASwriteOpener::~LASwriteOpener()
@@ -1352,4 +1600,5 @@ LASwriteOpener::~LASwriteOpener()
   if (appendix) free(appendix);
   if (parse_string) free(parse_string);
   if (separator) free(separator);
+  if (shm_name) free(shm_name);
 }
@@ -64,13 +64,12 @@ struct TSpoint
   U16 intensity;
 };
 
-#define TSHEADER_RECOG_STR_LEN 5
 struct TSheader
 {
   I32 size;
   I32 version;
   I32 recog_val;
-  I8 recog_str[TSHEADER_RECOG_STR_LEN];  // 4 + \0
+  I8 recog_str[4];
   I32 npoints;
   I32 units;
   F64 origin_x;
@@ -83,6 +82,7 @@ struct TSheader
 BOOL LASwriterBIN::refile(FILE* file)
 {
   if (stream == 0) return FALSE;
+  if (!write_block()) return FALSE;
   if (this->file) this->file = file;
   return ((ByteStreamOutFile*)stream)->refile(file);
 }
@@ -172,7 +172,7 @@ BOOL LASwriterBIN::open(ByteStreamOut* stream, const LASheader* header, const ch
   tsheader.size = sizeof(TSheader);
   tsheader.version = this->version;
   tsheader.recog_val = 970401;
-  strncpy_las(tsheader.recog_str, TSHEADER_RECOG_STR_LEN, "CXYZ", 4);
+  memcpy(tsheader.recog_str, "CXYZ", 4);
   tsheader.npoints = (header->number_of_point_records ? header->number_of_point_records : (U32)header->extended_number_of_point_records);
   double scale = header->x_scale_factor;
   if (header->y_scale_factor < scale) scale = header->y_scale_factor;
@@ -189,13 +189,34 @@ BOOL LASwriterBIN::open(ByteStreamOut* stream, const LASheader* header, const ch
   tsheader.time = (header->point_data_format == 1) || (header->point_data_format == 3) || (header->point_data_format == 4) || (header->point_data_format == 5);
   tsheader.rgb = (header->point_data_format == 2) || (header->point_data_format == 3) || (header->point_data_format == 5);
 
+  if (block == 0) block = new U8[LAS_TOOLS_IO_OBUFFER_SIZE];
+  block_fill = 0;
+
   return stream->putBytes((U8*)&tsheader, sizeof(TSheader));
 }
 
+// the records are collected in a block that is handed to the stream with a single
+// call once it cannot take another record of the largest size (20 + 4 + 4 bytes)
+
+BOOL LASwriterBIN::write_block()
+{
+  if (block_fill)
+  {
+    if (!stream->putBytes(block, block_fill)) return FALSE;
+    block_fill = 0;
+  }
+  return TRUE;
+}
+
 BOOL LASwriterBIN::write_point(const LASpoint* point)
 {
   U16 echo;
 
+  if ((block_fill + sizeof(TSpoint) + 2*sizeof(U32)) > LAS_TOOLS_IO_OBUFFER_SIZE)
+  {
+    if (!write_block()) return FALSE;
+  }
+
   if (point->number_of_returns <= 1)
     echo = 0;
   else if (point->return_number == 1)
@@ -217,7 +238,8 @@ BOOL LASwriterBIN::write_point(const LASpoint* point)
     tspoint.mark  = 0;
     tspoint.line = point->point_source_ID;
     tspoint.intensity = point->intensity;
-    if (!stream->putBytes((U8*)&tspoint, sizeof(TSpoint))) return FALSE;
+    memcpy(block + block_fill, &tspoint, sizeof(TSpoint));
+    block_fill += sizeof(TSpoint);
   }
   else
   {
@@ -228,22 +250,23 @@ BOOL LASwriterBIN::write_point(const LASpoint* point)
     tsrow.x = I32_QUANTIZE(point->get_x()*units+origin_x);
     tsrow.y = I32_QUANTIZE(point->get_y()*units+origin_y);
     tsrow.z = I32_QUANTIZE(point->get_z()*units+origin_z);
-    if (!stream->putBytes((U8*)&tsrow, sizeof(TSrow))) return FALSE;
+    memcpy(block + block_fill, &tsrow, sizeof(TSrow));
+    block_fill += sizeof(TSrow);
   }
 
   if (point->have_gps_time)
   {
     U32 time = (U32)(point->gps_time/0.0002+0.5);
-    if (!stream->putBytes((U8*)&time, sizeof(U32))) return FALSE;
+    memcpy(block + block_fill, &time, sizeof(U32));
+    block_fill += sizeof(U32);
   }
   if (point->have_rgb)
   {
-    U8 rgba[4];
-    rgba[0] = point->rgb[0]/256;
-    rgba[1] = point->rgb[1]/256;
-    rgba[2] = point->rgb[2]/256;
-    rgba[3] = 0;
-    if (!stream->putBytes((U8*)&rgba, sizeof(U32))) return FALSE;
+    block[block_fill + 0] = point->rgb[0]/256;
+    block[block_fill + 1] = point->rgb[1]/256;
+    block[block_fill + 2] = point->rgb[2]/256;
+    block[block_fill + 3] = 0;
+    block_fill += sizeof(U32);
   }
   p_count++;
   return TRUE;
@@ -260,6 +283,10 @@ I64 LASwriterBIN::close(BOOL update_npoints)
   
   if (stream)
   {
+    if (!write_block())
+    {
+      laserror("writing last %u bytes of terrasolid points", block_fill);
+    }
     if (update_npoints && p_count != npoints)
     {
       if (!stream->isSeekable())
@@ -299,9 +326,16 @@ LASwriterBIN::LASwriterBIN()
   origin_z = 0;
   units = 0;
   version = 0;
+  block = 0;
+  block_fill = 0;
 }
 
 LASwriterBIN::~LASwriterBIN()
 {
   if (file) close();
+  if (block)
+  {
+    delete [] block;
+    block = 0;
+  }
 }
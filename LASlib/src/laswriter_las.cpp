@@ -31,10 +31,15 @@
 #include "laswriter_las.hpp"
 
 #include "lasmessage.hpp"
+#include "lasreader.hpp"
+#include "lasreadpoint.hpp"
+#include "bytestreamin.hpp"
 #include "bytestreamout_nil.hpp"
 #include "bytestreamout_file.hpp"
 #include "bytestreamout_ostream.hpp"
 #include "laswritepoint.hpp"
+#include "laswriteitemraw.hpp"
+#include "lasquadtree.hpp"
 
 #ifdef _WIN32
 #include <fcntl.h>
@@ -44,9 +49,13 @@
 #include <stdlib.h>
 #include <string.h>
 
+// uncompressed points are collected in a buffer of about this size
+#define LAS_WRITER_RAW_BUFFER_SIZE 1048576
+
 BOOL LASwriterLAS::refile(FILE* file)
 {
   if (stream == 0) return FALSE;
+  if (!flush_raw()) return FALSE;
   if (this->file) this->file = file;
   return ((ByteStreamOutFile*)stream)->refile(file);
 }
@@ -183,7 +192,11 @@ BOOL LASwriterLAS::open(ByteStreamOut* stream, const LASheader* header, U32 comp
 
   // do we need a LASzip VLR (because we compress or use non-standard points?)
 
-  LASzip* laszip = 0;
+  if (laszip)
+  {
+    delete laszip;
+    laszip = 0;
+  }
   U32 laszip_vlr_data_size = 0;
   if (compressor || point_is_standard == FALSE)
   {
@@ -195,7 +208,14 @@ BOOL LASwriterLAS::open(ByteStreamOut* stream, const LASheader* header, U32 comp
       laserror("adaptive chunking is depricated for point type %d. only available for new LAS 1.4 point types 6 or higher.", point_data_format); 
       return FALSE;
     }
-    else if (requested_version) laszip->request_version(requested_version);
+    else if (requested_version)
+    {
+      if ((requested_version > 4) && (point_data_format <= 5))
+      {
+        LASMessage(LAS_WARNING, "LAZ level only applies to point type 6 or higher. using default for point type %d", point_data_format);
+      }
+      laszip->request_version(requested_version);
+    }
     else laszip->request_version(laszip->get_default_version(point_data_format, header->version_major, header->version_minor));
     laszip_vlr_data_size = 34 + 6 * laszip->num_items;
   }
@@ -220,6 +240,46 @@ BOOL LASwriterLAS::open(ByteStreamOut* stream, const LASheader* header, U32 comp
     }
   }
 
+  // uncompressed points are packed directly into a large buffer that is written
+  // with a single call instead of passing each item through its own writer and
+  // the stream. only on little-endian hosts, as the items are copied as they are.
+
+  if ((laszip == 0) && Endian::IS_LITTLE_ENDIAN)
+  {
+    raw_num_items = point.num_items;
+    raw_item_sizes = new U32[raw_num_items];
+    raw_point_size = 0;
+    raw_point14 = FALSE;
+    for (i = 0; i < raw_num_items; i++)
+    {
+      if (point.items[i].type == LASitem::POINT14)
+      {
+        if (i != 0) break;
+        raw_point14 = TRUE;
+      }
+      raw_item_sizes[i] = point.items[i].size;
+      raw_point_size += raw_item_sizes[i];
+    }
+    if ((i == raw_num_items) && raw_point_size)
+    {
+      raw_buffer_size = (LAS_WRITER_RAW_BUFFER_SIZE / raw_point_size) * raw_point_size;
+      if (raw_buffer_size == 0) raw_buffer_size = raw_point_size;
+      raw_buffer = (U8*)malloc_las(raw_buffer_size);
+      raw_buffer_used = 0;
+      raw_point_data_format = point_data_format;
+      raw_gps_time = point.have_gps_time;
+      raw_last_point = 0;
+      raw_inventory_start = 0;
+      raw_inventory_end = 0;
+    }
+    else
+    {
+      delete [] raw_item_sizes;
+      raw_item_sizes = 0;
+      raw_num_items = 0;
+    }
+  }
+
   // LAS 1.5 doesn't allow point types 0-5 anymore. 
   // print a warning, but allow it if the user requests this 
   // Resulting file might not be supported by every reader though
@@ -713,9 +773,6 @@ BOOL LASwriterLAS::open(ByteStreamOut* stream, const LASheader* header, U32 comp
         return FALSE;
       }
     }
-
-    delete laszip;
-    laszip = 0;
   }
 
   // write lastiling VLR with the tile parameters
@@ -919,20 +976,462 @@ BOOL LASwriterLAS::open(ByteStreamOut* stream, const LASheader* header, U32 comp
   return TRUE;
 }
 
+BOOL LASwriterLAS::set_chunking(U32 chunking, F64 value, U32 max_points, const LASheader* header)
+{
+  if ((writer == 0) || (stream == 0))
+  {
+    laserror("set_chunking() must be called after open()");
+    return FALSE;
+  }
+  if (chunking > LAS_WRITER_CHUNKING_BYTES)
+  {
+    laserror("chunking %u not supported", chunking);
+    return FALSE;
+  }
+  if ((chunking != LAS_WRITER_CHUNKING_NONE) && (value <= 0))
+  {
+    laserror("chunking value %g must be positive", value);
+    return FALSE;
+  }
+  if (chunking_quadtree)
+  {
+    delete chunking_quadtree;
+    chunking_quadtree = 0;
+  }
+  if (chunking == LAS_WRITER_CHUNKING_CELL)
+  {
+    if (header == 0)
+    {
+      laserror("header pointer is zero");
+      return FALSE;
+    }
+    // the same cells that lasindex uses with this cell size
+    chunking_quadtree = new LASquadtree();
+    if (!chunking_quadtree->setup(header->min_x, header->max_x, header->min_y, header->max_y, (F32)value))
+    {
+      delete chunking_quadtree;
+      chunking_quadtree = 0;
+      return FALSE;
+    }
+  }
+  this->chunking = chunking;
+  chunking_value = value;
+  chunking_max_points = (max_points ? max_points : U32_MAX);
+  chunking_key = 0;
+  chunk_points = 0;
+  // the first chunk starts with the first point
+  chunk_start = -1;
+  return TRUE;
+}
+
+BOOL LASwriterLAS::set_stream_trailer(const LASheader* header)
+{
+  if ((writer == 0) || (stream == 0))
+  {
+    laserror("set_stream_trailer() must be called after open()");
+    return FALSE;
+  }
+  if (header == 0)
+  {
+    laserror("header pointer is zero");
+    return FALSE;
+  }
+  if (stream->isSeekable())
+  {
+    return TRUE;
+  }
+  // only LAS 1.4 and higher have EVLRs
+  if ((header->version_major == 1) && (header->version_minor < 4))
+  {
+    LASMessage(LAS_WARNING, "stream trailer needs LAS 1.4 output but this is LAS %d.%d. not written.", (I32)header->version_major, (I32)header->version_minor);
+    return TRUE;
+  }
+  if (trailer == 0)
+  {
+    trailer = new LASvlr_stream_trailer();
+  }
+  update_trailer(header, FALSE);
+  writer->set_chunk_table_start_in_trailer(TRUE);
+  return TRUE;
+}
+
+BOOL LASwriterLAS::set_chunk_checksums()
+{
+  if ((writer == 0) || (stream == 0) || p_count)
+  {
+    laserror("set_chunk_checksums() must be called after open() and before writing points");
+    return FALSE;
+  }
+  if (!writer->set_chunk_checksums())
+  {
+    LASMessage(LAS_WARNING, "chunk checksums need chunked LAZ compression. ignoring ...");
+    return FALSE;
+  }
+  return TRUE;
+}
+
+void LASwriterLAS::update_trailer(const LASheader* header, BOOL use_inventory)
+{
+  I32 i;
+  if (use_inventory)
+  {
+    trailer->number_of_point_records = inventory.extended_number_of_point_records;
+    for (i = 0; i < 15; i++)
+    {
+      trailer->number_of_points_by_return[i] = inventory.extended_number_of_points_by_return[i + 1];
+    }
+    trailer->max_x = quantizer.get_x(inventory.max_X);
+    trailer->min_x = quantizer.get_x(inventory.min_X);
+    trailer->max_y = quantizer.get_y(inventory.max_Y);
+    trailer->min_y = quantizer.get_y(inventory.min_Y);
+    trailer->max_z = quantizer.get_z(inventory.max_Z);
+    trailer->min_z = quantizer.get_z(inventory.min_Z);
+    trailer->max_gps_time = inventory.max_gps_time;
+    trailer->min_gps_time = inventory.min_gps_time;
+  }
+  else
+  {
+    if (header->number_of_point_records)
+      trailer->number_of_point_records = header->number_of_point_records;
+    else
+      trailer->number_of_point_records = header->extended_number_of_point_records;
+    for (i = 0; i < 15; i++)
+    {
+      if ((i < 5) && header->number_of_points_by_return[i])
+        trailer->number_of_points_by_return[i] = header->number_of_points_by_return[i];
+      else
+        trailer->number_of_points_by_return[i] = header->extended_number_of_points_by_return[i];
+    }
+    trailer->max_x = header->max_x;
+    trailer->min_x = header->min_x;
+    trailer->max_y = header->max_y;
+    trailer->min_y = header->min_y;
+    trailer->max_z = header->max_z;
+    trailer->min_z = header->min_z;
+    trailer->max_gps_time = header->max_gps_time;
+    trailer->min_gps_time = header->min_gps_time;
+  }
+  npoints = trailer->number_of_point_records;
+}
+
+BOOL LASwriterLAS::write_trailer()
+{
+  I32 i;
+  U16 reserved = 0;
+  if (!stream->put16bitsLE((const U8*)&reserved))
+  {
+    laserror("writing trailer reserved");
+    return FALSE;
+  }
+  CHAR user_id[16];
+  memset(user_id, 0, 16);
+  strncpy(user_id, "LAStools", 16);
+  if (!stream->putBytes((const U8*)user_id, 16))
+  {
+    laserror("writing trailer user_id");
+    return FALSE;
+  }
+  U16 record_id = LAS_TOOLS_STREAM_TRAILER_RECORD_ID;
+  if (!stream->put16bitsLE((const U8*)&record_id))
+  {
+    laserror("writing trailer record_id");
+    return FALSE;
+  }
+  I64 record_length_after_header = LAS_TOOLS_STREAM_TRAILER_PAYLOAD;
+  if (!stream->put64bitsLE((const U8*)&record_length_after_header))
+  {
+    laserror("writing trailer record_length_after_header");
+    return FALSE;
+  }
+  CHAR description[32];
+  memset(description, 0, 32);
+  strncpy(description, "header of streamed output", 32);
+  if (!stream->putBytes((const U8*)description, 32))
+  {
+    laserror("writing trailer description");
+    return FALSE;
+  }
+  if (!stream->put64bitsLE((const U8*)&(trailer->number_of_point_records)))
+  {
+    laserror("writing trailer->number_of_point_records");
+    return FALSE;
+  }
+  for (i = 0; i < 15; i++)
+  {
+    if (!stream->put64bitsLE((const U8*)&(trailer->number_of_points_by_return[i])))
+    {
+      laserror("writing trailer->number_of_points_by_return[%d]", i);
+      return FALSE;
+    }
+  }
+  if (!stream->put64bitsLE((const U8*)&(trailer->max_x)) || !stream->put64bitsLE((const U8*)&(trailer->min_x)) ||
+      !stream->put64bitsLE((const U8*)&(trailer->max_y)) || !stream->put64bitsLE((const U8*)&(trailer->min_y)) ||
+      !stream->put64bitsLE((const U8*)&(trailer->max_z)) || !stream->put64bitsLE((const U8*)&(trailer->min_z)))
+  {
+    laserror("writing trailer bounding box");
+    return FALSE;
+  }
+  if (!stream->put64bitsLE((const U8*)&(trailer->max_gps_time)) || !stream->put64bitsLE((const U8*)&(trailer->min_gps_time)))
+  {
+    laserror("writing trailer gps time range");
+    return FALSE;
+  }
+  if (!stream->put64bitsLE((const U8*)&(trailer->start_of_first_extended_variable_length_record)))
+  {
+    laserror("writing trailer->start_of_first_extended_variable_length_record");
+    return FALSE;
+  }
+  if (!stream->put32bitsLE((const U8*)&(trailer->number_of_extended_variable_length_records)))
+  {
+    laserror("writing trailer->number_of_extended_variable_length_records");
+    return FALSE;
+  }
+  if (!stream->put32bitsLE((const U8*)&(trailer->reserved)))
+  {
+    laserror("writing trailer->reserved");
+    return FALSE;
+  }
+  // must be the last 8 bytes of the file
+  if (!stream->put64bitsLE((const U8*)&(trailer->chunk_table_start_position)))
+  {
+    laserror("writing trailer->chunk_table_start_position");
+    return FALSE;
+  }
+  return TRUE;
+}
+
+BOOL LASwriterLAS::write_chunk_checksums(const U32 number, const U32* checksums)
+{
+  I64 start = stream->tell();
+  U16 reserved = 0;
+  if (!stream->put16bitsLE((const U8*)&reserved))
+  {
+    laserror("writing chunk checksums reserved");
+    return FALSE;
+  }
+  CHAR user_id[16];
+  memset(user_id, 0, 16);
+  strncpy(user_id, "LAStools", 16);
+  if (!stream->putBytes((const U8*)user_id, 16))
+  {
+    laserror("writing chunk checksums user_id");
+    return FALSE;
+  }
+  U16 record_id = LAS_TOOLS_CHUNK_CHECKSUMS_RECORD_ID;
+  if (!stream->put16bitsLE((const U8*)&record_id))
+  {
+    laserror("writing chunk checksums record_id");
+    return FALSE;
+  }
+  I64 record_length_after_header = 4 + 4 * (I64)number + 8;
+  if (!stream->put64bitsLE((const U8*)&record_length_after_header))
+  {
+    laserror("writing chunk checksums record_length_after_header");
+    return FALSE;
+  }
+  CHAR description[32];
+  memset(description, 0, 32);
+  strncpy(description, "CRC-32 of the LAZ chunks", 32);
+  if (!stream->putBytes((const U8*)description, 32))
+  {
+    laserror("writing chunk checksums description");
+    return FALSE;
+  }
+  if (!stream->put32bitsLE((const U8*)&number))
+  {
+    laserror("writing number of chunk checksums");
+    return FALSE;
+  }
+  U32 i;
+  for (i = 0; i < number; i++)
+  {
+    if (!stream->put32bitsLE((const U8*)&(checksums[i])))
+    {
+      laserror("writing checksum of chunk %u", i);
+      return FALSE;
+    }
+  }
+  if (!stream->put64bitsLE((const U8*)&start))
+  {
+    laserror("writing start of chunk checksums");
+    return FALSE;
+  }
+
+  // LAS 1.4 and higher count it as the last EVLR
+
+  if (writing_las_1_4)
+  {
+    U32 number_of_evlrs = number_of_extended_variable_length_records + 1;
+    if (stream->isSeekable())
+    {
+      if (number_of_extended_variable_length_records == 0)
+      {
+        stream->seek(header_start_position + 235);
+        stream->put64bitsLE((const U8*)&start);
+      }
+      stream->seek(header_start_position + 243);
+      stream->put32bitsLE((const U8*)&number_of_evlrs);
+      stream->seekEnd();
+    }
+    else if (trailer)
+    {
+      if (number_of_extended_variable_length_records == 0)
+      {
+        trailer->start_of_first_extended_variable_length_record = start;
+      }
+      trailer->number_of_extended_variable_length_records = number_of_evlrs;
+    }
+  }
+  return TRUE;
+}
+
+BOOL LASwriterLAS::next_chunk()
+{
+  if (!writer->chunk()) return FALSE;
+  if (chunking == LAS_WRITER_CHUNKING_BYTES)
+  {
+    // guess how many points of the next chunk give the requested size
+    I64 position = stream->tell();
+    I64 bytes = position - chunk_start;
+    chunk_start = position;
+    if (bytes > 0)
+    {
+      F64 points = chunking_value * chunk_points / bytes;
+      if (points < 1024) points = 1024;
+      else if (points > 10000000) points = 10000000;
+      chunking_max_points = (U32)points;
+    }
+  }
+  chunk_points = 0;
+  return TRUE;
+}
+
 BOOL LASwriterLAS::write_point(const LASpoint* point)
 {
   p_count++;
+  if (chunking)
+  {
+    if (chunk_start == -1)
+    {
+      chunk_start = stream->tell();
+      if (chunking == LAS_WRITER_CHUNKING_BYTES)
+      {
+        // before the first chunk is compressed the points are assumed to
+        // be uncompressed. this is too few points but never too many bytes
+        F64 points = chunking_value / point->total_point_size;
+        if (points < 1024) points = 1024;
+        else if (points > 10000000) points = 10000000;
+        chunking_max_points = (U32)points;
+      }
+    }
+    I64 key = chunking_key;
+    if (chunking == LAS_WRITER_CHUNKING_CELL)
+    {
+      // points outside the bounds of the header (e.g. after transforming
+      // them) are clamped into the nearest cell along the border
+      F64 x = point->get_x();
+      F64 y = point->get_y();
+      if (x < chunking_quadtree->get_min_x()) x = chunking_quadtree->get_min_x();
+      else if (x > chunking_quadtree->get_max_x()) x = chunking_quadtree->get_max_x();
+      if (y < chunking_quadtree->get_min_y()) y = chunking_quadtree->get_min_y();
+      else if (y > chunking_quadtree->get_max_y()) y = chunking_quadtree->get_max_y();
+      key = chunking_quadtree->get_cell_index(x, y);
+    }
+    else if (chunking == LAS_WRITER_CHUNKING_GPS_TIME)
+    {
+      key = I64_FLOOR(point->get_gps_time() / chunking_value);
+    }
+    if (chunk_points && ((key != chunking_key) || (chunk_points >= chunking_max_points)))
+    {
+      if (!next_chunk()) return FALSE;
+    }
+    chunking_key = key;
+    chunk_points++;
+  }
+  if (raw_buffer)
+  {
+    if (raw_buffer_used == raw_buffer_size)
+    {
+      if (!flush_raw()) return FALSE;
+    }
+    U8* record = raw_buffer + raw_buffer_used;
+    U32 i = 0;
+    if (raw_point14)
+    {
+      LASwriteItemRaw_POINT14_LE::pack(point->point[0], record);
+      record += 30;
+      i = 1;
+    }
+    for (; i < raw_num_items; i++)
+    {
+      memcpy(record, point->point[i], raw_item_sizes[i]);
+      record += raw_item_sizes[i];
+    }
+    raw_buffer_used += raw_point_size;
+    raw_last_point = point;
+    return TRUE;
+  }
   return writer->write(point->point);
 }
 
+// the inventory of a point that was just buffered is deferred. consecutive
+// such points are added as one block when the buffer is flushed.
+
+void LASwriterLAS::update_inventory(const LASpoint* point)
+{
+  if (raw_buffer && (point == raw_last_point) && (point->extended_point_type == raw_point14) && (point->have_gps_time == raw_gps_time))
+  {
+    U32 offset = raw_buffer_used - raw_point_size;
+    if (offset != raw_inventory_end)
+    {
+      inventory_raw();
+      raw_inventory_start = offset;
+    }
+    raw_inventory_end = offset + raw_point_size;
+    raw_last_point = 0;
+  }
+  else
+  {
+    inventory.add(point);
+  }
+}
+
+void LASwriterLAS::inventory_raw()
+{
+  if (raw_inventory_end > raw_inventory_start)
+  {
+    inventory.add(raw_buffer + raw_inventory_start, (raw_inventory_end - raw_inventory_start) / raw_point_size, raw_point_size, raw_point_data_format);
+  }
+  raw_inventory_start = raw_inventory_end = 0;
+}
+
+BOOL LASwriterLAS::flush_raw()
+{
+  inventory_raw();
+  raw_last_point = 0;
+  if (raw_buffer_used)
+  {
+    U32 used = raw_buffer_used;
+    raw_buffer_used = 0;
+    if (!stream->putBytes(raw_buffer, used)) return FALSE;
+  }
+  return TRUE;
+}
+
 BOOL LASwriterLAS::chunk()
 {
+  if (chunking)
+  {
+    if (chunk_points == 0) return TRUE;
+    return next_chunk();
+  }
   return writer->chunk();
 }
 
 BOOL LASwriterLAS::update_header(const LASheader* header, BOOL use_inventory, BOOL update_extra_bytes)
 {
   I32 i;
+  if (!flush_raw()) return FALSE;
   if (header == 0)
   {
     laserror("header pointer is zero");
@@ -945,6 +1444,11 @@ BOOL LASwriterLAS::update_header(const LASheader* header, BOOL use_inventory, BO
   }
   if (!stream->isSeekable())
   {
+    if (trailer)
+    {
+      update_trailer(header, use_inventory);
+      return TRUE;
+    }
     LASMessage(LAS_WARNING, "stream not seekable. cannot update header.");
     return FALSE;
   }
@@ -1278,6 +1782,141 @@ BOOL LASwriterLAS::update_header(const LASheader* header, BOOL use_inventory, BO
   return TRUE;
 }
 
+BOOL LASwriterLAS::setup_chunk_writer(LASwritePoint* chunk_writer) const
+{
+  if ((chunk_writer == 0) || (laszip == 0) || (laszip->compressor == LASZIP_COMPRESSOR_NONE))
+  {
+    return FALSE;
+  }
+  return chunk_writer->setup(laszip->num_items, laszip->items, laszip);
+}
+
+BOOL LASwriterLAS::write_chunk(const U8* bytes, const U32 num_bytes, const U32 number)
+{
+  if ((writer == 0) || (laszip == 0) || raw_buffer)
+  {
+    return FALSE;
+  }
+  if (!writer->write_chunk(bytes, num_bytes, number))
+  {
+    return FALSE;
+  }
+  p_count += number;
+  return TRUE;
+}
+
+BOOL LASwriterLAS::can_copy_chunks(const LASreader* lasreader) const
+{
+  if ((writer == 0) || (laszip == 0) || (laszip->compressor == LASZIP_COMPRESSOR_NONE) || raw_buffer || chunking)
+  {
+    return FALSE;
+  }
+  if ((lasreader == 0) || (lasreader->get_format() != LAS_TOOLS_FORMAT_LAZ) || (lasreader->header.laszip == 0))
+  {
+    return FALSE;
+  }
+  const LASzip* other = lasreader->header.laszip;
+  if ((other->compressor != laszip->compressor) || (other->num_items != laszip->num_items))
+  {
+    return FALSE;
+  }
+  U32 i;
+  for (i = 0; i < laszip->num_items; i++)
+  {
+    if ((other->items[i].type != laszip->items[i].type) || (other->items[i].size != laszip->items[i].size) || (other->items[i].version != laszip->items[i].version))
+    {
+      return FALSE;
+    }
+  }
+  // the copied points keep their integer coordinates
+  const LASheader* header = &(lasreader->header);
+  if ((quantizer.x_scale_factor != header->x_scale_factor) || (quantizer.y_scale_factor != header->y_scale_factor) || (quantizer.z_scale_factor != header->z_scale_factor))
+  {
+    return FALSE;
+  }
+  if ((quantizer.x_offset != header->x_offset) || (quantizer.y_offset != header->y_offset) || (quantizer.z_offset != header->z_offset))
+  {
+    return FALSE;
+  }
+  // a chunk size of zero or U32_MAX means variable chunks
+  if ((laszip->chunk_size != 0) && (laszip->chunk_size != U32_MAX))
+  {
+    if ((other->chunk_size != laszip->chunk_size) || (p_count % laszip->chunk_size))
+    {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+
+BOOL LASwriterLAS::copy_chunks(LASreader* lasreader)
+{
+  if (!can_copy_chunks(lasreader))
+  {
+    return FALSE;
+  }
+  ByteStreamIn* instream = lasreader->get_stream();
+  if ((instream == 0) || !instream->isSeekable())
+  {
+    return FALSE;
+  }
+  const LASzip* other = lasreader->header.laszip;
+  LASreadPoint table;
+  if (!table.setup(other->num_items, other->items, other) || !table.init(instream) || !table.init_chunks(lasreader->npoints))
+  {
+    return FALSE;
+  }
+  U8* bytes = 0;
+  U32 size = 0;
+  BOOL success = TRUE;
+  U32 i, total = table.get_number_chunks();
+  for (i = 0; (i < total) && success; i++)
+  {
+    U32 number = table.get_chunk_number_of_points(i);
+    if (number == 0) continue;
+    I64 start = table.get_chunk_start(i);
+    I64 end = table.get_chunk_start(i + 1);
+    if ((end <= start) || ((end - start) > U32_MAX))
+    {
+      success = FALSE;
+      break;
+    }
+    U32 num_bytes = (U32)(end - start);
+    if (num_bytes > size)
+    {
+      if (bytes) free(bytes);
+      size = num_bytes;
+      bytes = (U8*)malloc_las(size);
+      if (bytes == 0)
+      {
+        success = FALSE;
+        break;
+      }
+    }
+    try
+    {
+      if (!instream->seek(start)) throw 1;
+      instream->getBytes(bytes, num_bytes);
+    }
+    catch (...)
+    {
+      success = FALSE;
+      break;
+    }
+    success = write_chunk(bytes, num_bytes, number);
+  }
+  if (bytes) free(bytes);
+  table.done();
+  if (success)
+  {
+    // the copied points are only known from the header of their file
+    LASinventory copied;
+    copied.init(&(lasreader->header));
+    inventory.merge(&copied);
+  }
+  return success;
+}
+
 I64 LASwriterLAS::close(BOOL update_npoints)
 {
   I64 bytes = 0;
@@ -1290,17 +1929,55 @@ I64 LASwriterLAS::close(BOOL update_npoints)
     }
   }
 
+  if (raw_buffer)
+  {
+    if (stream) flush_raw();
+    free(raw_buffer);
+    raw_buffer = 0;
+    delete [] raw_item_sizes;
+    raw_item_sizes = 0;
+  }
+
+  U32 number_checksums = 0;
+  U32* checksums = 0;
+
   if (writer)
   {
     writer->done();
+    if (trailer) trailer->chunk_table_start_position = writer->get_chunk_table_start();
+    if (writer->get_chunk_checksums() && writer->get_number_chunks())
+    {
+      number_checksums = writer->get_number_chunks();
+      checksums = (U32*)malloc_las(sizeof(U32) * number_checksums);
+      if (checksums) memcpy(checksums, writer->get_chunk_checksums(), sizeof(U32) * number_checksums);
+    }
     delete writer;
     writer = 0;
   }
 
+  if (laszip)
+  {
+    delete laszip;
+    laszip = 0;
+  }
+
+  if (chunking_quadtree)
+  {
+    delete chunking_quadtree;
+    chunking_quadtree = 0;
+  }
+  chunking = LAS_WRITER_CHUNKING_NONE;
+
   if (writing_las_1_4 && number_of_extended_variable_length_records)
   {
     I64 real_start_of_first_extended_variable_length_record = stream->tell();
 
+    if (trailer)
+    {
+      trailer->start_of_first_extended_variable_length_record = real_start_of_first_extended_variable_length_record;
+      trailer->number_of_extended_variable_length_records = number_of_extended_variable_length_records;
+    }
+
     // write extended variable length records variable after variable (to avoid alignment issues)
     U64 copc_root_hier_size = 0;
     U64 copc_root_hier_offset = 0;
@@ -1381,6 +2058,35 @@ I64 LASwriterLAS::close(BOOL update_npoints)
     }
   }
 
+  if (checksums)
+  {
+    // LASzip finds the chunk table of non-seekable output via the last 8 bytes
+    if (stream && !stream->isSeekable() && !trailer)
+    {
+      LASMessage(LAS_WARNING, "chunk checksums of non-seekable output need '-stream_trailer'. not stored.");
+    }
+    else if (stream)
+    {
+      write_chunk_checksums(number_checksums, checksums);
+    }
+    free(checksums);
+  }
+
+  if (trailer)
+  {
+    if (stream)
+    {
+      if (update_npoints && p_count != npoints)
+      {
+        trailer->number_of_point_records = p_count;
+        npoints = p_count;
+      }
+      write_trailer();
+    }
+    delete trailer;
+    trailer = 0;
+  }
+
   if (stream)
   {
     if (update_npoints && p_count != npoints)
@@ -1443,6 +2149,7 @@ I64 LASwriterLAS::close(BOOL update_npoints)
 
 I64 LASwriterLAS::tell()
 {
+  flush_raw();
   return stream->tell();
 }
 
@@ -1452,13 +2159,34 @@ LASwriterLAS::LASwriterLAS()
   stream = 0;
   delete_stream = TRUE;
   writer = 0;
+  laszip = 0;
   writing_las_1_4 = FALSE;
   writing_new_point_type = FALSE;
   // for delayed write of EVLRs
   start_of_first_extended_variable_length_record = 0;
   number_of_extended_variable_length_records = 0;
   evlrs = 0;
+  trailer = 0;
   header_start_position = 0;
+  raw_buffer = 0;
+  raw_buffer_size = 0;
+  raw_buffer_used = 0;
+  raw_point_size = 0;
+  raw_num_items = 0;
+  raw_item_sizes = 0;
+  raw_point14 = FALSE;
+  raw_last_point = 0;
+  raw_point_data_format = 0;
+  raw_gps_time = FALSE;
+  raw_inventory_start = 0;
+  raw_inventory_end = 0;
+  chunking = LAS_WRITER_CHUNKING_NONE;
+  chunking_value = 0;
+  chunking_max_points = U32_MAX;
+  chunking_quadtree = 0;
+  chunking_key = 0;
+  chunk_points = 0;
+  chunk_start = -1;
 }
 
 LASwriterLAS::~LASwriterLAS()
@@ -0,0 +1,352 @@
+/*
+===============================================================================
+
+  FILE:  laswriterasync.cpp
+  
+  CONTENTS:
+  
+    see corresponding header file
+  
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  
+  CHANGE HISTORY:
+  
+    see corresponding header file
+  
+===============================================================================
+*/
+#include "laswriterasync.hpp"
+
+#include "lasmessage.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// a bounded ring of point batches between the processing thread (the only
+// producer) and the writer thread (the only consumer). the lock is taken once
+// per batch. when all batches are full the processing thread waits for the
+// writer thread, which limits the memory used to the size of the ring.
+
+// the points [inventory_start, inventory_end) of a batch also go into the
+// inventory, which the writer thread collects separately and which is merged
+// into the inventory of the LASwriterAsync once the thread is idle.
+
+// once the wrapped writer fails to write a point or to start a chunk the writer
+// thread sets 'failed' and only retires the remaining batches without writing
+// them. the processing thread sees it at the next hand-over.
+
+struct LASwriterAsyncBatch
+{
+  U8* points;
+  U32 number;
+  U32 inventory_start;
+  U32 inventory_end;
+  BOOL chunk_after;
+};
+
+class LASwriterAsyncQueue
+{
+public:
+  std::vector<LASwriterAsyncBatch> batches;
+  U32 batch_points;
+  U32 head;        // next batch to be filled by the processing thread
+  U32 tail;        // next batch to be written by the writer thread
+  U32 filled;      // batches handed over but not yet written
+  BOOL busy;       // writer thread is writing a batch
+  BOOL quit;
+  BOOL failed;     // the wrapped writer failed to write a point or a chunk
+  std::mutex mutex;
+  std::condition_variable not_full;
+  std::condition_variable not_empty;
+  LASpoint point;
+  LASinventory inventory;
+  std::thread worker;
+};
+
+static void las_writer_async_run(LASwriterAsyncQueue* queue, LASwriter* writer, U32 point_size, U8 point_data_format)
+{
+  while (true)
+  {
+    LASwriterAsyncBatch* batch;
+    BOOL failed;
+    {
+      std::unique_lock<std::mutex> lock(queue->mutex);
+      queue->not_empty.wait(lock, [queue]{ return queue->quit || queue->filled; });
+      if (queue->filled == 0) return;
+      batch = &(queue->batches[queue->tail]);
+      queue->busy = TRUE;
+      failed = queue->failed;
+    }
+    if (!failed)
+    {
+      U32 i;
+      for (i = 0; i < batch->number; i++)
+      {
+        queue->point.copy_from(batch->points + (size_t)i * point_size);
+        if (!writer->write_point(&(queue->point)))
+        {
+          failed = TRUE;
+          break;
+        }
+      }
+      if (!failed && (batch->inventory_end > batch->inventory_start))
+      {
+        queue->inventory.add(batch->points + (size_t)batch->inventory_start * point_size, batch->inventory_end - batch->inventory_start, point_size, point_data_format);
+      }
+      if (!failed && batch->chunk_after && !writer->chunk())
+      {
+        failed = TRUE;
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock(queue->mutex);
+      if (failed) queue->failed = TRUE;
+      batch->number = 0;
+      batch->inventory_start = 0;
+      batch->inventory_end = 0;
+      batch->chunk_after = FALSE;
+      queue->tail = (queue->tail + 1) % (U32)queue->batches.size();
+      queue->filled--;
+      queue->busy = FALSE;
+    }
+    queue->not_full.notify_one();
+  }
+}
+
+BOOL LASwriterAsync::open(LASwriter* writer, const LASheader* header, U32 batch_points, U32 batch_number)
+{
+  if (writer == 0)
+  {
+    laserror("writer pointer is zero");
+    return FALSE;
+  }
+  if (header == 0)
+  {
+    laserror("header pointer is zero");
+    return FALSE;
+  }
+  if (batch_points == 0) batch_points = 4096;
+  if (batch_number < 2) batch_number = 2;
+
+  quantizer = writer->quantizer;
+  npoints = writer->npoints;
+  p_count = 0;
+
+  queue = new LASwriterAsyncQueue();
+
+  // the writer thread needs its own point with the layout of the points written
+
+  if (header->laszip)
+  {
+    if (!queue->point.init(&quantizer, header->laszip->num_items, header->laszip->items, header)) { delete queue; queue = 0; return FALSE; }
+  }
+  else
+  {
+    if (!queue->point.init(&quantizer, header->point_data_format, header->point_data_record_length, header)) { delete queue; queue = 0; return FALSE; }
+  }
+  point_size = queue->point.total_point_size;
+  point_data_format = header->point_data_format;
+  last_point = 0;
+
+  queue->batch_points = batch_points;
+  queue->batches.resize(batch_number);
+  U32 i;
+  for (i = 0; i < batch_number; i++)
+  {
+    queue->batches[i].points = (U8*)malloc_las((size_t)point_size * batch_points);
+    queue->batches[i].number = 0;
+    queue->batches[i].inventory_start = 0;
+    queue->batches[i].inventory_end = 0;
+    queue->batches[i].chunk_after = FALSE;
+  }
+  queue->head = 0;
+  queue->tail = 0;
+  queue->filled = 0;
+  queue->busy = FALSE;
+  queue->quit = FALSE;
+  queue->failed = FALSE;
+
+  try
+  {
+    queue->worker = std::thread(las_writer_async_run, queue, writer, point_size, point_data_format);
+  }
+  catch (...)
+  {
+    for (i = 0; i < batch_number; i++) free(queue->batches[i].points);
+    delete queue;
+    queue = 0;
+    return FALSE;
+  }
+
+  this->writer = writer;
+  return TRUE;
+}
+
+BOOL LASwriterAsync::write_point(const LASpoint* point)
+{
+  last_point = 0;
+  if (point->total_point_size != point_size)
+  {
+    // a point with another layout than announced by the header is written directly
+    if (!drain()) return FALSE;
+    p_count++;
+    return writer->write_point(point);
+  }
+  // a full batch is only handed over with the next point so that the inventory
+  // of the last point can still be deferred
+  if (queue->batches[queue->head].number == queue->batch_points)
+  {
+    if (!flush(FALSE)) return FALSE;
+  }
+  LASwriterAsyncBatch& batch = queue->batches[queue->head];
+  point->copy_to(batch.points + (size_t)batch.number * point_size);
+  batch.number++;
+  p_count++;
+  last_point = point;
+  return TRUE;
+}
+
+// the inventory of the point that was just written is done by the writer
+// thread when its record is in a run of such points. otherwise it is done here.
+// both end up in the same inventory because the order does not matter.
+
+void LASwriterAsync::update_inventory(const LASpoint* point)
+{
+  if (queue && (point == last_point) && (point->extended_point_type == (point_data_format >= 6)) && (point->have_gps_time == queue->point.have_gps_time))
+  {
+    LASwriterAsyncBatch& batch = queue->batches[queue->head];
+    if (batch.inventory_end == batch.number - 1)
+    {
+      batch.inventory_end = batch.number;
+      last_point = 0;
+      return;
+    }
+    if (batch.inventory_end == batch.inventory_start)
+    {
+      batch.inventory_start = batch.number - 1;
+      batch.inventory_end = batch.number;
+      last_point = 0;
+      return;
+    }
+  }
+  last_point = 0;
+  inventory.add(point);
+}
+
+BOOL LASwriterAsync::chunk()
+{
+  return flush(TRUE);
+}
+
+// hands the current batch to the writer thread and waits for a free batch.
+// returns FALSE once the writer thread has failed.
+
+BOOL LASwriterAsync::flush(BOOL chunk_after)
+{
+  LASwriterAsyncBatch& batch = queue->batches[queue->head];
+  last_point = 0;
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  if (queue->failed) return FALSE;
+  if ((batch.number == 0) && !chunk_after) return TRUE;
+  batch.chunk_after = chunk_after;
+  queue->head = (queue->head + 1) % (U32)queue->batches.size();
+  queue->filled++;
+  queue->not_empty.notify_one();
+  queue->not_full.wait(lock, [this]{ return queue->filled < queue->batches.size(); });
+  return !queue->failed;
+}
+
+// waits until the writer thread has written everything handed over so far so
+// that the wrapped writer can be used directly
+
+BOOL LASwriterAsync::drain()
+{
+  if (queue == 0) return FALSE;
+  if (!flush(FALSE)) return FALSE;
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  queue->not_full.wait(lock, [this]{ return (queue->filled == 0) && !queue->busy; });
+  return !queue->failed;
+}
+
+void LASwriterAsync::merge_inventory()
+{
+  inventory.merge(&(queue->inventory));
+  queue->inventory = LASinventory();
+}
+
+BOOL LASwriterAsync::update_header(const LASheader* header, BOOL use_inventory, BOOL update_extra_bytes)
+{
+  if (!drain()) return FALSE;
+  merge_inventory();
+  if (use_inventory) writer->inventory = inventory;
+  return writer->update_header(header, use_inventory, update_extra_bytes);
+}
+
+I64 LASwriterAsync::tell()
+{
+  if (!drain()) return 0;
+  return writer->tell();
+}
+
+I64 LASwriterAsync::close(BOOL update_npoints)
+{
+  I64 bytes = 0;
+  if (queue)
+  {
+    BOOL failed = !drain();
+    {
+      std::lock_guard<std::mutex> lock(queue->mutex);
+      queue->quit = TRUE;
+    }
+    queue->not_empty.notify_one();
+    queue->worker.join();
+    merge_inventory();
+    if (failed)
+    {
+      laserror("writer thread failed to write the points. output is incomplete");
+    }
+    U32 i;
+    for (i = 0; i < queue->batches.size(); i++) free(queue->batches[i].points);
+    delete queue;
+    queue = 0;
+  }
+  if (writer)
+  {
+    bytes = writer->close(update_npoints);
+    npoints = writer->npoints;
+  }
+  return bytes;
+}
+
+LASwriterAsync::LASwriterAsync()
+{
+  writer = 0;
+  queue = 0;
+  point_size = 0;
+  point_data_format = 0;
+  last_point = 0;
+}
+
+LASwriterAsync::~LASwriterAsync()
+{
+  if (queue) close();
+  if (writer) delete writer;
+}
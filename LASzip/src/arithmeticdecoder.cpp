@@ -95,38 +95,124 @@
 
 #include "arithmeticdecoder.hpp"
 
+#include <stdlib.h>
 #include <string.h>
 #include <cassert>
 
 #include "arithmeticmodel.hpp"
+#include "bytestreamin_array.hpp"
 
 ArithmeticDecoder::ArithmeticDecoder()
 {
   instream = 0;
+  buffer_curr = 0;
+  buffer_end = 0;
+  buffer = 0;
+  instream_bytes = -1;
+  instream_position = 0;
+  model_blocks = 0;
+  model_blocks_number = 0;
+  model_memory = 0;
+  model_memory_left = 0;
+  initial_models = 0;
+  initial_models_number = 0;
   length = 0;
   value = 0;
 }
 
-BOOL ArithmeticDecoder::init(ByteStreamIn* instream, BOOL really_init)
+BOOL ArithmeticDecoder::init(ByteStreamIn* instream, BOOL really_init, I64 num_bytes)
 {
   if (instream == 0) return FALSE;
   this->instream = instream;
+  buffer_curr = buffer_end = 0;
+  // blocks are only read ahead when unused bytes can be returned to the instream
+  if ((num_bytes > 0) && instream->isSeekable())
+  {
+    instream_bytes = num_bytes;
+    instream_position = instream->tell();
+  }
+  else
+  {
+    instream_bytes = -1;
+  }
   length = AC__MaxLength;
   if (really_init)
   {
-    value = (instream->getByte() << 24);
-    value |= (instream->getByte() << 16);
-    value |= (instream->getByte() << 8);
-    value |= (instream->getByte());
+    if (buffer_curr == buffer_end) fill_buffer();
+    value = ((U32)*buffer_curr++ << 24);
+    if (buffer_curr == buffer_end) fill_buffer();
+    value |= ((U32)*buffer_curr++ << 16);
+    if (buffer_curr == buffer_end) fill_buffer();
+    value |= ((U32)*buffer_curr++ << 8);
+    if (buffer_curr == buffer_end) fill_buffer();
+    value |= ((U32)*buffer_curr++);
+  }
+  return TRUE;
+}
+
+BOOL ArithmeticDecoder::init(ByteStreamInArray* instream)
+{
+  if (instream == 0) return FALSE;
+  this->instream = 0;
+  buffer_curr = instream->getData() + instream->tell();
+  buffer_end = instream->getData() + instream->getSize();
+  instream_bytes = 0;
+  length = AC__MaxLength;
+  if (buffer_curr + 4 > buffer_end)
+  {
+    throw EOF;
   }
+  value = ((U32)buffer_curr[0] << 24) | ((U32)buffer_curr[1] << 16) | ((U32)buffer_curr[2] << 8) | (U32)buffer_curr[3];
+  buffer_curr += 4;
   return TRUE;
 }
 
 void ArithmeticDecoder::done()
 {
+  if (instream && (instream_bytes >= 0) && (buffer_curr < buffer_end))
+  {
+    instream->seek(instream_position - (buffer_end - buffer_curr));
+  }
+  buffer_curr = buffer_end = 0;
   instream = 0;
 }
 
+void ArithmeticDecoder::fill_buffer()
+{
+  if (instream == 0)
+  {
+    throw EOF;
+  }
+  if (buffer == 0)
+  {
+    buffer = new U8[AC_DECODER_BUFFER_SIZE];
+  }
+  if (instream_bytes > 0)
+  {
+    U32 num_bytes = (instream_bytes < AC_DECODER_BUFFER_SIZE ? (U32)instream_bytes : AC_DECODER_BUFFER_SIZE);
+    try
+    {
+      instream->getBytes(buffer, num_bytes);
+      instream_position += num_bytes;
+      instream_bytes -= num_bytes;
+      buffer_curr = buffer;
+      buffer_end = buffer + num_bytes;
+      return;
+    }
+    catch (...)
+    {
+      // fewer bytes than expected (truncated file?) so continue one by one
+      instream->seek(instream_position);
+      instream_bytes = 0;
+    }
+  }
+  // unknown number of bytes left or reading past the expected end
+  buffer[0] = (U8)instream->getByte();
+  if (instream_bytes >= 0) instream_position++;
+  buffer_curr = buffer;
+  buffer_end = buffer + 1;
+}
+
 ArithmeticBitModel* ArithmeticDecoder::createBitModel()
 {
   ArithmeticBitModel* m = new ArithmeticBitModel();
@@ -145,13 +231,17 @@ void ArithmeticDecoder::destroyBitModel(ArithmeticBitModel* m)
 
 ArithmeticModel* ArithmeticDecoder::createSymbolModel(U32 n)
 {
-  ArithmeticModel* m = new ArithmeticModel(n, FALSE);
+  U32 size = ArithmeticModel::get_memory_size(n, FALSE);
+  ArithmeticModel* m = new ArithmeticModel(n, FALSE, (size ? alloc_model_memory(size) : 0));
   return m;
 }
 
 void ArithmeticDecoder::initSymbolModel(ArithmeticModel* m, U32 *table)
 {
-  m->init(table);
+  if (table || m->init_copy(get_initial_model(m->get_symbols())))
+  {
+    m->init(table);
+  }
 }
 
 void ArithmeticDecoder::destroySymbolModel(ArithmeticModel* m)
@@ -159,6 +249,47 @@ void ArithmeticDecoder::destroySymbolModel(ArithmeticModel* m)
   delete m;
 }
 
+U32* ArithmeticDecoder::alloc_model_memory(U32 size)
+{
+  if (size > model_memory_left)
+  {
+    // blocks start small and grow for decoders that need many models
+    U32 block_size = (model_blocks_number ? 4096u << (model_blocks_number < 4 ? model_blocks_number : 4) : 4096u);
+    if (block_size < size) block_size = size;
+    model_blocks = (U32**)realloc(model_blocks, sizeof(U32*)*(model_blocks_number+1));
+    model_blocks[model_blocks_number] = new U32[block_size];
+    model_memory = model_blocks[model_blocks_number];
+    model_memory_left = block_size;
+    model_blocks_number++;
+  }
+  U32* memory = model_memory;
+  model_memory += size;
+  model_memory_left -= size;
+  return memory;
+}
+
+const ArithmeticModel* ArithmeticDecoder::get_initial_model(U32 symbols)
+{
+  U32 i;
+  for (i = 0; i < initial_models_number; i++)
+  {
+    if (initial_models[i]->get_symbols() == symbols)
+    {
+      return initial_models[i];
+    }
+  }
+  ArithmeticModel* m = createSymbolModel(symbols);
+  if (m->init())
+  {
+    delete m;
+    return 0;
+  }
+  initial_models = (ArithmeticModel**)realloc(initial_models, sizeof(ArithmeticModel*)*(initial_models_number+1));
+  initial_models[initial_models_number] = m;
+  initial_models_number++;
+  return m;
+}
+
 U32 ArithmeticDecoder::decodeBit(ArithmeticBitModel* m)
 {
   assert(m);
@@ -334,11 +465,24 @@ F64 ArithmeticDecoder::readDouble() /* danger in float reinterpretation */
 
 ArithmeticDecoder::~ArithmeticDecoder()
 {
+  U32 i;
+  for (i = 0; i < initial_models_number; i++)
+  {
+    delete initial_models[i];
+  }
+  if (initial_models) free(initial_models);
+  for (i = 0; i < model_blocks_number; i++)
+  {
+    delete [] model_blocks[i];
+  }
+  if (model_blocks) free(model_blocks);
+  if (buffer) delete [] buffer;
 }
 
 inline void ArithmeticDecoder::renorm_dec_interval()
 {
   do {                                          // read least-significant byte
-    value = (value << 8) | instream->getByte();
+    if (buffer_curr == buffer_end) fill_buffer();
+    value = (value << 8) | *buffer_curr++;
   } while ((length <<= 8) < AC__MinLength);        // length multiplied by 256
 }
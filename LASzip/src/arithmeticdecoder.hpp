@@ -25,6 +25,8 @@
 
   CHANGE HISTORY:
 
+    19 October 2026 -- symbol models are pooled and re-initialized by copying
+    19 October 2026 -- decodes from a byte window that is refilled in blocks
     22 August 2016 -- can be used as init dummy by "native LAS 1.4 compressor"
     13 November 2014 -- integrity check in readBits(), readByte(), readShort()
      6 September 2014 -- removed the (unused) inheritance from EntropyDecoder
@@ -40,6 +42,9 @@
 #include "mydefs.hpp"
 #include "bytestreamin.hpp"
 
+#define AC_DECODER_BUFFER_SIZE 16384
+
+class ByteStreamInArray;
 class ArithmeticModel;
 class ArithmeticBitModel;
 
@@ -51,8 +56,14 @@ public:
   ArithmeticDecoder();
   ~ArithmeticDecoder();
 
-/* Manage decoding                                           */
-  BOOL init(ByteStreamIn* instream, BOOL really_init = TRUE);
+/* Manage decoding. If the number of bytes that belong to   */
+/* the decoder are known they are read in blocks instead of  */
+/* one by one. Otherwise (-1) they are read one by one.      */
+  BOOL init(ByteStreamIn* instream, BOOL really_init = TRUE, I64 num_bytes = -1);
+/* Decode straight from the bytes of an array (the layers of */
+/* the LAS 1.4 compressor). The array itself is not advanced */
+  BOOL init(ByteStreamInArray* instream);
+/* Returns unused bytes of the last block to the instream    */
   void done();
 
 /* Manage an entropy model for a single bit                  */
@@ -60,7 +71,10 @@ public:
   void initBitModel(ArithmeticBitModel* model);
   void destroyBitModel(ArithmeticBitModel* model);
 
-/* Manage an entropy model for n symbols (table optional)    */
+/* Manage an entropy model for n symbols (table optional).  */
+/* Their memory is pooled by the decoder and lives as long  */
+/* as the decoder does. Without table they are initialized  */
+/* by copying a model that was initialized once.            */
   ArithmeticModel* createSymbolModel(U32 n);
   void initSymbolModel(ArithmeticModel* model, U32* table=0);
   void destroySymbolModel(ArithmeticModel* model);
@@ -102,6 +116,22 @@ private:
 
   ByteStreamIn* instream;
 
+  const U8* buffer_curr;
+  const U8* buffer_end;
+  U8* buffer;
+  I64 instream_bytes;
+  I64 instream_position;
+
+  U32** model_blocks;
+  U32 model_blocks_number;
+  U32* model_memory;
+  U32 model_memory_left;
+  ArithmeticModel** initial_models;
+  U32 initial_models_number;
+
+  U32* alloc_model_memory(U32 size);
+  const ArithmeticModel* get_initial_model(U32 symbols);
+  void fill_buffer();
   void renorm_dec_interval();
   U32 value, length;
 };
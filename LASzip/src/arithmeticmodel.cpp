@@ -71,11 +71,13 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
-ArithmeticModel::ArithmeticModel(U32 symbols, BOOL compress)
+ArithmeticModel::ArithmeticModel(U32 symbols, BOOL compress, U32* memory)
 {
   this->symbols = symbols;
   this->compress = compress;
+  this->memory = memory;
   distribution = 0;
   decoder_table = 0;
   last_symbol = 0;
@@ -89,38 +91,62 @@ ArithmeticModel::ArithmeticModel(U32 symbols, BOOL compress)
 
 ArithmeticModel::~ArithmeticModel()
 {
-  if (distribution) delete [] distribution;
+  if (distribution && (distribution != memory)) delete [] distribution;
+}
+
+U32 ArithmeticModel::get_memory_size(U32 symbols, BOOL compress)
+{
+  if ( (symbols < 2) || (symbols > (1 << 11)) )
+  {
+    return 0; // invalid number of symbols
+  }
+  if ((!compress) && (symbols > 16))
+  {
+    U32 table_bits = 3;
+    while (symbols > (1U << (table_bits + 2))) ++table_bits;
+    return 2*symbols+(1 << table_bits)+2;
+  }
+  return 2*symbols;
+}
+
+I32 ArithmeticModel::allocate()
+{
+  if ( (symbols < 2) || (symbols > (1 << 11)) )
+  {
+    return -1; // invalid number of symbols
+  }
+  last_symbol = symbols - 1;
+  if ((!compress) && (symbols > 16))
+  {
+    U32 table_bits = 3;
+    while (symbols > (1U << (table_bits + 2))) ++table_bits;
+    table_size  = 1 << table_bits;
+    table_shift = DM__LengthShift - table_bits;
+    distribution = (memory ? memory : new U32[2*symbols+table_size+2]);
+    decoder_table = distribution + 2 * symbols;
+  }
+  else // small alphabet: no table needed
+  {                                  
+    decoder_table = 0;
+    table_size = table_shift = 0;
+    distribution = (memory ? memory : new U32[2*symbols]);
+  }
+  if (distribution == 0)
+  {
+    return -1; // "cannot allocate model memory");
+  }
+  symbol_count = distribution + symbols;
+  return 0;
 }
 
 I32 ArithmeticModel::init(U32* table)
 {
   if (distribution == 0)
   {
-    if ( (symbols < 2) || (symbols > (1 << 11)) )
+    if (allocate())
     {
-      return -1; // invalid number of symbols
+      return -1;
     }
-    last_symbol = symbols - 1;
-    if ((!compress) && (symbols > 16))
-    {
-      U32 table_bits = 3;
-      while (symbols > (1U << (table_bits + 2))) ++table_bits;
-      table_size  = 1 << table_bits;
-      table_shift = DM__LengthShift - table_bits;
-      distribution = new U32[2*symbols+table_size+2];
-      decoder_table = distribution + 2 * symbols;
-    }
-    else // small alphabet: no table needed
-    {                                  
-      decoder_table = 0;
-      table_size = table_shift = 0;
-      distribution = new U32[2*symbols];
-    }
-    if (distribution == 0)
-    {
-      return -1; // "cannot allocate model memory");
-    }
-    symbol_count = distribution + symbols;
   }
 
   total_count = 0;
@@ -136,6 +162,28 @@ I32 ArithmeticModel::init(U32* table)
   return 0;
 }
 
+I32 ArithmeticModel::init_copy(const ArithmeticModel* initial)
+{
+  if ((initial == 0) || (initial->distribution == 0) || (initial->symbols != symbols) || (initial->compress != compress))
+  {
+    return -1;
+  }
+  if (distribution == 0)
+  {
+    if (allocate())
+    {
+      return -1;
+    }
+  }
+
+  memcpy(distribution, initial->distribution, sizeof(U32)*(2*symbols+(decoder_table ? table_size+2 : 0)));
+  total_count = initial->total_count;
+  update_cycle = initial->update_cycle;
+  symbols_until_update = initial->symbols_until_update;
+
+  return 0;
+}
+
 void ArithmeticModel::update()
 {
   // halve counts when a threshold is reached
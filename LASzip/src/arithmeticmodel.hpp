@@ -25,6 +25,7 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- memory can come from the coder and models re-init by copying
     11 April 2019 -- 1024 AC_BUFFER_SIZE to 4096 for propagate_carry() overflow
     10 January 2011 -- licensing change for LGPL release and liblas integration
     8 December 2010 -- unified framework for all entropy coders
@@ -58,13 +59,19 @@ const U32 DM__MaxCount    = 1 << DM__LengthShift;  // for adaptive models
 class LASLIB_DLL ArithmeticModel
 {
 public:
-  ArithmeticModel(U32 symbols, BOOL compress);
+  ArithmeticModel(U32 symbols, BOOL compress, U32* memory=0);
   ~ArithmeticModel();
 
   I32 init(U32* table=0);
+  I32 init_copy(const ArithmeticModel* initial);
+
+  U32 get_symbols() const { return symbols; };
+  static U32 get_memory_size(U32 symbols, BOOL compress);
 
 private:
+  I32 allocate();
   void update();
+  U32 * memory;
   U32 * distribution, * symbol_count, * decoder_table;
   U32 total_count, update_cycle, symbols_until_update;
   U32 symbols, last_symbol, table_size, table_shift;
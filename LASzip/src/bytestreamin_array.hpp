@@ -22,6 +22,7 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- access to the array so decoders can read it in place
     23 June 2016 -- alternative init option for "native LAS 1.4 compressor"
     19 July 2015 -- moved from LASlib to LASzip for "compatibility mode" in DLL
      9 April 2012 -- created after cooking Zuccini/Onion/Potatoe dinner for Mara
@@ -55,6 +56,10 @@ public:
   BOOL seek(const I64 position);
 /* seek to the end of the stream                             */
   BOOL seekEnd(const I64 distance=0);
+/* the bytes of the array (for reading them in place)        */
+  const U8* getData() const { return data; };
+/* the number of bytes in the array                          */
+  I64 getSize() const { return size; };
 /* destructor                                                */
   ~ByteStreamInArray(){};
 protected:
@@ -0,0 +1,174 @@
+/*
+===============================================================================
+
+  FILE:  bytestreamout_checksum.hpp
+
+  CONTENTS:
+
+    Class that passes all bytes on to another output stream and computes the
+    CRC-32 of the bytes that were written since the checksum was last reset.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- created for the checksums of LAZ chunks
+
+===============================================================================
+*/
+#ifndef BYTE_STREAM_OUT_CHECKSUM_H
+#define BYTE_STREAM_OUT_CHECKSUM_H
+
+#include "bytestreamout.hpp"
+
+class ByteStreamOutChecksum : public ByteStreamOut
+{
+public:
+  ByteStreamOutChecksum();
+/* pass the bytes on to this stream                          */
+  void init(ByteStreamOut* stream);
+/* checksum of the bytes written since the last reset        */
+  inline U32 getChecksum() const { return checksum; };
+  inline void resetChecksum() { checksum = 0; };
+/* write a single byte                                       */
+  BOOL putByte(U8 byte);
+/* write an array of bytes                                   */
+  BOOL putBytes(const U8* bytes, U32 num_bytes);
+/* write 16 bit low-endian field                             */
+  BOOL put16bitsLE(const U8* bytes);
+/* write 32 bit low-endian field                             */
+  BOOL put32bitsLE(const U8* bytes);
+/* write 64 bit low-endian field                             */
+  BOOL put64bitsLE(const U8* bytes);
+/* write 16 bit big-endian field                             */
+  BOOL put16bitsBE(const U8* bytes);
+/* write 32 bit big-endian field                             */
+  BOOL put32bitsBE(const U8* bytes);
+/* write 64 bit big-endian field                             */
+  BOOL put64bitsBE(const U8* bytes);
+/* is the stream seekable (e.g. standard out is not)         */
+  BOOL isSeekable() const;
+/* get current position of stream                            */
+  I64 tell() const;
+/* seek to this position in the stream                       */
+  BOOL seek(const I64 position);
+/* seek to the end of the file                               */
+  BOOL seekEnd();
+/* destructor                                                */
+  ~ByteStreamOutChecksum(){};
+private:
+  void addField(const U8* bytes, U32 num_bytes, BOOL little_endian);
+  ByteStreamOut* stream;
+  U32 checksum;
+};
+
+inline ByteStreamOutChecksum::ByteStreamOutChecksum()
+{
+  stream = 0;
+  checksum = 0;
+}
+
+inline void ByteStreamOutChecksum::init(ByteStreamOut* stream)
+{
+  this->stream = stream;
+  checksum = 0;
+}
+
+inline void ByteStreamOutChecksum::addField(const U8* bytes, U32 num_bytes, BOOL little_endian)
+{
+  // the checksum is over the bytes in the order they end up in the stream
+  if (little_endian == Endian::IS_LITTLE_ENDIAN)
+  {
+    checksum = crc32_las(checksum, bytes, num_bytes);
+  }
+  else
+  {
+    U8 swapped[8];
+    U32 i;
+    for (i = 0; i < num_bytes; i++) swapped[i] = bytes[num_bytes - 1 - i];
+    checksum = crc32_las(checksum, swapped, num_bytes);
+  }
+}
+
+inline BOOL ByteStreamOutChecksum::putByte(U8 byte)
+{
+  checksum = crc32_las(checksum, &byte, 1);
+  return stream->putByte(byte);
+}
+
+inline BOOL ByteStreamOutChecksum::putBytes(const U8* bytes, U32 num_bytes)
+{
+  checksum = crc32_las(checksum, bytes, num_bytes);
+  return stream->putBytes(bytes, num_bytes);
+}
+
+inline BOOL ByteStreamOutChecksum::put16bitsLE(const U8* bytes)
+{
+  addField(bytes, 2, TRUE);
+  return stream->put16bitsLE(bytes);
+}
+
+inline BOOL ByteStreamOutChecksum::put32bitsLE(const U8* bytes)
+{
+  addField(bytes, 4, TRUE);
+  return stream->put32bitsLE(bytes);
+}
+
+inline BOOL ByteStreamOutChecksum::put64bitsLE(const U8* bytes)
+{
+  addField(bytes, 8, TRUE);
+  return stream->put64bitsLE(bytes);
+}
+
+inline BOOL ByteStreamOutChecksum::put16bitsBE(const U8* bytes)
+{
+  addField(bytes, 2, FALSE);
+  return stream->put16bitsBE(bytes);
+}
+
+inline BOOL ByteStreamOutChecksum::put32bitsBE(const U8* bytes)
+{
+  addField(bytes, 4, FALSE);
+  return stream->put32bitsBE(bytes);
+}
+
+inline BOOL ByteStreamOutChecksum::put64bitsBE(const U8* bytes)
+{
+  addField(bytes, 8, FALSE);
+  return stream->put64bitsBE(bytes);
+}
+
+inline BOOL ByteStreamOutChecksum::isSeekable() const
+{
+  return stream->isSeekable();
+}
+
+inline I64 ByteStreamOutChecksum::tell() const
+{
+  return stream->tell();
+}
+
+inline BOOL ByteStreamOutChecksum::seek(I64 position)
+{
+  return stream->seek(position);
+}
+
+inline BOOL ByteStreamOutChecksum::seekEnd()
+{
+  return stream->seekEnd();
+}
+
+#endif
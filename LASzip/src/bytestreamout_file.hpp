@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- counts the bytes so tell() also works when standard out is a pipe
      1 October 2011 -- added 64 bit file support in MSVC 6.0 at McCafe at Hbf Linz
     10 January 2011 -- licensing change for LGPL release and liblas integration
     12 December 2010 -- created from ByteStreamOutFile after Howard got pushy (-;
@@ -59,6 +60,7 @@ public:
   ~ByteStreamOutFile(){};
 protected:
   FILE* file;
+  I64 count;
 };
 
 class ByteStreamOutFileLE : public ByteStreamOutFile
@@ -104,6 +106,7 @@ private:
 inline ByteStreamOutFile::ByteStreamOutFile(FILE* file)
 {
   this->file = file;
+  count = 0;
 }
 
 inline BOOL ByteStreamOutFile::refile(FILE* file)
@@ -115,11 +118,13 @@ inline BOOL ByteStreamOutFile::refile(FILE* file)
 
 inline BOOL ByteStreamOutFile::putByte(U8 byte)
 {
+  count++;
   return (fputc(byte, file) == byte);
 }
 
 inline BOOL ByteStreamOutFile::putBytes(const U8* bytes, U32 num_bytes)
 {
+  count += num_bytes;
   return (fwrite(bytes, 1, num_bytes, file) == num_bytes);
 }
 
@@ -130,6 +135,7 @@ inline BOOL ByteStreamOutFile::isSeekable() const
 
 inline I64 ByteStreamOutFile::tell() const
 {
+  if (file == stdout) return count; // ftell() fails when standard out is a pipe
   return ftell_las(file);
 }
 
@@ -44,7 +44,7 @@
 #include <math.h>
 #endif
 
-IntegerCompressor::IntegerCompressor(ArithmeticEncoder* enc, U32 bits, U32 contexts, U32 bits_high, U32 range)
+IntegerCompressor::IntegerCompressor(ArithmeticEncoder* enc, U32 bits, U32 contexts, U32 bits_high, U32 range, U32 bits_direct)
 {
   assert(enc);
   this->enc = enc;
@@ -52,6 +52,7 @@ IntegerCompressor::IntegerCompressor(ArithmeticEncoder* enc, U32 bits, U32 conte
   this->bits = bits;
   this->contexts = contexts;
   this->bits_high = bits_high;
+  this->bits_direct = bits_direct;
   this->range = range;
 
   if (range) // the corrector's significant bits and range
@@ -92,6 +93,7 @@ IntegerCompressor::IntegerCompressor(ArithmeticEncoder* enc, U32 bits, U32 conte
 
   mBits = 0;
   mCorrector = 0;
+  mDirect = 0;
 
 #ifdef CREATE_HISTOGRAMS
   corr_histogram = (int**)malloc_las(sizeof(int*) * (corr_bits + 1));
@@ -106,7 +108,7 @@ IntegerCompressor::IntegerCompressor(ArithmeticEncoder* enc, U32 bits, U32 conte
 #endif
 }
 
-IntegerCompressor::IntegerCompressor(ArithmeticDecoder* dec, U32 bits, U32 contexts, U32 bits_high, U32 range)
+IntegerCompressor::IntegerCompressor(ArithmeticDecoder* dec, U32 bits, U32 contexts, U32 bits_high, U32 range, U32 bits_direct)
 {
   assert(dec);
   this->enc = 0;
@@ -114,6 +116,7 @@ IntegerCompressor::IntegerCompressor(ArithmeticDecoder* dec, U32 bits, U32 conte
   this->bits = bits;
   this->contexts = contexts;
   this->bits_high = bits_high;
+  this->bits_direct = bits_direct;
   this->range = range;
 
   if (range) // the corrector's significant bits and range
@@ -154,6 +157,7 @@ IntegerCompressor::IntegerCompressor(ArithmeticDecoder* dec, U32 bits, U32 conte
 
   mBits = 0;
   mCorrector = 0;
+  mDirect = 0;
 }
 
 IntegerCompressor::~IntegerCompressor()
@@ -168,6 +172,15 @@ IntegerCompressor::~IntegerCompressor()
     }
     delete [] mBits;
   }
+  if (mDirect)
+  {
+    for (i = 0; i < contexts; i++)
+    {
+      if (enc) enc->destroySymbolModel(mDirect[i]);
+      else     dec->destroySymbolModel(mDirect[i]);
+    }
+    delete [] mDirect;
+  }
 #ifndef COMPRESS_ONLY_K
   if (mCorrector)
   {
@@ -230,6 +243,14 @@ void IntegerCompressor::initCompressor()
     {
       mBits[i] = enc->createSymbolModel(corr_bits+1);
     }
+    if (bits_direct)
+    {
+      mDirect = new ArithmeticModel*[contexts];
+      for (i = 0; i < contexts; i++)
+      {
+        mDirect[i] = enc->createSymbolModel((1<<bits_direct)+1);
+      }
+    }
 #ifndef COMPRESS_ONLY_K
     mCorrector = new ArithmeticModel*[corr_bits+1];
     mCorrector[0] = (ArithmeticModel*)enc->createBitModel();
@@ -252,6 +273,13 @@ void IntegerCompressor::initCompressor()
   {
     enc->initSymbolModel(mBits[i]);
   }
+  if (mDirect)
+  {
+    for (i = 0; i < contexts; i++)
+    {
+      enc->initSymbolModel(mDirect[i]);
+    }
+  }
 #ifndef COMPRESS_ONLY_K
   enc->initBitModel((ArithmeticBitModel*)mCorrector[0]);
   for (i = 1; i <= corr_bits; i++)
@@ -269,6 +297,25 @@ void IntegerCompressor::compress(I32 pred, I32 real, U32 context)
   // we fold the corrector into the interval [ corr_min  ...  corr_max ]
   if (corr < corr_min) corr += corr_range;
   else if (corr > corr_max) corr -= corr_range;
+  if (mDirect)
+  {
+    // small correctors are coded with a single symbol
+    I32 half = (1 << (bits_direct-1));
+    if ((corr >= -half) && (corr < half))
+    {
+      enc->encodeSymbol(mDirect[context], corr + half);
+      // but k is still needed by those who use getK() for their contexts
+      U32 c1 = (corr <= 0 ? -corr : corr-1);
+      k = 0;
+      while (c1)
+      {
+        c1 = c1 >> 1;
+        k = k + 1;
+      }
+      return;
+    }
+    enc->encodeSymbol(mDirect[context], (1 << bits_direct)); // escape
+  }
   writeCorrector(corr, mBits[context]);
 }
 
@@ -286,6 +333,14 @@ void IntegerCompressor::initDecompressor()
     {
       mBits[i] = dec->createSymbolModel(corr_bits+1);
     }
+    if (bits_direct)
+    {
+      mDirect = new ArithmeticModel*[contexts];
+      for (i = 0; i < contexts; i++)
+      {
+        mDirect[i] = dec->createSymbolModel((1<<bits_direct)+1);
+      }
+    }
 #ifndef COMPRESS_ONLY_K
     mCorrector = new ArithmeticModel*[corr_bits+1];
     mCorrector[0] = (ArithmeticModel*)dec->createBitModel();
@@ -308,6 +363,13 @@ void IntegerCompressor::initDecompressor()
   {
     dec->initSymbolModel(mBits[i]);
   }
+  if (mDirect)
+  {
+    for (i = 0; i < contexts; i++)
+    {
+      dec->initSymbolModel(mDirect[i]);
+    }
+  }
 #ifndef COMPRESS_ONLY_K
   dec->initBitModel((ArithmeticBitModel*)mCorrector[0]);
   for (i = 1; i <= corr_bits; i++)
@@ -320,7 +382,29 @@ void IntegerCompressor::initDecompressor()
 I32 IntegerCompressor::decompress(I32 pred, U32 context)
 {
   assert(dec);
-  I32 real = pred + readCorrector(mBits[context]);
+  I32 real;
+  if (mDirect)
+  {
+    // small correctors are coded with a single symbol
+    U32 sym = dec->decodeSymbol(mDirect[context]);
+    if (sym < (1u << bits_direct))
+    {
+      I32 corr = (I32)sym - (1 << (bits_direct-1));
+      // but k is still needed by those who use getK() for their contexts
+      U32 c1 = (corr <= 0 ? -corr : corr-1);
+      k = 0;
+      while (c1)
+      {
+        c1 = c1 >> 1;
+        k = k + 1;
+      }
+      real = pred + corr;
+      if (real < 0) real += corr_range;
+      else if ((U32)(real) >= corr_range) real -= corr_range;
+      return real;
+    }
+  }
+  real = pred + readCorrector(mBits[context]);
   if (real < 0) real += corr_range;
   else if ((U32)(real) >= corr_range) real -= corr_range;
   return real;
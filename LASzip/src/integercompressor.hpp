@@ -36,6 +36,7 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- optionally codes small correctors directly with a single symbol
      6 September 2014 -- removed inheritance of EntropyEncoder and EntropyDecoder
     10 January 2011 -- licensing change for LGPL release and liblas integration
     10 December 2010 -- unified for all entropy coders at Baeckerei Schaefer
@@ -56,8 +57,8 @@ class LASLIB_DLL IntegerCompressor
 public:
 
   // Constructor & Deconstructor
-  IntegerCompressor(ArithmeticEncoder* enc, U32 bits=16, U32 contexts=1, U32 bits_high=8, U32 range=0);
-  IntegerCompressor(ArithmeticDecoder* dec, U32 bits=16, U32 contexts=1, U32 bits_high=8, U32 range=0);
+  IntegerCompressor(ArithmeticEncoder* enc, U32 bits=16, U32 contexts=1, U32 bits_high=8, U32 range=0, U32 bits_direct=0);
+  IntegerCompressor(ArithmeticDecoder* dec, U32 bits=16, U32 contexts=1, U32 bits_high=8, U32 range=0, U32 bits_direct=0);
   ~IntegerCompressor();
 
   // Manage Compressor
@@ -79,6 +80,7 @@ private:
 
   U32 contexts;
   U32 bits_high;
+  U32 bits_direct;
 
   U32 bits;
   U32 range;
@@ -95,6 +97,11 @@ private:
 
   ArithmeticModel** mCorrector;
 
+  // with bits_direct correctors in [ - 2^(bits_direct-1) ... 2^(bits_direct-1) - 1 ] are
+  // coded with one symbol. the last symbol escapes to the k bits and the corrector above
+
+  ArithmeticModel** mDirect;
+
 #ifdef CREATE_HISTOGRAMS
   int** corr_histogram;
 #endif
@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- items of standard point formats can be read in one call
     28 August 2017 -- moving 'context' from global development hack to interface  
     23 August 2016 -- layering of items for selective decompression in LAS 1.4 
     10 January 2011 -- licensing change for LGPL release and liblas integration
@@ -73,4 +74,16 @@ public:
   virtual ~LASreadItemCompressed(){};
 };
 
+/* reads all items of a point with one call                  */
+typedef void (*LASreadItemsFunction)(LASreadItem** readers, U8* const * point, U32& context);
+
+/* reads a fixed sequence of item readers with direct calls  */
+/* so that their read() can be inlined where it is defined   */
+template <class... ITEMS>
+void LASreadItems(LASreadItem** readers, U8* const * point, U32& context)
+{
+  U32 i = 0;
+  ((static_cast<ITEMS*>(readers[i])->ITEMS::read(point[i], context), i++), ...);
+}
+
 #endif
@@ -30,6 +30,7 @@
 */
 
 #include "lasreaditemcompressed_v2.hpp"
+#include "laszip.hpp"
 
 #include <cassert>
 #include <string.h>
@@ -596,3 +597,36 @@ inline void LASreadItemCompressed_BYTE_v2::read(U8* item, U32& context)
   }
   memcpy(last_item, item, number);
 }
+
+LASreadItemsFunction select_read_items_v2(U32 num_items, const LASitem* items)
+{
+  U32 i;
+  for (i = 0; i < num_items; i++)
+  {
+    // the waveform items of point types 4 and 5 are only available as version 1
+    if (items[i].version != 2) return 0;
+  }
+  BOOL bytes = (items[num_items-1].type == LASitem::BYTE);
+  if (bytes) num_items--;
+  if (num_items == 1)
+  {
+    if (bytes) return &LASreadItems<LASreadItemCompressed_POINT10_v2, LASreadItemCompressed_BYTE_v2>;
+    return &LASreadItems<LASreadItemCompressed_POINT10_v2>;
+  }
+  if ((num_items == 2) && (items[1].type == LASitem::GPSTIME11))
+  {
+    if (bytes) return &LASreadItems<LASreadItemCompressed_POINT10_v2, LASreadItemCompressed_GPSTIME11_v2, LASreadItemCompressed_BYTE_v2>;
+    return &LASreadItems<LASreadItemCompressed_POINT10_v2, LASreadItemCompressed_GPSTIME11_v2>;
+  }
+  if ((num_items == 2) && (items[1].type == LASitem::RGB12))
+  {
+    if (bytes) return &LASreadItems<LASreadItemCompressed_POINT10_v2, LASreadItemCompressed_RGB12_v2, LASreadItemCompressed_BYTE_v2>;
+    return &LASreadItems<LASreadItemCompressed_POINT10_v2, LASreadItemCompressed_RGB12_v2>;
+  }
+  if ((num_items == 3) && (items[1].type == LASitem::GPSTIME11) && (items[2].type == LASitem::RGB12))
+  {
+    if (bytes) return &LASreadItems<LASreadItemCompressed_POINT10_v2, LASreadItemCompressed_GPSTIME11_v2, LASreadItemCompressed_RGB12_v2, LASreadItemCompressed_BYTE_v2>;
+    return &LASreadItems<LASreadItemCompressed_POINT10_v2, LASreadItemCompressed_GPSTIME11_v2, LASreadItemCompressed_RGB12_v2>;
+  }
+  return 0;
+}
@@ -24,6 +24,7 @@
 
   CHANGE HISTORY:
 
+    19 October 2026 -- standard point formats read all their items in one call
     28 August 2017 -- moving 'context' from global development hack to interface
     6 September 2014 -- removed inheritance of EntropyEncoder and EntropyDecoder
     5 March 2011 -- created first night in ibiza to improve the RGB compressor
@@ -39,6 +40,8 @@
 
 #include "laszip_common_v2.hpp"
 
+class LASitem;
+
 class LASLIB_DLL LASreadItemCompressed_POINT10_v2 : public LASreadItemCompressed
 {
 public:
@@ -136,4 +139,7 @@ private:
   ArithmeticModel** m_byte;
 };
 
+/* reads the items of standard point formats with one call */
+LASreadItemsFunction select_read_items_v2(U32 num_items, const LASitem* items);
+
 #endif
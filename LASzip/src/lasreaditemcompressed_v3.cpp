@@ -30,6 +30,7 @@
 */
 
 #include "lasreaditemcompressed_v3.hpp"
+#include "laszip.hpp"
 #include "lasmessage.hpp"
 
 #include <limits>
@@ -2457,3 +2458,41 @@ inline void LASreadItemCompressed_BYTE14_v3::read(U8* item, U32& context)
     }
   }
 }
+
+LASreadItemsFunction select_read_items_v3(U32 num_items, const LASitem* items)
+{
+  U32 i;
+  for (i = 0; i < num_items; i++)
+  {
+    // version 2 from lasproto is read like version 3 (except for waveforms)
+    if ((items[i].version != 3) && ((items[i].version != 2) || (items[i].type == LASitem::WAVEPACKET14))) return 0;
+  }
+  BOOL bytes = (items[num_items-1].type == LASitem::BYTE14);
+  if (bytes) num_items--;
+  if (num_items == 1)
+  {
+    if (bytes) return &LASreadItems<LASreadItemCompressed_POINT14_v3, LASreadItemCompressed_BYTE14_v3>;
+    return &LASreadItems<LASreadItemCompressed_POINT14_v3>;
+  }
+  if ((num_items == 2) && (items[1].type == LASitem::RGB14))
+  {
+    if (bytes) return &LASreadItems<LASreadItemCompressed_POINT14_v3, LASreadItemCompressed_RGB14_v3, LASreadItemCompressed_BYTE14_v3>;
+    return &LASreadItems<LASreadItemCompressed_POINT14_v3, LASreadItemCompressed_RGB14_v3>;
+  }
+  if ((num_items == 2) && (items[1].type == LASitem::RGBNIR14))
+  {
+    if (bytes) return &LASreadItems<LASreadItemCompressed_POINT14_v3, LASreadItemCompressed_RGBNIR14_v3, LASreadItemCompressed_BYTE14_v3>;
+    return &LASreadItems<LASreadItemCompressed_POINT14_v3, LASreadItemCompressed_RGBNIR14_v3>;
+  }
+  if ((num_items == 2) && (items[1].type == LASitem::WAVEPACKET14))
+  {
+    if (bytes) return &LASreadItems<LASreadItemCompressed_POINT14_v3, LASreadItemCompressed_WAVEPACKET14_v3, LASreadItemCompressed_BYTE14_v3>;
+    return &LASreadItems<LASreadItemCompressed_POINT14_v3, LASreadItemCompressed_WAVEPACKET14_v3>;
+  }
+  if ((num_items == 3) && (items[1].type == LASitem::RGBNIR14) && (items[2].type == LASitem::WAVEPACKET14))
+  {
+    if (bytes) return &LASreadItems<LASreadItemCompressed_POINT14_v3, LASreadItemCompressed_RGBNIR14_v3, LASreadItemCompressed_WAVEPACKET14_v3, LASreadItemCompressed_BYTE14_v3>;
+    return &LASreadItems<LASreadItemCompressed_POINT14_v3, LASreadItemCompressed_RGBNIR14_v3, LASreadItemCompressed_WAVEPACKET14_v3>;
+  }
+  return 0;
+}
@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- standard point formats read all their items in one call
     30 December 2021 -- fix small memory leak
     19 March 2019 -- set "legacy classification" to zero if "classification > 31"  
     28 August 2017 -- moving 'context' from global development hack to interface  
@@ -43,6 +44,8 @@
 #include "laszip_common_v3.hpp"
 #include "laszip_decompress_selective_v3.hpp"
 
+class LASitem;
+
 class LASLIB_DLL LASreadItemCompressed_POINT14_v3 : public LASreadItemCompressed
 {
 public:
@@ -273,4 +276,7 @@ private:
   BOOL createAndInitModelsAndDecompressors(U32 context, const U8* item);
 };
 
+/* reads the items of standard point formats with one call */
+LASreadItemsFunction select_read_items_v3(U32 num_items, const LASitem* items);
+
 #endif
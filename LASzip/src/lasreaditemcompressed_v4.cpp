@@ -30,6 +30,7 @@
 */
 
 #include "lasreaditemcompressed_v4.hpp"
+#include "laszip.hpp"
 #include "lasmessage.hpp"
 
 #include <cassert>
@@ -81,13 +82,18 @@ typedef struct LASpoint14
 
 #define LASZIP_GPSTIME_MULTI_TOTAL (LASZIP_GPSTIME_MULTI - LASZIP_GPSTIME_MULTI_MINUS + 5) 
 
-LASreadItemCompressed_POINT14_v4::LASreadItemCompressed_POINT14_v4(ArithmeticDecoder* dec, const U32 decompress_selective)
+LASreadItemCompressed_POINT14_v4::LASreadItemCompressed_POINT14_v4(ArithmeticDecoder* dec, const U32 decompress_selective, const U16 version)
 {
   /* not used as a decoder. just gives access to instream */
 
   assert(dec);
   this->dec = dec;
 
+  /* the item version selects the modeling level */
+
+  assert((version == 4) || (version == LASZIP_POINT14_VERSION_FAST) || (version == LASZIP_POINT14_VERSION_MAX));
+  this->version = version;
+
   /* zero instreams and decoders */
 
   instream_channel_returns_XY = 0;
@@ -256,12 +262,17 @@ inline BOOL LASreadItemCompressed_POINT14_v4::createAndInitModelsAndDecompressor
     }
     contexts[context].m_return_number_gps_same = dec_channel_returns_XY->createSymbolModel(13);
 
-    contexts[context].ic_dX = new IntegerCompressor(dec_channel_returns_XY, 32, 2);  // 32 bits, 2 context
-    contexts[context].ic_dY = new IntegerCompressor(dec_channel_returns_XY, 32, 22); // 32 bits, 22 contexts
+    /* the fast level codes small correctors with a single symbol and the max level models more of their bits */
+
+    U32 bits_high = (version == LASZIP_POINT14_VERSION_MAX ? LASZIP_POINT14_MAX_BITS_HIGH : 8);
+    U32 bits_direct = (version == LASZIP_POINT14_VERSION_FAST ? LASZIP_POINT14_FAST_BITS_DIRECT : 0);
+
+    contexts[context].ic_dX = new IntegerCompressor(dec_channel_returns_XY, 32, 2, bits_high, 0, bits_direct);  // 32 bits, 2 context
+    contexts[context].ic_dY = new IntegerCompressor(dec_channel_returns_XY, 32, 22, bits_high, 0, bits_direct); // 32 bits, 22 contexts
 
     /* for the Z layer */
 
-    contexts[context].ic_Z = new IntegerCompressor(dec_Z, 32, 20);  // 32 bits, 20 contexts
+    contexts[context].ic_Z = new IntegerCompressor(dec_Z, 32, 20, bits_high, 0, bits_direct);  // 32 bits, 20 contexts
 
     /* for the classification layer */
     /* for the flags layer */
@@ -276,7 +287,7 @@ inline BOOL LASreadItemCompressed_POINT14_v4::createAndInitModelsAndDecompressor
 
     /* for the intensity layer */
 
-    contexts[context].ic_intensity = new IntegerCompressor(dec_intensity, 16, 4);
+    contexts[context].ic_intensity = new IntegerCompressor(dec_intensity, 16, 4, 8, 0, bits_direct);
 
     /* for the scan_angle layer */
 
@@ -290,7 +301,7 @@ inline BOOL LASreadItemCompressed_POINT14_v4::createAndInitModelsAndDecompressor
 
     contexts[context].m_gpstime_multi = dec_gps_time->createSymbolModel(LASZIP_GPSTIME_MULTI_TOTAL);
     contexts[context].m_gpstime_0diff = dec_gps_time->createSymbolModel(5);
-    contexts[context].ic_gpstime = new IntegerCompressor(dec_gps_time, 32, 9); // 32 bits, 9 contexts
+    contexts[context].ic_gpstime = new IntegerCompressor(dec_gps_time, 32, 9, bits_high, 0, bits_direct); // 32 bits, 9 contexts
   }
 
   /* then init entropy models and integer compressors */
@@ -2454,3 +2465,40 @@ inline void LASreadItemCompressed_BYTE14_v4::read(U8* item, U32& context)
     }
   }
 }
+
+LASreadItemsFunction select_read_items_v4(U32 num_items, const LASitem* items)
+{
+  U32 i;
+  for (i = 0; i < num_items; i++)
+  {
+    if (items[i].version != 4) return 0;
+  }
+  BOOL bytes = (items[num_items-1].type == LASitem::BYTE14);
+  if (bytes) num_items--;
+  if (num_items == 1)
+  {
+    if (bytes) return &LASreadItems<LASreadItemCompressed_POINT14_v4, LASreadItemCompressed_BYTE14_v4>;
+    return &LASreadItems<LASreadItemCompressed_POINT14_v4>;
+  }
+  if ((num_items == 2) && (items[1].type == LASitem::RGB14))
+  {
+    if (bytes) return &LASreadItems<LASreadItemCompressed_POINT14_v4, LASreadItemCompressed_RGB14_v4, LASreadItemCompressed_BYTE14_v4>;
+    return &LASreadItems<LASreadItemCompressed_POINT14_v4, LASreadItemCompressed_RGB14_v4>;
+  }
+  if ((num_items == 2) && (items[1].type == LASitem::RGBNIR14))
+  {
+    if (bytes) return &LASreadItems<LASreadItemCompressed_POINT14_v4, LASreadItemCompressed_RGBNIR14_v4, LASreadItemCompressed_BYTE14_v4>;
+    return &LASreadItems<LASreadItemCompressed_POINT14_v4, LASreadItemCompressed_RGBNIR14_v4>;
+  }
+  if ((num_items == 2) && (items[1].type == LASitem::WAVEPACKET14))
+  {
+    if (bytes) return &LASreadItems<LASreadItemCompressed_POINT14_v4, LASreadItemCompressed_WAVEPACKET14_v4, LASreadItemCompressed_BYTE14_v4>;
+    return &LASreadItems<LASreadItemCompressed_POINT14_v4, LASreadItemCompressed_WAVEPACKET14_v4>;
+  }
+  if ((num_items == 3) && (items[1].type == LASitem::RGBNIR14) && (items[2].type == LASitem::WAVEPACKET14))
+  {
+    if (bytes) return &LASreadItems<LASreadItemCompressed_POINT14_v4, LASreadItemCompressed_RGBNIR14_v4, LASreadItemCompressed_WAVEPACKET14_v4, LASreadItemCompressed_BYTE14_v4>;
+    return &LASreadItems<LASreadItemCompressed_POINT14_v4, LASreadItemCompressed_RGBNIR14_v4, LASreadItemCompressed_WAVEPACKET14_v4>;
+  }
+  return 0;
+}
@@ -24,6 +24,8 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- POINT14 item version selects the fast or the max modeling level
+    19 October 2026 -- standard point formats read all their items in one call
     30 December 2021 -- fix small memory leak
     19 March 2019 -- set "legacy classification" to zero if "classification > 31"  
     28 December 2017 -- fix incorrect 'context switch' reported by Wanwannodao 
@@ -44,11 +46,13 @@
 #include "laszip_common_v3.hpp"
 #include "laszip_decompress_selective_v3.hpp"
 
+class LASitem;
+
 class LASLIB_DLL LASreadItemCompressed_POINT14_v4 : public LASreadItemCompressed
 {
 public:
 
-  LASreadItemCompressed_POINT14_v4(ArithmeticDecoder* dec, const U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL);
+  LASreadItemCompressed_POINT14_v4(ArithmeticDecoder* dec, const U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL, const U16 version=4);
 
   BOOL chunk_sizes();
   BOOL init(const U8* item, U32& context); // context is set
@@ -62,6 +66,10 @@ private:
   
   ArithmeticDecoder* dec;
 
+  /* 4 or one of the modeling levels LASZIP_POINT14_VERSION_FAST and LASZIP_POINT14_VERSION_MAX */
+
+  U16 version;
+
   ByteStreamInArray* instream_channel_returns_XY;
   ByteStreamInArray* instream_Z;
   ByteStreamInArray* instream_classification;
@@ -274,4 +282,7 @@ private:
   BOOL createAndInitModelsAndDecompressors(U32 context, const U8* item);
 };
 
+/* reads the items of standard point formats with one call */
+LASreadItemsFunction select_read_items_v4(U32 num_items, const LASitem* items);
+
 #endif
@@ -32,6 +32,7 @@
 #include "lasreadpoint.hpp"
 
 #include "arithmeticdecoder.hpp"
+#include "bytestreamin_array.hpp"
 #include "lasmessage.hpp"
 #include "lasreaditemraw.hpp"
 #include "lasreaditemcompressed_v1.hpp"
@@ -44,6 +45,99 @@
 #include <string.h>
 #include <limits>
 #include <exception>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// the v3 and v4 readers of POINT14 copy their complete LASpoint14 struct into the item
+#define LAS_READ_POINT_POINT14_STRUCT_SIZE 48
+
+enum LASreadPointChunkState
+{
+  LAS_READ_POINT_CHUNK_FREE,
+  LAS_READ_POINT_CHUNK_QUEUED,
+  LAS_READ_POINT_CHUNK_DECODING,
+  LAS_READ_POINT_CHUNK_DONE,
+  LAS_READ_POINT_CHUNK_FAILED
+};
+
+struct LASreadPointChunk
+{
+  U32 state;
+  U32 chunk;
+  U32 number;
+  std::vector<U8> bytes;
+  std::vector<U8> points;
+};
+
+class LASreadPointParallel
+{
+public:
+  std::vector<LASreadPointChunk> chunks;
+  std::vector<LASreadPoint*> decoders;
+  std::vector<std::thread> workers;
+  U32 next_chunk;  // next chunk to be handed to the workers
+  U32 head;        // next slot to be filled by the reading thread
+  U32 tail;        // slot whose points are currently being read
+  U32 index;       // next point to be read from the tail slot
+  U32 filled;      // slots handed over but not yet read
+  U32 ahead;       // slots kept busy (starts small after each seek)
+  BOOL quit;
+  std::mutex mutex;
+  std::condition_variable queued;
+  std::condition_variable decoded;
+  ~LASreadPointParallel();
+};
+
+static void las_read_point_parallel_run(LASreadPointParallel* parallel, LASreadPoint* decoder)
+{
+  while (true)
+  {
+    LASreadPointChunk* chunk = 0;
+    {
+      std::unique_lock<std::mutex> lock(parallel->mutex);
+      parallel->queued.wait(lock, [parallel, &chunk]{
+        if (parallel->quit) return true;
+        for (size_t c = 0; c < parallel->chunks.size(); c++)
+        {
+          if (parallel->chunks[c].state == LAS_READ_POINT_CHUNK_QUEUED)
+          {
+            chunk = &(parallel->chunks[c]);
+            return true;
+          }
+        }
+        return false;
+      });
+      if (parallel->quit) return;
+      chunk->state = LAS_READ_POINT_CHUNK_DECODING;
+    }
+    BOOL decoded = decoder->read_chunk(chunk->bytes.data(), (U32)chunk->bytes.size(), chunk->number, chunk->points.data());
+    {
+      std::lock_guard<std::mutex> lock(parallel->mutex);
+      chunk->state = (decoded ? LAS_READ_POINT_CHUNK_DONE : LAS_READ_POINT_CHUNK_FAILED);
+    }
+    parallel->decoded.notify_all();
+  }
+}
+
+LASreadPointParallel::~LASreadPointParallel()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    quit = TRUE;
+  }
+  queued.notify_all();
+  size_t i;
+  for (i = 0; i < workers.size(); i++)
+  {
+    workers[i].join();
+  }
+  for (i = 0; i < decoders.size(); i++)
+  {
+    delete decoders[i];
+  }
+}
 
 
 LASreadPoint::LASreadPoint(U32 decompress_selective)
@@ -54,6 +148,7 @@ LASreadPoint::LASreadPoint(U32 decompress_selective)
   readers = 0;
   readers_raw = 0;
   readers_compressed = 0;
+  read_compressed = 0;
   dec = 0;
   layered_las14_compression = FALSE;
   // used for chunking
@@ -69,6 +164,21 @@ LASreadPoint::LASreadPoint(U32 decompress_selective)
   // used for seeking
   point_start = 0;
   seek_point = 0;
+  seek_cache_max_bytes = 0;
+  seek_caching = FALSE;
+  seek_cache = 0;
+  seek_cache_alloced = 0;
+  seek_cached = 0;
+  seek_replay = 0;
+  // used for decoding chunks in parallel
+  threads = 0;
+  number_of_points = 0;
+  num_items = 0;
+  items = 0;
+  laszip = 0;
+  chunk_item_offsets = 0;
+  chunk_point_stride = 0;
+  parallel = 0;
   // used for error and warning reporting
   last_error = 0;
   last_warning = 0;
@@ -118,6 +228,7 @@ BOOL LASreadPoint::setup(U32 num_items, const LASitem* items, const LASzip* lasz
  
   // initizalize the readers
   readers = 0;
+  read_compressed = 0;
   num_readers = num_items;
 
   // disable chunking
@@ -254,8 +365,8 @@ BOOL LASreadPoint::setup(U32 num_items, const LASitem* items, const LASzip* lasz
       case LASitem::POINT14:
         if ((items[i].version == 3) || (items[i].version == 2)) // version == 2 from lasproto
           readers_compressed[i] = new LASreadItemCompressed_POINT14_v3(dec, decompress_selective);
-        else if (items[i].version == 4)
-          readers_compressed[i] = new LASreadItemCompressed_POINT14_v4(dec, decompress_selective);
+        else if ((items[i].version == 4) || (items[i].version == LASZIP_POINT14_VERSION_FAST) || (items[i].version == LASZIP_POINT14_VERSION_MAX))
+          readers_compressed[i] = new LASreadItemCompressed_POINT14_v4(dec, decompress_selective, items[i].version);
         else
           return FALSE;
         break;
@@ -317,7 +428,37 @@ BOOL LASreadPoint::setup(U32 num_items, const LASitem* items, const LASzip* lasz
     {
       if (laszip->chunk_size) chunk_size = laszip->chunk_size;
       number_chunks = U32_MAX;
+      // copy the items and the chunking for the decoders of parallel threads
+      // because the caller may free its LASzip before the threads start
+      if (this->laszip) delete this->laszip;
+      this->laszip = new LASzip();
+      this->laszip->compressor = laszip->compressor;
+      this->laszip->coder = laszip->coder;
+      this->laszip->chunk_size = laszip->chunk_size;
+      this->laszip->num_items = laszip->num_items;
+      this->laszip->items = new LASitem[num_items];
+      for (i = 0; i < num_items; i++)
+      {
+        this->laszip->items[i] = items[i];
+      }
+      this->num_items = num_items;
+      this->items = this->laszip->items;
+      // where each item of a point lives when complete chunks are decoded
+      chunk_item_offsets = new U32[num_items+1];
+      chunk_item_offsets[0] = 0;
+      for (i = 0; i < num_items; i++)
+      {
+        U32 span = items[i].size;
+        if ((items[i].type == LASitem::POINT14) && (span < LAS_READ_POINT_POINT14_STRUCT_SIZE)) span = LAS_READ_POINT_POINT14_STRUCT_SIZE;
+        chunk_item_offsets[i+1] = chunk_item_offsets[i] + span;
+      }
+      chunk_point_stride = chunk_item_offsets[num_items];
     }
+    // standard point formats read their items without virtual calls
+    if (items[0].type == LASitem::POINT10)
+      read_compressed = select_read_items_v2(num_items, items);
+    else if (items[0].type == LASitem::POINT14)
+      read_compressed = (items[0].version >= 4 ? select_read_items_v4(num_items, items) : select_read_items_v3(num_items, items));
   }
   return TRUE;
 }
@@ -351,9 +492,13 @@ BOOL LASreadPoint::init(ByteStreamIn* instream)
 BOOL LASreadPoint::seek(const U64 current, const U64 target)
 {
   if (!instream->isSeekable()) return FALSE;
+  if (parallel) return seek_parallel(target);
   U64 delta = 0;
   if (dec)
   {
+    // from now on the decoded points of the current chunk are kept
+    seek_caching = (seek_cache_max_bytes && chunk_point_stride);
+    seek_replay = 0;
     if (point_start == 0)
     {
       init_dec();
@@ -389,7 +534,13 @@ BOOL LASreadPoint::seek(const U64 current, const U64 target)
         }
         delta += (chunk_size*(target_chunk-current_chunk) - chunk_count);
       }
-      else if (current_chunk != target_chunk || current > target)
+      else if ((current_chunk == target_chunk) && (delta < chunk_count) && (seek_cached == chunk_count))
+      {
+        // all points before the decoder position are in the cache
+        seek_replay = (U32)(chunk_count - delta);
+        delta = 0;
+      }
+      else if (current_chunk != target_chunk || delta < chunk_count)
       {
         dec->done();
         current_chunk = target_chunk;
@@ -399,7 +550,8 @@ BOOL LASreadPoint::seek(const U64 current, const U64 target)
       }
       else
       {
-        delta = target - current;
+        // the decoder may be ahead of 'current' after replaying cached points
+        delta -= chunk_count;
       }
     }
     else if (current > target)
@@ -437,6 +589,20 @@ BOOL LASreadPoint::read(U8* const * point)
   U32 i;
   U32 context = 0;
 
+  if (parallel) return read_parallel(point);
+
+  if (seek_replay)
+  {
+    // points that were decoded before a seek back come from the cache
+    const U8* item = seek_cache + (size_t)(chunk_count - seek_replay) * chunk_point_stride;
+    for (i = 0; i < num_readers; i++)
+    {
+      memcpy(point[i], item + chunk_item_offsets[i], chunk_item_offsets[i+1] - chunk_item_offsets[i]);
+    }
+    seek_replay--;
+    return TRUE;
+  }
+
   try
   {
     if (dec)
@@ -481,15 +647,27 @@ BOOL LASreadPoint::read(U8* const * point)
             chunk_size = 0;
           }
         }
+        // from here on the chunks may be decoded by several threads
+        if ((threads > 1) && start_parallel())
+        {
+          return read_parallel(point);
+        }
         chunk_count = 0;
       }
       chunk_count++;
 
       if (readers)
       {
-        for (i = 0; i < num_readers; i++)
+        if (read_compressed)
+        {
+          read_compressed(readers, point, context);
+        }
+        else
         {
-          readers[i]->read(point[i], context);
+          for (i = 0; i < num_readers; i++)
+          {
+            readers[i]->read(point[i], context);
+          }
         }
       }
       else
@@ -522,10 +700,20 @@ BOOL LASreadPoint::read(U8* const * point)
           {
             ((LASreadItemCompressed*)(readers_compressed[i]))->init(point[i], context);
           }
-          dec->init(instream);
+          // if the chunk table tells where the chunk ends the decoder reads it in blocks
+          I64 num_bytes = -1;
+          if ((current_chunk + 1) < tabled_chunks)
+          {
+            num_bytes = chunk_starts[current_chunk+1] - instream->tell();
+          }
+          dec->init(instream, TRUE, num_bytes);
         }
         readers = readers_compressed;
       }
+      if (seek_caching && (seek_cached == (chunk_count - 1)))
+      {
+        cache_point(point);
+      }
     }
     else
     {
@@ -537,6 +725,7 @@ BOOL LASreadPoint::read(U8* const * point)
   }
   catch (I32 exception) 
   {
+    seek_cached = 0;
     // create error string
     if (last_error == 0) last_error = new CHAR[128];
     // report error
@@ -559,6 +748,8 @@ BOOL LASreadPoint::read(U8* const * point)
       // if we know where the next chunk starts ...
       if ((current_chunk+1) < tabled_chunks)
       {
+        // ... forget what the decoder has buffered of this chunk
+        if (dec) dec->done();
         // ... try to seek to the next chunk
         instream->seek(chunk_starts[(current_chunk+1)]);
         // ... ready for next LASreadPoint::read()
@@ -569,6 +760,7 @@ BOOL LASreadPoint::read(U8* const * point)
   }
   catch (const std::exception& e)
   {
+    seek_cached = 0;
     if (last_error == 0) last_error = new CHAR[128];
     snprintf(last_error, 128, "chunk with index %u is corrupt or requests excessive memory: %s", current_chunk, e.what());
     return FALSE;
@@ -578,6 +770,8 @@ BOOL LASreadPoint::read(U8* const * point)
 
 BOOL LASreadPoint::check_end()
 {
+  // the threads verified that each chunk ended where the chunk table says
+  if (parallel) return TRUE;
   if (readers == readers_compressed)
   {
     if (dec)
@@ -604,10 +798,344 @@ BOOL LASreadPoint::check_end()
 
 BOOL LASreadPoint::done()
 {
+  if (parallel)
+  {
+    delete parallel;
+    parallel = 0;
+  }
   instream = 0;
   return TRUE;
 }
 
+BOOL LASreadPoint::set_threads(const U32 threads, const U64 number_of_points)
+{
+  this->threads = threads;
+  this->number_of_points = number_of_points;
+  // only chunked compression can be decoded in parallel
+  return (dec && chunk_item_offsets);
+}
+
+BOOL LASreadPoint::read_chunk(const U8* bytes, const U32 num_bytes, const U32 number, U8* points)
+{
+  if ((dec == 0) || (chunk_item_offsets == 0) || (bytes == 0) || (points == 0) || (number == 0))
+  {
+    return FALSE;
+  }
+
+  ByteStreamInArrayLE stream_le(bytes, num_bytes);
+  ByteStreamInArrayBE stream_be(bytes, num_bytes);
+  ByteStreamInArray* stream = (Endian::IS_LITTLE_ENDIAN ? (ByteStreamInArray*)&stream_le : (ByteStreamInArray*)&stream_be);
+
+  std::vector<U8*> item(num_readers);
+  U32 i, p;
+  U32 context = 0;
+
+  try
+  {
+    // the first point of a chunk is stored raw
+    for (i = 0; i < num_readers; i++)
+    {
+      item[i] = points + chunk_item_offsets[i];
+      // because extended_point_type must be set
+      if (items[i].type == LASitem::POINT14) item[i][22] = 1;
+      ((LASreadItemRaw*)(readers_raw[i]))->init(stream);
+      readers_raw[i]->read(item[i], context);
+    }
+    if (layered_las14_compression)
+    {
+      // for layered compression 'dec' only hands over the stream
+      dec->init(stream, FALSE);
+      // read how many points are in the chunk
+      U32 count;
+      stream->get32bitsLE((U8*)&count);
+      // read the sizes of all layers
+      for (i = 0; i < num_readers; i++)
+      {
+        ((LASreadItemCompressed*)(readers_compressed[i]))->chunk_sizes();
+      }
+      for (i = 0; i < num_readers; i++)
+      {
+        ((LASreadItemCompressed*)(readers_compressed[i]))->init(item[i], context);
+      }
+    }
+    else
+    {
+      for (i = 0; i < num_readers; i++)
+      {
+        ((LASreadItemCompressed*)(readers_compressed[i]))->init(item[i], context);
+      }
+      dec->init(stream, TRUE, (I64)num_bytes - stream->tell());
+    }
+    // all other points are decompressed
+    for (p = 1; p < number; p++)
+    {
+      for (i = 0; i < num_readers; i++)
+      {
+        item[i] += chunk_point_stride;
+      }
+      if (read_compressed)
+      {
+        read_compressed(readers_compressed, item.data(), context);
+      }
+      else
+      {
+        for (i = 0; i < num_readers; i++)
+        {
+          readers_compressed[i]->read(item[i], context);
+        }
+      }
+    }
+    dec->done();
+  }
+  catch (...)
+  {
+    dec->done();
+    return FALSE;
+  }
+  // a chunk that does not end where the next one starts is corrupt
+  return (stream->tell() == (I64)num_bytes);
+}
+
+BOOL LASreadPoint::init_chunks(const U64 number_of_points)
+{
+  this->number_of_points = number_of_points;
+  if ((dec == 0) || (chunk_item_offsets == 0) || (instream == 0) || !instream->isSeekable())
+  {
+    return FALSE;
+  }
+  if (point_start == 0)
+  {
+    if (!init_dec()) return FALSE;
+    chunk_count = 0;
+  }
+  return complete_chunk_table();
+}
+
+BOOL LASreadPoint::complete_chunk_table() const
+{
+  if ((chunk_starts == 0) || (number_chunks == 0) || (number_chunks == U32_MAX) || (tabled_chunks != (number_chunks + 1)))
+  {
+    return FALSE;
+  }
+  // fixed-sized chunks need the number of points to know how many are in the last one
+  if ((chunk_totals == 0) && ((chunk_size == 0) || (chunk_size == U32_MAX) || (number_of_points == 0)))
+  {
+    return FALSE;
+  }
+  return TRUE;
+}
+
+U32 LASreadPoint::get_chunk_number_of_points(const U32 chunk) const
+{
+  if (chunk_totals)
+  {
+    return (U32)(chunk_totals[chunk+1] - chunk_totals[chunk]);
+  }
+  U64 first = (U64)chunk * chunk_size;
+  if (first >= number_of_points)
+  {
+    return 0;
+  }
+  return ((number_of_points - first) < chunk_size ? (U32)(number_of_points - first) : chunk_size);
+}
+
+BOOL LASreadPoint::start_parallel()
+{
+  // the chunks are found with the chunk table and read from a seekable stream
+  if (parallel || (chunk_item_offsets == 0) || !instream->isSeekable() || !complete_chunk_table() || (number_chunks < 2))
+  {
+    return FALSE;
+  }
+  LASreadPointParallel* engine = new LASreadPointParallel();
+  engine->next_chunk = current_chunk;
+  engine->head = 0;
+  engine->tail = 0;
+  engine->index = 0;
+  engine->filled = 0;
+  engine->ahead = 1;
+  engine->quit = FALSE;
+  engine->chunks.resize(2 * (size_t)threads);
+  U32 i;
+  for (i = 0; i < engine->chunks.size(); i++)
+  {
+    engine->chunks[i].state = LAS_READ_POINT_CHUNK_FREE;
+    engine->chunks[i].chunk = 0;
+    engine->chunks[i].number = 0;
+  }
+  for (i = 0; i < threads; i++)
+  {
+    LASreadPoint* decoder = new LASreadPoint(decompress_selective);
+    if (!decoder->setup(num_items, items, laszip))
+    {
+      delete decoder;
+      break;
+    }
+    engine->decoders.push_back(decoder);
+  }
+  for (i = 0; i < engine->decoders.size(); i++)
+  {
+    try { engine->workers.push_back(std::thread(las_read_point_parallel_run, engine, engine->decoders[i])); } catch (...) { break; }
+  }
+  if (engine->workers.size() == 0)
+  {
+    delete engine;
+    return FALSE;
+  }
+  parallel = engine;
+  return TRUE;
+}
+
+void LASreadPoint::fill_parallel()
+{
+  while ((parallel->filled < parallel->ahead) && (parallel->next_chunk < number_chunks))
+  {
+    LASreadPointChunk* chunk = &(parallel->chunks[parallel->head]);
+    U32 number = get_chunk_number_of_points(parallel->next_chunk);
+    if (number == 0)
+    {
+      // no more points in the remaining chunks
+      parallel->next_chunk = number_chunks;
+      break;
+    }
+    U32 state = LAS_READ_POINT_CHUNK_QUEUED;
+    I64 num_bytes = chunk_starts[parallel->next_chunk+1] - chunk_starts[parallel->next_chunk];
+    if ((num_bytes <= 0) || (num_bytes > (I64)U32_MAX))
+    {
+      state = LAS_READ_POINT_CHUNK_FAILED;
+    }
+    else
+    {
+      try
+      {
+        chunk->bytes.resize((size_t)num_bytes);
+        chunk->points.resize((size_t)number * chunk_point_stride);
+        if (instream->tell() != chunk_starts[parallel->next_chunk])
+        {
+          instream->seek(chunk_starts[parallel->next_chunk]);
+        }
+        instream->getBytes(chunk->bytes.data(), (U32)num_bytes);
+      }
+      catch (...)
+      {
+        state = LAS_READ_POINT_CHUNK_FAILED;
+      }
+    }
+    chunk->chunk = parallel->next_chunk;
+    chunk->number = number;
+    {
+      std::lock_guard<std::mutex> lock(parallel->mutex);
+      chunk->state = state;
+    }
+    if (state == LAS_READ_POINT_CHUNK_QUEUED) parallel->queued.notify_one();
+    parallel->head = (parallel->head + 1) % (U32)parallel->chunks.size();
+    parallel->next_chunk++;
+    parallel->filled++;
+  }
+}
+
+BOOL LASreadPoint::read_parallel(U8* const * point)
+{
+  fill_parallel();
+  if (parallel->filled == 0)
+  {
+    if (last_error == 0) last_error = new CHAR[128];
+    snprintf(last_error, 128, "end-of-file after chunk with index %u", current_chunk);
+    return FALSE;
+  }
+  LASreadPointChunk* chunk = &(parallel->chunks[parallel->tail]);
+  {
+    std::unique_lock<std::mutex> lock(parallel->mutex);
+    parallel->decoded.wait(lock, [chunk]{ return (chunk->state == LAS_READ_POINT_CHUNK_DONE) || (chunk->state == LAS_READ_POINT_CHUNK_FAILED); });
+  }
+  current_chunk = chunk->chunk;
+  BOOL valid = ((chunk->state == LAS_READ_POINT_CHUNK_DONE) && (parallel->index < chunk->number));
+  if (valid)
+  {
+    U32 i;
+    const U8* item = chunk->points.data() + (size_t)parallel->index * chunk_point_stride;
+    for (i = 0; i < num_readers; i++)
+    {
+      memcpy(point[i], item + chunk_item_offsets[i], chunk_item_offsets[i+1] - chunk_item_offsets[i]);
+    }
+    parallel->index++;
+  }
+  if (!valid || (parallel->index == chunk->number))
+  {
+    // hand the slot back and keep more workers busy the longer we read sequentially
+    {
+      std::lock_guard<std::mutex> lock(parallel->mutex);
+      chunk->state = LAS_READ_POINT_CHUNK_FREE;
+    }
+    parallel->tail = (parallel->tail + 1) % (U32)parallel->chunks.size();
+    parallel->filled--;
+    parallel->index = 0;
+    if (parallel->ahead < parallel->chunks.size()) parallel->ahead++;
+  }
+  if (!valid)
+  {
+    // create error string
+    if (last_error == 0) last_error = new CHAR[128];
+    // report error
+    snprintf(last_error, 128, "chunk with index %u of %u is corrupt", current_chunk, tabled_chunks);
+    return FALSE;
+  }
+  return TRUE;
+}
+
+BOOL LASreadPoint::seek_parallel(const U64 target)
+{
+  U32 target_chunk;
+  U64 delta;
+  if (chunk_totals)
+  {
+    target_chunk = search_chunk_table(target, 0, number_chunks);
+    delta = target - chunk_totals[target_chunk];
+  }
+  else
+  {
+    target_chunk = (U32)(target / chunk_size);
+    delta = target % chunk_size;
+  }
+  if (target_chunk >= number_chunks)
+  {
+    return FALSE;
+  }
+  // maybe the target is in the chunk that is being read
+  if (parallel->filled && (parallel->chunks[parallel->tail].chunk == target_chunk))
+  {
+    parallel->index = (U32)delta;
+    return TRUE;
+  }
+  // otherwise withdraw all chunks and start over at the target chunk
+  {
+    std::unique_lock<std::mutex> lock(parallel->mutex);
+    U32 i;
+    for (i = 0; i < parallel->chunks.size(); i++)
+    {
+      if (parallel->chunks[i].state == LAS_READ_POINT_CHUNK_QUEUED) parallel->chunks[i].state = LAS_READ_POINT_CHUNK_FREE;
+    }
+    parallel->decoded.wait(lock, [this]{
+      for (size_t c = 0; c < parallel->chunks.size(); c++)
+      {
+        if (parallel->chunks[c].state == LAS_READ_POINT_CHUNK_DECODING) return false;
+      }
+      return true;
+    });
+    for (i = 0; i < parallel->chunks.size(); i++)
+    {
+      parallel->chunks[i].state = LAS_READ_POINT_CHUNK_FREE;
+    }
+  }
+  parallel->next_chunk = target_chunk;
+  parallel->head = 0;
+  parallel->tail = 0;
+  parallel->index = (U32)delta;
+  parallel->filled = 0;
+  parallel->ahead = 1;
+  current_chunk = target_chunk;
+  return TRUE;
+}
+
 BOOL LASreadPoint::init_dec()
 {
   // maybe read chunk table (only if chunking enabled)
@@ -628,9 +1156,47 @@ BOOL LASreadPoint::init_dec()
   point_start = instream->tell();
   readers = 0;
 
+  // the cache only holds points of the chunk that is being decoded
+  seek_cached = 0;
+  seek_replay = 0;
+
   return TRUE;
 }
 
+void LASreadPoint::set_seek_cache(const U32 max_bytes)
+{
+  seek_cache_max_bytes = max_bytes;
+  if (max_bytes == 0)
+  {
+    seek_caching = FALSE;
+    seek_cached = 0;
+    seek_replay = 0;
+  }
+}
+
+void LASreadPoint::cache_point(U8* const * point)
+{
+  if (seek_cached == seek_cache_alloced)
+  {
+    // grow the cache until it reaches its maximum size
+    U32 max_points = seek_cache_max_bytes / chunk_point_stride;
+    if (seek_cached >= max_points) return;
+    U32 alloced = (seek_cache_alloced ? 2 * seek_cache_alloced : 1024);
+    if (alloced > max_points) alloced = max_points;
+    U8* cache = (U8*)realloc_las(seek_cache, (size_t)alloced * chunk_point_stride);
+    if (cache == 0) return;
+    seek_cache = cache;
+    seek_cache_alloced = alloced;
+  }
+  U8* item = seek_cache + (size_t)seek_cached * chunk_point_stride;
+  U32 i;
+  for (i = 0; i < num_readers; i++)
+  {
+    memcpy(item + chunk_item_offsets[i], point[i], chunk_item_offsets[i+1] - chunk_item_offsets[i]);
+  }
+  seek_cached++;
+}
+
 BOOL LASreadPoint::read_chunk_table()
 {
   // read the 8 bytes that store the location of the chunk table
@@ -848,6 +1414,10 @@ U32 LASreadPoint::search_chunk_table(const U64 index, const U32 lower, const U32
 
 LASreadPoint::~LASreadPoint()
 {
+  if (parallel) delete parallel;
+  if (chunk_item_offsets) delete [] chunk_item_offsets;
+  if (laszip) delete laszip;
+
   U32 i;
 
   if (readers_raw)
@@ -881,6 +1451,7 @@ LASreadPoint::~LASreadPoint()
     delete [] seek_point[0];
     delete [] seek_point;
   }
+  if (seek_cache) free(seek_cache);
 
   if (last_error) delete [] last_error;
   if (last_warning) delete [] last_warning;
@@ -24,6 +24,11 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- seeks within the current chunk replay its decoded points from a cache
+    19 October 2026 -- chunk-level access for tools that copy or convert complete chunks
+    19 October 2026 -- decodes the chunks of a LAZ file with several threads in parallel
+    19 October 2026 -- standard point formats read their items without virtual calls
+    19 October 2026 -- tells the decoder where the chunk ends to read it in blocks
     23 September 2020 -- rare fix for bit-corrupted LAZ files where chunk table is zeroed
     28 August 2017 -- moving 'context' from global development hack to interface  
     18 July 2017 -- bug fix for spatial-indexed reading of native compressed LAS 1.4 
@@ -49,9 +54,10 @@
 #include "laszip.hpp"
 #include "laszip_decompress_selective_v3.hpp"
 #include "bytestreamin.hpp"
+#include "lasreaditem.hpp"
 
-class LASreadItem;
 class ArithmeticDecoder;
+class LASreadPointParallel;
 
 class LASLIB_DLL LASreadPoint
 {
@@ -68,6 +74,28 @@ public:
   BOOL check_end();
   BOOL done();
 
+  // decode chunks in parallel (needs chunked compression with a chunk table)
+  BOOL set_threads(const U32 threads, const U64 number_of_points);
+  inline U32 get_threads() const { return threads; };
+
+  // after the first seek() keep up to this many bytes of decoded points of the
+  // current chunk so that later seeks back into it replay them instead of
+  // decoding the chunk again. off (0) by default.
+  void set_seek_cache(const U32 max_bytes);
+
+  // chunk-level access for tools that copy or convert complete chunks. init_chunks()
+  // reads the chunk table and fails unless it is complete and the stream seekable
+  BOOL init_chunks(const U64 number_of_points);
+  inline U32 get_number_chunks() const { return number_chunks; };
+  inline I64 get_chunk_start(const U32 chunk) const { return chunk_starts[chunk]; };
+  inline U32 get_chunk_size() const { return (chunk_totals ? U32_MAX : chunk_size); };
+  U32 get_chunk_number_of_points(const U32 chunk) const;
+
+  // decode a complete chunk from memory into 'number' points of 'chunk_point_stride' bytes
+  BOOL read_chunk(const U8* bytes, const U32 num_bytes, const U32 number, U8* points);
+  inline U32 get_chunk_point_stride() const { return chunk_point_stride; };
+  inline const U32* get_chunk_item_offsets() const { return chunk_item_offsets; };
+
   inline const CHAR* error() const { return last_error; };
   inline const CHAR* warning() const { return last_warning; };
 
@@ -77,6 +105,7 @@ private:
   LASreadItem** readers;
   LASreadItem** readers_raw;
   LASreadItem** readers_compressed;
+  LASreadItemsFunction read_compressed;
   ArithmeticDecoder* dec;
   BOOL layered_las14_compression;
   // used for chunking
@@ -96,6 +125,27 @@ private:
   I64 point_start;
   U32 point_size;
   U8** seek_point;
+  U32 seek_cache_max_bytes;
+  BOOL seek_caching;
+  U8* seek_cache;
+  U32 seek_cache_alloced;
+  U32 seek_cached;
+  U32 seek_replay;
+  void cache_point(U8* const * point);
+  // used for decoding chunks in parallel
+  U32 threads;
+  U64 number_of_points;
+  U32 num_items;
+  const LASitem* items;
+  LASzip* laszip;
+  U32* chunk_item_offsets;
+  U32 chunk_point_stride;
+  LASreadPointParallel* parallel;
+  BOOL start_parallel();
+  void fill_parallel();
+  BOOL read_parallel(U8* const * point);
+  BOOL seek_parallel(const U64 target);
+  BOOL complete_chunk_table() const;
   // used for error and warning reporting
   CHAR* last_error;
   CHAR* last_warning;
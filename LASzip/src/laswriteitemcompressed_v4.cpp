@@ -30,6 +30,7 @@
 */
 
 #include "laswriteitemcompressed_v4.hpp"
+#include "laszip.hpp"
 
 #include <cassert>
 #include <string.h>
@@ -86,13 +87,18 @@ typedef struct LASpoint14
 
 #define LASZIP_GPSTIME_MULTI_TOTAL (LASZIP_GPSTIME_MULTI - LASZIP_GPSTIME_MULTI_MINUS + 5) 
 
-LASwriteItemCompressed_POINT14_v4::LASwriteItemCompressed_POINT14_v4(ArithmeticEncoder* enc)
+LASwriteItemCompressed_POINT14_v4::LASwriteItemCompressed_POINT14_v4(ArithmeticEncoder* enc, const U16 version)
 {
   /* not used as a encoder. just gives access to outstream */
 
   assert(enc);
   this->enc = enc;
 
+  /* the item version selects the modeling level */
+
+  assert((version == 4) || (version == LASZIP_POINT14_VERSION_FAST) || (version == LASZIP_POINT14_VERSION_MAX));
+  this->version = version;
+
   /* zero outstreams and encoders */
 
   outstream_channel_returns_XY = 0;
@@ -244,12 +250,17 @@ inline BOOL LASwriteItemCompressed_POINT14_v4::createAndInitModelsAndCompressors
     }
     contexts[context].m_return_number_gps_same = enc_channel_returns_XY->createSymbolModel(13);
 
-    contexts[context].ic_dX = new IntegerCompressor(enc_channel_returns_XY, 32, 2);  // 32 bits, 2 context
-    contexts[context].ic_dY = new IntegerCompressor(enc_channel_returns_XY, 32, 22); // 32 bits, 22 contexts
+    /* the fast level codes small correctors with a single symbol and the max level models more of their bits */
+
+    U32 bits_high = (version == LASZIP_POINT14_VERSION_MAX ? LASZIP_POINT14_MAX_BITS_HIGH : 8);
+    U32 bits_direct = (version == LASZIP_POINT14_VERSION_FAST ? LASZIP_POINT14_FAST_BITS_DIRECT : 0);
+
+    contexts[context].ic_dX = new IntegerCompressor(enc_channel_returns_XY, 32, 2, bits_high, 0, bits_direct);  // 32 bits, 2 context
+    contexts[context].ic_dY = new IntegerCompressor(enc_channel_returns_XY, 32, 22, bits_high, 0, bits_direct); // 32 bits, 22 contexts
 
     /* for the Z layer */
 
-    contexts[context].ic_Z = new IntegerCompressor(enc_Z, 32, 20);  // 32 bits, 20 contexts
+    contexts[context].ic_Z = new IntegerCompressor(enc_Z, 32, 20, bits_high, 0, bits_direct);  // 32 bits, 20 contexts
 
     /* for the classification layer */
     /* for the flags layer */
@@ -264,7 +275,7 @@ inline BOOL LASwriteItemCompressed_POINT14_v4::createAndInitModelsAndCompressors
 
     /* for the intensity layer */
 
-    contexts[context].ic_intensity = new IntegerCompressor(enc_intensity, 16, 4);
+    contexts[context].ic_intensity = new IntegerCompressor(enc_intensity, 16, 4, 8, 0, bits_direct);
 
     /* for the scan_angle layer */
 
@@ -278,7 +289,7 @@ inline BOOL LASwriteItemCompressed_POINT14_v4::createAndInitModelsAndCompressors
 
     contexts[context].m_gpstime_multi = enc_gps_time->createSymbolModel(LASZIP_GPSTIME_MULTI_TOTAL);
     contexts[context].m_gpstime_0diff = enc_gps_time->createSymbolModel(5);
-    contexts[context].ic_gpstime = new IntegerCompressor(enc_gps_time, 32, 9); // 32 bits, 9 contexts
+    contexts[context].ic_gpstime = new IntegerCompressor(enc_gps_time, 32, 9, bits_high, 0, bits_direct); // 32 bits, 9 contexts
   }
 
   /* then init entropy models and integer compressors */
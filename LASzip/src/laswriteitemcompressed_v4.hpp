@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- POINT14 item version selects the fast or the max modeling level
     28 December 2017 -- fix incorrect 'context switch' reported by Wanwannodao 
     28 August 2017 -- moving 'context' from global development hack to interface  
     22 August 2016 -- finalizing at Basecamp in Bonn during FOSS4g hackfest
@@ -45,7 +46,7 @@ class LASLIB_DLL LASwriteItemCompressed_POINT14_v4 : public LASwriteItemCompress
 {
 public:
 
-  LASwriteItemCompressed_POINT14_v4(ArithmeticEncoder* enc);
+  LASwriteItemCompressed_POINT14_v4(ArithmeticEncoder* enc, const U16 version=4);
 
   BOOL init(const U8* item, U32& context);
   BOOL write(const U8* item, U32& context);
@@ -60,6 +61,10 @@ private:
 
   ArithmeticEncoder* enc;
 
+  /* 4 or one of the modeling levels LASZIP_POINT14_VERSION_FAST and LASZIP_POINT14_VERSION_MAX */
+
+  U16 version;
+
   ByteStreamOutArray* outstream_channel_returns_XY;
   ByteStreamOutArray* outstream_Z;
   ByteStreamOutArray* outstream_classification;
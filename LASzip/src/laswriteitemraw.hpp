@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- POINT14 packing usable without a stream for buffered writing
     29 September 2018 -- fix: extended_classification when classification not set 
     28 August 2017 -- moving 'context' from global development hack to interface  
     10 January 2011 -- licensing change for LGPL release and liblas integration
@@ -217,6 +218,12 @@ class LASwriteItemRaw_POINT14_LE : public LASwriteItemRaw
 public:
   LASwriteItemRaw_POINT14_LE(){};
   inline BOOL write(const U8* item, U32& context)
+  {
+    pack(item, buffer);
+    return outstream->putBytes(buffer, 30);
+  }
+  // converts the point item into the 30 bytes of a LAS 1.4 point record
+  static inline void pack(const U8* item, U8* buffer)
   {
     ((LAStempWritePoint14*)buffer)->X = ((const LAStempWritePoint10*)item)->X;
     ((LAStempWritePoint14*)buffer)->Y = ((const LAStempWritePoint10*)item)->Y;
@@ -247,7 +254,6 @@ public:
     }
 
     *((F64*)&buffer[22]) = ((const LAStempWritePoint10*)item)->gps_time;
-    return outstream->putBytes(buffer, 30);
   }
 private:
   U8 buffer[30] = {0};
@@ -32,6 +32,7 @@
 #include "laswritepoint.hpp"
 
 #include "arithmeticencoder.hpp"
+#include "bytestreamout_checksum.hpp"
 #include "laswriteitemraw.hpp"
 #include "laswriteitemcompressed_v1.hpp"
 #include "laswriteitemcompressed_v2.hpp"
@@ -59,7 +60,11 @@ LASwritePoint::LASwritePoint()
   chunk_sizes = 0;
   chunk_bytes = 0;
   chunk_table_start_position = 0;
+  chunk_table_start_in_trailer = FALSE;
+  chunk_table_start = -1;
   chunk_start_position = 0;
+  checksum_stream = 0;
+  chunk_checksums = 0;
 }
 
 BOOL LASwritePoint::setup(const U32 num_items, const LASitem* items, const LASzip* laszip)
@@ -197,8 +202,8 @@ BOOL LASwritePoint::setup(const U32 num_items, const LASitem* items, const LASzi
       case LASitem::POINT14:
         if (items[i].version == 3)
           writers_compressed[i] = new LASwriteItemCompressed_POINT14_v3(enc);
-        else if (items[i].version == 4)
-          writers_compressed[i] = new LASwriteItemCompressed_POINT14_v4(enc);
+        else if ((items[i].version == 4) || (items[i].version == LASZIP_POINT14_VERSION_FAST) || (items[i].version == LASZIP_POINT14_VERSION_MAX))
+          writers_compressed[i] = new LASwriteItemCompressed_POINT14_v4(enc, items[i].version);
         else
           return FALSE;
         break;
@@ -429,6 +434,105 @@ BOOL LASwritePoint::done()
   return TRUE;
 }
 
+BOOL LASwritePoint::init_chunk(ByteStreamOut* outstream)
+{
+  if ((enc == 0) || (outstream == 0)) return FALSE;
+  this->outstream = outstream;
+
+  U32 i;
+  for (i = 0; i < num_writers; i++)
+  {
+    ((LASwriteItemRaw*)(writers_raw[i]))->init(outstream);
+  }
+  writers = 0;
+  chunk_count = 0;
+  return TRUE;
+}
+
+BOOL LASwritePoint::done_chunk()
+{
+  if (writers == writers_compressed)
+  {
+    if (layered_las14_compression)
+    {
+      U32 i;
+      // write how many points are in the chunk
+      outstream->put32bitsLE((U8*)&chunk_count);
+      // write all layers 
+      for (i = 0; i < num_writers; i++)
+      {
+        ((LASwriteItemCompressed*)writers[i])->chunk_sizes();
+      }
+      for (i = 0; i < num_writers; i++)
+      {
+        ((LASwriteItemCompressed*)writers[i])->chunk_bytes();
+      }
+    }
+    else
+    {
+      enc->done();
+    }
+  }
+  writers = 0;
+  chunk_count = 0;
+  return TRUE;
+}
+
+BOOL LASwritePoint::write_chunk(const U8* bytes, const U32 num_bytes, const U32 number)
+{
+  if ((enc == 0) || (chunk_start_position == 0) || (bytes == 0) || (num_bytes == 0) || (number == 0))
+  {
+    return FALSE;
+  }
+  if ((chunk_size != U32_MAX) && (number > chunk_size))
+  {
+    return FALSE;
+  }
+  // first complete the chunk of points that were written before
+  if (writers)
+  {
+    // but fixed-sized chunks must be full
+    if ((chunk_size != U32_MAX) && (chunk_count != chunk_size))
+    {
+      return FALSE;
+    }
+    U32 count = chunk_count;
+    done_chunk();
+    chunk_count = count;
+    add_chunk_to_table();
+  }
+  if (!outstream->putBytes(bytes, num_bytes))
+  {
+    return FALSE;
+  }
+  chunk_count = number;
+  add_chunk_to_table();
+  chunk_count = 0;
+  return TRUE;
+}
+
+BOOL LASwritePoint::set_chunk_checksums()
+{
+  // only for chunked compression after init() and before the first point
+  if ((enc == 0) || (chunk_start_position == 0) || writers || number_chunks)
+  {
+    return FALSE;
+  }
+  if (checksum_stream == 0)
+  {
+    // from now on all bytes pass through the checksum stream
+    checksum_stream = new ByteStreamOutChecksum();
+    checksum_stream->init(outstream);
+    outstream = checksum_stream;
+    U32 i;
+    for (i = 0; i < num_writers; i++)
+    {
+      ((LASwriteItemRaw*)(writers_raw[i]))->init(outstream);
+    }
+  }
+  return TRUE;
+}
+
 BOOL LASwritePoint::add_chunk_to_table()
 {
   if (number_chunks == alloced_chunks)
@@ -438,15 +542,23 @@ BOOL LASwritePoint::add_chunk_to_table()
       alloced_chunks = 1024;
       if (chunk_size == U32_MAX) chunk_sizes = (U32*)malloc_las(sizeof(U32) * alloced_chunks); 
       chunk_bytes = (U32*)malloc_las(sizeof(U32) * alloced_chunks); 
+      if (checksum_stream) chunk_checksums = (U32*)malloc_las(sizeof(U32) * alloced_chunks);
     }
     else
     {
       alloced_chunks *= 2;
       if (chunk_size == U32_MAX) chunk_sizes = (U32*)realloc_las(chunk_sizes, sizeof(U32)*alloced_chunks); 
       chunk_bytes = (U32*)realloc_las(chunk_bytes, sizeof(U32)*alloced_chunks); 
+      if (checksum_stream) chunk_checksums = (U32*)realloc_las(chunk_checksums, sizeof(U32)*alloced_chunks);
     }
     if (chunk_size == U32_MAX && chunk_sizes == 0) return FALSE;
     if (chunk_bytes == 0) return FALSE;
+    if (checksum_stream && chunk_checksums == 0) return FALSE;
+  }
+  if (checksum_stream)
+  {
+    chunk_checksums[number_chunks] = checksum_stream->getChecksum();
+    checksum_stream->resetChecksum();
   }
   I64 position = outstream->tell();
   if (chunk_size == U32_MAX) chunk_sizes[number_chunks] = chunk_count;
@@ -460,6 +572,7 @@ BOOL LASwritePoint::write_chunk_table()
 {
   U32 i;
   I64 position = outstream->tell();
+  chunk_table_start = position;
   if (chunk_table_start_position != -1) // stream is seekable
   {
     if (!outstream->seek(chunk_table_start_position))
@@ -496,7 +609,7 @@ BOOL LASwritePoint::write_chunk_table()
     }
     enc->done();
   }
-  if (chunk_table_start_position == -1) // stream is not-seekable
+  if ((chunk_table_start_position == -1) && !chunk_table_start_in_trailer) // stream is not-seekable
   {
     if (!outstream->put64bitsLE((U8*)&position))
     {
@@ -532,4 +645,6 @@ LASwritePoint::~LASwritePoint()
   }
 
   if (chunk_bytes) free(chunk_bytes);
+  if (chunk_checksums) free(chunk_checksums);
+  if (checksum_stream) delete checksum_stream;
 }
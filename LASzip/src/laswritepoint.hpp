@@ -24,6 +24,9 @@
 
   CHANGE HISTORY:
 
+    19 October 2026 -- optional CRC-32 checksums of the compressed chunks
+    19 October 2026 -- chunk-level access to encode or append complete chunks
+    19 October 2026 -- chunk table start of non-seekable streams can go into a trailer
     21 February 2019 -- fix for writing 4294967295+ points uncompressed to LAS
     28 August 2017 -- moving 'context' from global development hack to interface  
     23 August 2016 -- layering of items for selective decompression in LAS 1.4 
@@ -48,6 +51,7 @@
 
 class LASwriteItem;
 class ArithmeticEncoder;
+class ByteStreamOutChecksum;
 
 class LASLIB_DLL LASwritePoint
 {
@@ -63,6 +67,26 @@ public:
   BOOL chunk();
   BOOL done();
 
+  // for non-seekable streams the start of the chunk table is usually written
+  // right after the chunk table. the caller can write it into a trailer instead
+  void set_chunk_table_start_in_trailer(BOOL in_trailer) { chunk_table_start_in_trailer = in_trailer; };
+  I64 get_chunk_table_start() const { return chunk_table_start; };
+
+  // chunk-level access for tools that compress complete chunks elsewhere (e.g. in
+  // other threads) or copy them. the points written between init_chunk() and
+  // done_chunk() become one chunk in 'outstream' (no more than 'chunk_size' for
+  // fixed-sized chunks). write_chunk() appends such a chunk of 'number' points.
+  BOOL init_chunk(ByteStreamOut* outstream);
+  BOOL done_chunk();
+  BOOL write_chunk(const U8* bytes, const U32 num_bytes, const U32 number);
+
+  // computes the CRC-32 of the compressed bytes of every chunk while they are
+  // written. must be enabled after init() and before the first point. storing
+  // them is up to the caller once done() was called.
+  BOOL set_chunk_checksums();
+  inline U32 get_number_chunks() const { return (number_chunks == U32_MAX ? 0 : number_chunks); };
+  inline const U32* get_chunk_checksums() const { return chunk_checksums; };
+
 private:
   ByteStreamOut* outstream;
   U32 num_writers;
@@ -80,6 +104,10 @@ private:
   U32* chunk_bytes;
   I64 chunk_start_position;
   I64 chunk_table_start_position;
+  BOOL chunk_table_start_in_trailer;
+  I64 chunk_table_start;
+  ByteStreamOutChecksum* checksum_stream;
+  U32* chunk_checksums;
   BOOL add_chunk_to_table();
   BOOL write_chunk_table();
 };
@@ -288,7 +288,7 @@ bool LASzip::check_item(const LASitem* item)
     break;
   case LASitem::POINT14:
     if (item->size != 30) return return_error("POINT14 has size != 30");
-    if ((item->version != 0) && (item->version != 2) && (item->version != 3) && (item->version != 4)) return return_error("POINT14 has version != 0 and != 2 and != 3 and != 4"); // version == 2 from lasproto, version == 4 fixes context-switch
+    if ((item->version != 0) && (item->version != 2) && (item->version != 3) && (item->version != 4) && (item->version != LASZIP_POINT14_VERSION_FAST) && (item->version != LASZIP_POINT14_VERSION_MAX)) return return_error("POINT14 has version != 0 and != 2 and != 3 and != 4 and != 5 and != 6"); // version == 2 from lasproto, version == 4 fixes context-switch, versions 5 and 6 are the fast and max levels of version 4
     break;
   case LASitem::RGB14:
     if (item->size != 6) return return_error("RGB14 has size != 6");
@@ -744,10 +744,13 @@ unsigned short LASzip::get_default_version(const unsigned char point_type, const
 // 2: default version for point types 0-5
 // 3: default version for point types 6-10
 // 4: new, slightly fixed version for point types 6-10 (not default yet, until software versions are widely updated)
-// >=5: invalid
+// 5: version 4 with the fast modeling level for the POINT14 item (LASZIP_POINT14_VERSION_FAST)
+// 6: version 4 with the max modeling level for the POINT14 item (LASZIP_POINT14_VERSION_MAX)
+// >=7: invalid
 
 // specifying value 3 or 4 for point types 0-5 will use version 2
 // specifying value 1 or 2 for point types 6-10 will use version 3
+// specifying value 5 or 6 uses version 4 for all items other than POINT14
 // WAVEPACKET13 always uses version 1 
 
 bool LASzip::request_version(const U16 requested_version)
@@ -760,7 +763,7 @@ bool LASzip::request_version(const U16 requested_version)
   else
   {
     if (requested_version < 1) return return_error("with compression version is at least 1");
-    if (requested_version > 4) return return_error("version larger than 4 not supported");
+    if (requested_version > LASZIP_POINT14_VERSION_MAX) return return_error("version larger than 6 not supported");
   }
   U16 i;
   for (i = 0; i < num_items; i++)
@@ -777,11 +780,13 @@ bool LASzip::request_version(const U16 requested_version)
       items[i].version = 1; // no version 2, 3 or 4
       break;
     case LASitem::POINT14:
+      items[i].version = (std::max)((U16)3, requested_version);  // no version 1 or 2
+      break;
     case LASitem::RGB14:
     case LASitem::RGBNIR14:
     case LASitem::WAVEPACKET14:
     case LASitem::BYTE14:
-      items[i].version = (std::max)((U16)3, requested_version);  // no version 1 or 2
+      items[i].version = (std::min)((U16)4, (std::max)((U16)3, requested_version));  // no version 1, 2, 5 or 6
       break;
     default:
       return return_error("item type not supported");
@@ -24,6 +24,7 @@
     implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
   CHANGE HISTORY:
+    19 October 2026 -- POINT14 item versions 5 and 6 for fast and max modeling levels
     17 October 2025 -- upped to 3.5, general support for LAS 1.5
     20 October 2023 -- Fix int overflow of number_of_point_records when using laszip_update_inventory
     20 March 2019 -- upped to 3.3 r1 for consistent legacy and extended class check
@@ -96,6 +97,14 @@ typedef long long SIGNED_INT64;
 
 #define LASZIP_CHUNK_SIZE_DEFAULT           50000
 
+// item versions of POINT14 that select an alternative modeling of the v4
+// layers. they can only be decoded by LASzip readers that know them
+#define LASZIP_POINT14_VERSION_FAST         5  // small correctors coded with a single symbol
+#define LASZIP_POINT14_VERSION_MAX          6  // more corrector bits coded with a model
+
+#define LASZIP_POINT14_FAST_BITS_DIRECT     8
+#define LASZIP_POINT14_MAX_BITS_HIGH        11
+
 #include "mydefs.hpp"
 
 class LASLIB_DLL LASitem
@@ -613,6 +613,40 @@ void* malloc_las(size_t size) {
   return ptr;
 }
 
+/// tables for computing the CRC-32 eight bytes at a time ("slicing-by-8")
+struct CRC32tables {
+  U32 table[8][256];
+  CRC32tables() {
+    for (U32 i = 0; i < 256; i++) {
+      U32 crc = i;
+      for (U32 j = 0; j < 8; j++) crc = (crc & 1) ? ((crc >> 1) ^ 0xEDB88320) : (crc >> 1);
+      table[0][i] = crc;
+    }
+    for (U32 i = 0; i < 256; i++) {
+      for (U32 k = 1; k < 8; k++) table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+    }
+  }
+};
+
+/// CRC-32 of a block of bytes that can be continued with the next block
+U32 crc32_las(U32 crc, const U8* bytes, size_t num_bytes) {
+  static const CRC32tables tables;
+  const U32(*t)[256] = tables.table;
+  crc = ~crc;
+  while (num_bytes >= 8) {
+    U32 lo = crc ^ ((U32)bytes[0] | ((U32)bytes[1] << 8) | ((U32)bytes[2] << 16) | ((U32)bytes[3] << 24));
+    U32 hi = ((U32)bytes[4] | ((U32)bytes[5] << 8) | ((U32)bytes[6] << 16) | ((U32)bytes[7] << 24));
+    crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+          t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+    bytes += 8;
+    num_bytes -= 8;
+  }
+  while (num_bytes--) {
+    crc = (crc >> 8) ^ t[0][(crc ^ *bytes++) & 0xFF];
+  }
+  return ~crc;
+}
+
 /// Wrapper for `vsscanf`
 int sscanf_las(const char* buffer, const char* format, ...) {
   va_list args;
@@ -24,6 +24,7 @@
 
   CHANGE HISTORY:
 
+    19 October 2026 -- CRC-32 for the checksums of LAZ chunks
     28 October 2015 -- adding DLL bindings via 'COMPILE_AS_DLL' and 'USE_AS_DLL'
     10 January 2011 -- licensing change for LGPL release and libLAS integration
     13 July 2005 -- created after returning with many mosquito bites from OBX
@@ -558,6 +559,8 @@ bool StringInVector(const std::string& value, const std::vector<std::string>& ar
 
 LASLIB_DLL void* realloc_las(void* ptr, size_t size);
 LASLIB_DLL void* malloc_las(size_t size);
+/// CRC-32 (as used by zip and zlib) of 'num_bytes' continued from 'crc' (0 for the first bytes)
+LASLIB_DLL U32 crc32_las(U32 crc, const U8* bytes, size_t num_bytes);
 void bytes_to_readable(size_t bytes, double* value_out, const char** unit_out);
 
 size_t get_available_RAM();
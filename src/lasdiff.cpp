@@ -26,6 +26,7 @@
 
   CHANGE HISTORY:
 
+    19 October 2026 -- fixed '-random_seeks' seeking to negative point indices
     4 November 2019 -- new option '-idir' takes two input directories and compares
     7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
     13 July 2017 -- added missing checks for LAS 1.4 EVLR size and payloads
@@ -467,7 +468,7 @@ static int check_points(const CHAR* file_name1, LASreader* lasreader1, const CHA
     {
       if (lasreader1->p_idx%100000 == 25000)
       {
-        I64 s = (rand()*rand())%lasreader1->npoints;
+        I64 s = ((I64)rand()*(I64)rand())%lasreader1->npoints;
         fprintf(stderr, "at p_idx %u seeking to %u\n", (U32)lasreader1->p_idx, (U32)s);
         lasreader1->seek(s);
         lasreader2->seek(s);
@@ -26,6 +26,7 @@
 
   CHANGE HISTORY:
 
+    19 October 2026 -- new option '-copy_chunks' to merge LAZ files without decompressing
     20 August 2014 -- new option '-keep_lastiling' to preserve the LAStiling VLR
     20 August 2014 -- copy VLRs from empty (zero points) LAS/LAZ files to others
      5 August 2011 -- possible to add/change projection info in command line
@@ -44,6 +45,7 @@
 
 #include "lasreader.hpp"
 #include "laswriter.hpp"
+#include "laschunkcopier.hpp"
 #include "geoprojectionconverter.hpp"
 #include "lastool.hpp"
 
@@ -60,6 +62,7 @@ public:
     fprintf(stderr, "lasmerge -i file1.las file2.las file3.las -o out.las\n");
     fprintf(stderr, "lasmerge -i file1.las file2.las -reoffset 600000 4000000 0 -olas > out.las\n");
     fprintf(stderr, "lasmerge -lof lasfiles.txt -rescale 0.01 0.01 0.01 -verbose -o out.las\n");
+    fprintf(stderr, "lasmerge -i *.laz -copy_chunks -o delivery.laz\n");
     fprintf(stderr, "lasmerge -h\n");
   };
 };
@@ -83,6 +86,7 @@ int main(int argc, char *argv[])
   lastool.init(argc, argv, "lasmerge");
   int i;
   bool keep_lastiling = false;
+  bool copy_chunks = false;
   U32 chopchop = 0;
   bool projection_was_set = false;
   double start_time = 0;
@@ -144,6 +148,10 @@ int main(int argc, char *argv[])
     {
       keep_lastiling = true;
     }
+    else if (strcmp(argv[i],"-copy_chunks") == 0)
+    {
+      copy_chunks = true;
+    }
     else if ((argv[i][0] != '-') && (lasreadopener.get_file_name_number() == 0))
     {
       lasreadopener.add_file_name(argv[i]);
@@ -254,6 +262,11 @@ int main(int argc, char *argv[])
     lasreader->header.del_geo_ascii_params();
   }
 
+  if (chopchop && copy_chunks)
+  {
+    LASMessage(LAS_WARNING, "cannot copy chunks when splitting. ignoring '-copy_chunks' ...");
+  }
+
   if (chopchop)
   {
     I32 file_number = 0;
@@ -305,23 +318,48 @@ int main(int argc, char *argv[])
         laserror("cannot merge %lld points into single LAS 1.%d file. maximum is %u", lasreader->npoints, lasreader->header.version_minor, U32_MAX);
       }
     }
-    // open the writer
-    LASwriter* laswriter = laswriteopener.open(&lasreader->header);
-    if (laswriter == 0)
+    // maybe the compressed chunks can be copied because no point changes
+    bool copied = false;
+    if (copy_chunks)
     {
-      laserror("could not open laswriter");
+      if (lasreadopener.get_filter() || lasreadopener.get_transform() || lasreadopener.is_inside() || lasreadopener.are_files_flightlines() || lasreadopener.applying_file_source_ID())
+      {
+        LASMessage(LAS_WARNING, "cannot copy chunks when points are filtered or transformed. merging points instead ...");
+      }
+      else
+      {
+        LASchunkcopier laschunkcopier;
+        copied = laschunkcopier.copy(&lasreadopener, &lasreader->header, &laswriteopener);
+        if (copied)
+        {
+          LASMessage(LAS_VERBOSE, "copying chunks with %lld points of %u files took %g sec.", laschunkcopier.get_npoints(), laschunkcopier.get_number_files(), taketime()-start_time);
+        }
+        else
+        {
+          LASMessage(LAS_WARNING, "cannot copy chunks of these files. merging points instead ...");
+        }
+      }
     }
-    // loop over the points
-    while (lasreader->read_point())
+    if (!copied)
     {
-      laswriter->write_point(&lasreader->point);
-      laswriter->update_inventory(&lasreader->point);
+      // open the writer
+      LASwriter* laswriter = laswriteopener.open(&lasreader->header);
+      if (laswriter == 0)
+      {
+        laserror("could not open laswriter");
+      }
+      // loop over the points
+      while (lasreader->read_point())
+      {
+        laswriter->write_point(&lasreader->point);
+        laswriter->update_inventory(&lasreader->point);
+      }
+      // close the writer
+      laswriter->update_header(&lasreader->header, TRUE);
+      laswriter->close();
+      LASMessage(LAS_VERBOSE, "merging files took %g sec.", taketime()-start_time); 
+      delete laswriter;
     }
-    // close the writer
-    laswriter->update_header(&lasreader->header, TRUE);
-    laswriter->close();
-    LASMessage(LAS_VERBOSE, "merging files took %g sec.", taketime()-start_time); 
-    delete laswriter;
   }
   lasreader->close();
   delete lasreader;
@@ -25,6 +25,8 @@
 
   CHANGE HISTORY:
 
+    19 October 2026 -- '-verify' checks the chunks of LAZ files against their checksums
+    19 October 2026 -- '-transcode' converts LAZ chunk by chunk into point types 6 to 10
     21 Juni 2019 -- allows compressing Trimble waveforms where first WDP offset is 0
     7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
     29 March 2015 -- using LASwriterCompatible for LAS 1.4 compatibility mode
@@ -58,6 +60,8 @@
 #include "geoprojectionconverter.hpp"
 #include "lasindex.hpp"
 #include "lasquadtree.hpp"
+#include "lastranscoder.hpp"
+#include "lasverifier.hpp"
 #include "lastool.hpp"
 
 class OffsetSize
@@ -82,6 +86,11 @@ public:
     fprintf(stderr, "laszip -i lidar.las -nil\n");
     fprintf(stderr, "laszip -i lidar.laz -size\n");
     fprintf(stderr, "laszip -i lidar.laz -check\n");
+    fprintf(stderr, "laszip -i lidar.las -chunk_checksums -o lidar.laz\n");
+    fprintf(stderr, "laszip -i *.laz -verify -verify_threads 8\n");
+    fprintf(stderr, "laszip -i *.laz -verify_decode\n");
+    fprintf(stderr, "laszip -i old.laz -transcode -o native.laz\n");
+    fprintf(stderr, "laszip -i *.laz -transcode -transcode_threads 8 -odix _native\n");
     fprintf(stderr, "laszip -i *.las\n");
     fprintf(stderr, "laszip -i *.laz\n");
     fprintf(stderr, "laszip -i *.las -odir compressed\n");
@@ -93,6 +102,8 @@ public:
     fprintf(stderr, "laszip -i lidar.las -o lidar_zipped.laz\n");
     fprintf(stderr, "laszip -i lidar.laz -o lidar_unzipped.las\n");
     fprintf(stderr, "laszip -i lidar.las -stdout -olaz > lidar.laz\n");
+    fprintf(stderr, "laszip -i las14.las -laz_level max -o las14.laz\n");
+    fprintf(stderr, "laszip -i las14_max.laz -laz_level default -o las14.laz\n");
     fprintf(stderr, "laszip -stdin -o lidar.laz < lidar.las\n");
     fprintf(stderr, "laszip -i *.txt -iparse xyztiarn\n");
     fprintf(stderr, "laszip -i las14.las -compatible -o las14compatible.laz\n");
@@ -125,6 +136,11 @@ int main(int argc, char *argv[])
   bool waveform_with_map = false;
   bool report_file_size = false;
   bool check_integrity = false;
+  bool verify = false;
+  bool verify_decode = false;
+  U32 verify_threads = 1;
+  bool transcode = false;
+  U32 transcode_threads = 1;
   I32 end_of_points = -1;
   bool projection_was_set = false;
   bool format_not_specified = false;
@@ -259,6 +275,47 @@ int main(int argc, char *argv[])
     {
       check_integrity = true;
     }
+    else if (strcmp(argv[i],"-verify") == 0)
+    {
+      verify = true;
+    }
+    else if (strcmp(argv[i],"-verify_decode") == 0)
+    {
+      verify = true;
+      verify_decode = true;
+    }
+    else if (strcmp(argv[i],"-verify_threads") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        laserror("'%s' needs 1 argument: number", argv[i]);
+      }
+      i++;
+      verify_threads = atoi(argv[i]);
+      if (verify_threads == 0)
+      {
+        laserror("'%s' needs a number of threads of at least 1", argv[i-1]);
+      }
+      verify = true;
+    }
+    else if (strcmp(argv[i],"-transcode") == 0)
+    {
+      transcode = true;
+    }
+    else if (strcmp(argv[i],"-transcode_threads") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        laserror("'%s' needs 1 argument: number", argv[i]);
+      }
+      i++;
+      transcode_threads = atoi(argv[i]);
+      if (transcode_threads == 0)
+      {
+        laserror("'%s' needs a number of threads of at least 1", argv[i-1]);
+      }
+      transcode = true;
+    }
     else if (strcmp(argv[i],"-waveform") == 0 || strcmp(argv[i],"-waveforms") == 0)
     {
       waveform = true;
@@ -334,6 +391,20 @@ int main(int argc, char *argv[])
     }
   }
 
+  // transcoding copies the points of the chunks unchanged
+
+  if (transcode)
+  {
+    if (lasreadopener.get_filter() || lasreadopener.get_transform())
+    {
+      laserror("'-transcode' cannot filter or transform points");
+    }
+    if (laswriteopener.is_piped())
+    {
+      laserror("'-transcode' needs an output file and cannot write to a pipe");
+    }
+  }
+
   // make sure we do not corrupt the input file
 
   if (lasreadopener.get_file_name() && laswriteopener.get_file_name() && (strcmp(lasreadopener.get_file_name(), laswriteopener.get_file_name()) == 0))
@@ -414,6 +485,32 @@ int main(int argc, char *argv[])
       else
         LASMessage(LAS_INFO, "uncompressed file size is %.2f MB or %.2f GB for '%s'", (F64)uncompressed_file_size/1024.0/1024.0, (F64)uncompressed_file_size/1024.0/1024.0/1024.0, lasreadopener.get_file_name());
     }
+    else if (verify)
+    {
+      // check the chunks against their checksums or by decoding them
+      start_time = taketime();
+      if (lasreader->get_format() != LAS_TOOLS_FORMAT_LAZ)
+      {
+        LASMessage(LAS_WARNING, "'-verify' needs LAZ. skipping '%s' ...", lasreadopener.get_file_name());
+      }
+      else
+      {
+        LASverifier lasverifier;
+        if (!lasverifier.verify(lasreader, TRUE, verify_decode, verify_threads))
+        {
+          LASMessage(LAS_WARNING, "FAILED to verify '%s'", lasreadopener.get_file_name());
+        }
+        else if (lasverifier.get_number_failed())
+        {
+          LASMessage(LAS_WARNING, "FAILED verification for '%s' with %u of %u chunks corrupt. first is chunk %u", lasreadopener.get_file_name(), lasverifier.get_number_failed(), lasverifier.get_number_chunks(), lasverifier.get_first_failed());
+        }
+        else
+        {
+          LASMessage(LAS_INFO, "SUCCESS for '%s' with %u chunks %s", lasreadopener.get_file_name(), lasverifier.get_number_chunks(), (lasverifier.has_checksums() ? (lasverifier.was_decoded() ? "matching their checksums and decoding" : "matching their checksums") : "decoding (no checksums)"));
+        }
+        LASMessage(LAS_VERBOSE, "needed %g secs to verify '%s'", taketime()-start_time, lasreadopener.get_file_name());
+      }
+    }
     else if (dry || check_integrity)
     {
       // maybe only a dry read pass
@@ -435,6 +532,47 @@ int main(int argc, char *argv[])
         LASMessage(LAS_INFO, "needed %g secs to read '%s'", taketime()-start_time, lasreadopener.get_file_name());
       }
     }
+    else if (transcode)
+    {
+      // create output file name if no output was specified
+      if (!laswriteopener.active())
+      {
+        if (lasreadopener.get_file_name() == 0)
+        {
+          laserror("no output specified");
+        }
+        laswriteopener.set_force(TRUE);
+        if (laswriteopener.get_appendix() == 0)
+        {
+          laswriteopener.set_appendix("_native");
+        }
+        laswriteopener.set_format(LAS_TOOLS_FORMAT_LAZ);
+        laswriteopener.make_file_name(lasreadopener.get_file_name(), -2);
+      }
+
+      // make sure input and output filenames are not identical
+
+      if (lasreadopener.get_file_name() && laswriteopener.get_file_name() && (strcmp(lasreadopener.get_file_name(), laswriteopener.get_file_name()) == 0))
+      {
+        laserror("input and output file name are identical: '%s'", lasreadopener.get_file_name());
+      }
+
+      LAStranscoder lastranscoder;
+      if (lastranscoder.transcode(lasreader, &laswriteopener, transcode_threads))
+      {
+        LASMessage(LAS_VERBOSE, "%g secs to transcode %u chunks with %lld points of type %d into '%s'", taketime()-start_time, lastranscoder.get_number_chunks(), lastranscoder.get_npoints(), lasreader->header.point_data_format, laswriteopener.get_file_name());
+      }
+      else
+      {
+        LASMessage(LAS_WARNING, "FAILED to transcode '%s'", lasreadopener.get_file_name());
+      }
+
+      laswriteopener.set_file_name(0);
+      if (format_not_specified)
+      {
+        laswriteopener.set_format((const CHAR*)NULL);
+      }
+    }
     else
     {
       I64 start_of_waveform_data_packet_record = 0;